@@ -7,9 +7,36 @@
 #include <WebServer.h>
 #include <Update.h>
 #include <Preferences.h> // Added for hunger level persistence
-
-// Initialize display - SH1106 or SSD1306 OLED 128x64
-U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
+#include "src/ota_stream.h"
+#include "src/ota_decode.h"
+#include "src/ota_http.h"
+#include "src/pet_commands.h"
+#include "src/pet_ble.h"
+#include "src/ble_ota.h"
+#include "src/ble_bulk.h"
+#include "src/pedometer.h"
+#include "src/accel_lis3dh.h"
+#include "src/i2c_bus.h"
+#include "src/treat_ledger.h"
+#include "src/eye_state.h"
+#include "src/pet_needs.h"
+#include "src/night_mode.h"
+#include "src/power_manager.h"
+#include "src/log.h"
+#include "src/pet_behavior.h"
+#include "src/event_trace.h"
+#include "src/eye_engine.h"
+#include "src/eye_web.h"
+#include "src/eye_artwork.h"
+#include "src/eye_clips.h"
+#include <time.h>
+
+// The display: SSD1306 128x64 on I2C (EyeSh1106I2c for an SH1106). It has
+// to be an I2C panel, as the accelerometer shares its bus through the
+// scheduler, and 128x64 for the artwork and clips.
+typedef EyeSsd1306I2c Display;
+static_assert(Display::bus == EYE_I2C, "Hungry shares the display's I2C bus");
+Display::Panel u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
 
 const char* ssid = "kunal";
 const char* password = "kunal1234";
@@ -21,308 +48,523 @@ WebServer server(80);
 // Preferences object for non-volatile storage
 Preferences preferences;
 
-enum EyeState {
-  STATE_NEUTRAL,        // Normal, centered eyes
-  STATE_ANGRY,          // Angled eyes, looking aggressive
-  STATE_SURPRISED,      // Wide, round eyes
-  STATE_SAD,            // Droopy, downward eyes
-  STATE_SUSPICIOUS,     // Narrow, squinting eyes
-  STATE_LEFT,           // Looking left
-  STATE_RIGHT,          // Looking right
-  STATE_UP,             // Looking up
-  STATE_DOWN,           // Looking down
-  STATE_SLEEPY,         // Half-closed eyes
-  STATE_HAPPY,          // happy state
-  STATE_COUNT           // Used to count the number of states
-};
-
-const int screenWidth = 128;
-const int screenHeight = 64;
-const int eyeBaseWidth = 30;    // Base width of eye - increased size
-const int eyeBaseHeight = 44;   // Base height of eye - increased size
-const int eyeSpacing = 16;      // Space between eyes
-const int blinkDuration = 220;  // Duration of blink in ms
-const int transitionDuration = 150; // Duration of transition in ms
-
-// Animation timing
-unsigned long lastBlinkTime = 0;
-unsigned long lastStateChangeTime = 0;
-unsigned long transitionStartTime = 0;
 unsigned long lastNetworkCheckTime = 0;
 const int networkCheckInterval = 2000; // Check network every 2 seconds if disconnected
-bool readingLightOn = false;
-bool manualMode = false;
 
-unsigned long happyStateEndTime = 0;
-bool wasManualModeBeforeFeed = false;
+// Needs system - hunger, energy, happiness and cleanliness decay in closed
+// form (see src/pet_needs.h), so only refills are written to flash
+uint32_t needsBootClock = 0;   // needs clock saved before the last reset
+bool needsClockSynced = false;
+unsigned long lastNeedsClockSave = 0;
+const unsigned long NEEDS_CLOCK_SAVE_MS = 600000;
+const uint32_t EPOCH_VALID = 1600000000; // time() below this means no NTP yet
+
+// Night mode (src/night_mode.h)
+bool networkStarted = false;   // WiFi, OTA, web server and BLE are up
+bool wifiServicesStarted = false;
+bool nightPeek = false;        // woken by the button at night, network stays off
+unsigned long lastActivityTime = 0;
+
+// Frame pacing, CPU clock and light sleep (src/power_manager.h)
+PowerManager power;
+unsigned long lastRequestTime = 0;
+unsigned long framesDrawn = 0; // frames the loop got all the way to sending
+const unsigned long NETWORK_BUSY_MS = 2000; // full speed this long after a request
+
+// Pedometer - daily step count, persisted next to the hunger level
+Lis3dhSource accel;
+StepDetector stepDetector;
+uint32_t stepDay = 0;          // days since 1970 (local time) the count belongs to
+uint32_t savedSteps = 0;
+unsigned long lastStepSaveTime = 0;
+const unsigned long STEP_POLL_INTERVAL_MS = 200;   // FIFO holds 640 ms at 50 Hz
+const unsigned long STEP_SAVE_INTERVAL_MS = 60000; // limit flash writes
+// POSIX TZ string; sets when the daily count resets. Make it the phone's:
+// /steps only takes Google Fit totals for the day both agree it is.
+#define PET_TIMEZONE "UTC0"
+
+// Display and accelerometer share one I2C bus; sensor reads slot in
+// between display pages instead of waiting for a whole frame
+I2cBusScheduler i2cBus;
+const uint8_t STEP_POLL_PRIORITY = 2;
+
+// Treats earned from phone-reported steps, shared by every client
+PartitionLedgerFlash ledgerFlash;
+TreatLedger treatLedger(ledgerFlash);
+bool ledgerStarted = false;
+
+// The eye engine (src/eye_engine.h) with everything switched on: blinking,
+// expressions, manual mode, the reading light, needs and feeding, with
+// every input and decision kept in a RAM ring for /trace. Expressions at
+// rest come from the artwork in src/eye_artwork.h, and the pet yawns or
+// eats through the clips in src/eye_clips.h, and the eyes follow a point
+// from /look. Frames go out through the I2C scheduler so sensor reads can
+// slot in between pages.
+uint32_t needsClock();
+
+struct HungryEyes : EyeFeatures {
+  static constexpr bool readingLight = true;
+  static constexpr bool hunger = true;
+  static constexpr bool stars = true;
+  static constexpr bool artwork = true;
+  static constexpr bool clips = true;
+  static constexpr bool gaze = true;
+  static constexpr bool trace = true;
+  static constexpr bool web = true;
+  static constexpr bool ota = true;
+  static constexpr bool ble = true;
+
+  static uint32_t needsTime() { return needsClock(); }
+  static void flush(U8G2& display) { i2cBus.flushDisplay(display); }
+  static const EyeBitmap* artworkFor(EyeState state) { return EYE_ARTWORK[state]; }
+  static const EyeClip* clipOnEnter(EyeState state);
+};
 
-// Hunger System variables
-int hungerLevel = 100; // 100% full
-unsigned long lastHungerDecreaseTime = 0;
-const unsigned long HUNGER_DECREASE_INTERVAL_MS = 5000; // Decrease every 5 second
-const int HUNGER_DECREASE_AMOUNT_PERCENT = 5; // Decrease by 5% each interval
+const EyeClip* findClip(const String& name) {
+  for (int i = 0; i < EYE_CLIP_COUNT; i++) {
+    if (name == EYE_CLIPS[i].name) {
+      return &EYE_CLIPS[i];
+    }
+  }
+  return nullptr;
+}
 
-struct Star {
-  int x, y, size;
-};
+MillisClock petClock;
+EyeEngine<HungryEyes, Display> eyes(u8g2, petClock);
+PetBehavior& pet = eyes.pet();
+PetNeeds& needs = eyes.needs();
+EventTrace& trace = eyes.trace();
+
+// Getting sleepy starts with a yawn, being fed with eating (not any happy
+// spell: /emotion and BLE can set it without food)
+const EyeClip* HungryEyes::clipOnEnter(EyeState state) {
+  if (state == STATE_SLEEPY) {
+    return findClip("yawn");
+  }
+  if (state == STATE_HAPPY && pet.feeding()) {
+    return findClip("eat");
+  }
+  return nullptr;
+}
 
-Star happyStars[2]; 
-int numActiveStars = 0;
-
-// Eye state
-EyeState currentEyeState = STATE_NEUTRAL;
-EyeState targetEyeState = STATE_NEUTRAL;
-bool isBlinking = false;
-byte blinkState = 0;  // 0 = open, 1 = half-closed, 2 = closed, 3 = half-open
-bool isTransitioning = false;
-float transitionProgress = 1.0; // 0.0 to 1.0
-
-float leftEyeWidth, leftEyeHeight, rightEyeWidth, rightEyeHeight;
-float leftOffsetX, leftOffsetY, rightOffsetX, rightOffsetY;
-float leftTargetWidth, leftTargetHeight, rightTargetWidth, rightTargetHeight;
-float leftTargetOffsetX, leftTargetOffsetY, rightTargetOffsetX, rightTargetOffsetY;
-float leftAngle, rightAngle, leftTargetAngle, rightTargetAngle;
-
-int centerX, centerY, leftEyeX, rightEyeX, eyeY;
-
-const int neutralStateProbability = 70;    // 70% chance to return to neutral (increased)
-const int minNeutralDuration = 4000;        // Longer minimum time in neutral (4-8 seconds)
-const int maxNeutralDuration = 8000;        // Longer maximum time in neutral
-const int minEmotionDuration = 1200;        // Minimum time for emotions (1.2-3 seconds)
-const int maxEmotionDuration = 3000;        // Maximum time for emotions
-const int emotionChangeProbability = 30;    // 30% chance for emotion vs 70% for look direction
-const int blinkProbability = 70;            // 70% chance to blink at blink interval
-const int minBlinkInterval = 2000;          // Min time between blinks (2-5 seconds)
-const int maxBlinkInterval = 5000;          // Max time between blinks
-
-bool otaInProgress = false;
-size_t updateSize = 0;
-size_t updateProgress = 0;
-
-EyeState recentStates[3] = {STATE_NEUTRAL, STATE_NEUTRAL, STATE_NEUTRAL};
-int recentStateIndex = 0;
+bool otaInProgress = false;  // ArduinoOTA
+
+// HTTP firmware upload (/update) - streamed straight into the OTA partition,
+// optionally zlib-compressed or as a delta against the running firmware.
+// The face comes back when it's done with the screen.
+void redrawEyes() { eyes.invalidate(); }
+UpdatePartitionSink updateSink;
+OtaStream updateStream(updateSink);
+RunningPartitionImage runningImage;
+OtaDecoder httpDecoder(updateStream, &runningImage);
+OtaHttpUpload httpUpdate(httpDecoder, redrawEyes);
+unsigned int lastBleOtaPercent = 101; // > 100 forces the first redraw
 
 // Forward declarations
-void updateEyeDimensions(EyeState state, float &leftW, float &leftH, float &rightW, float &rightH,
-                         float &leftX, float &leftY, float &rightX, float &rightY,
-                         float &leftA, float &rightA);
-void drawFilledEllipse(int x0, int y0, int width, int height, float angle);
-void drawStar(int x, int y, int size);
-
-bool wasStateRecentlyUsed(EyeState state);
-void recordStateUse(EyeState state);
 void setupWiFi();
 void setupOTA();
 void setupWebServer();
+void startNetwork();
+void onWiFiConnected();
+void noteActivity();
+void noteRequest();
+void enterNightMode();
+bool nightModeDue(unsigned long currentTime);
 void handleRoot();
 void handleEmotion();
 void handleReadingLight();
 void handleManualMode();
 void handleFeed();
+void handleClip();
+void handleBusStats();
+void handleTreats();
+void handleNeeds();
+void handleNight();
+void handlePower();
+void handleLog();
+void handleTrace();
+void onBulkRequest(const uint8_t* data, size_t len);
+void bleTraceLoop();
+void handleSteps();
+void handleUpdateUpload();
+void handleUpdateDone();
+void drawUpdateProgress(unsigned int percentComplete);
+uint32_t currentDay();
+void updateSteps(unsigned long currentTime);
+void saveNeeds();
+bool otaImageHealthy();
+void updateNeedsClock(unsigned long currentTime);
 void drawStatusScreen(const String& line1, const String& line2 = "", const String& line3 = "");
 
 void setup() {
   // Initialize serial for debugging
   Serial.begin(115200);
-  Serial.println("Booting...");
+  logBegin();
+
+  // Waking from night mode: skip the boot screens and bring the pet back
+  // with the expression it went to sleep with
+  PetSnapshot snapshot;
+  uint32_t sleptSeconds = 0;
+  bool resumed = nightRestore(snapshot, sleptSeconds);
+  LOGI(LOG_SYS, resumed ? "Resuming from night mode..." : "Booting...");
+
+  u8g2.setBusClock(Display::busHz);
   u8g2.begin();
-  drawStatusScreen("ESP32 Wearable", "Starting...");
-  randomSeed(analogRead(0));
+  if (!resumed) {
+    drawStatusScreen("ESP32 Wearable", "Starting...");
+  }
 
   // Initialize Preferences and load hunger level
   preferences.begin("pet_data", false); // "pet_data" is a namespace name
-  hungerLevel = preferences.getInt("hunger", 100); // Read "hunger" key, default to 100 if not found
-  Serial.printf("Loaded Hunger Level: %d%%\n", hungerLevel);
-
-  // Calculate initial positions
-  centerX = screenWidth / 2;
-  centerY = screenHeight / 2;
-  leftEyeX = centerX - eyeSpacing / 2 - eyeBaseWidth / 2;
-  rightEyeX = centerX + eyeSpacing / 2 + eyeBaseWidth / 2;
-  eyeY = centerY;
-
-  // Initialize eye dimensions with neutral state
-  leftEyeWidth = eyeBaseWidth;
-  leftEyeHeight = eyeBaseHeight;
-  rightEyeWidth = eyeBaseWidth;
-  rightEyeHeight = eyeBaseHeight;
-  leftOffsetX = 0;
-  leftOffsetY = 0;
-  rightOffsetX = 0;
-  rightOffsetY = 0;
-  leftAngle = 0;
-  rightAngle = 0;
-
-  // Initial state
-  setEyeState(STATE_NEUTRAL);
-
-  // Initialize last blink time to trigger a blink soon after startup
-  lastBlinkTime = millis() - random(1000, 2000);
-  // Initialize hunger decrease time
-  lastHungerDecreaseTime = millis();
-
-  // Setup WiFi, OTA and Web Server
-  setupWiFi();
-  setupOTA();
-  setupWebServer();
+  needsBootClock = preferences.getUInt("needsClock", 0);
+  NeedAnchor anchors[NEED_COUNT];
+  if (preferences.getBytes("needs", anchors, sizeof(anchors)) == sizeof(anchors)) {
+    needs.restore(anchors);
+  } else {
+    // First boot with the needs system: carry over the old hunger level
+    needs.reset(needsClock());
+    needs.set(NEED_HUNGER, preferences.getInt("hunger", 100), needsClock());
+  }
+  stepDay = preferences.getUInt("stepDay", 0);
+  savedSteps = preferences.getUInt("steps", 0);
+  if (resumed) {
+    // RTC copy is at least as fresh as flash
+    needs.restore(snapshot.needs);
+    if (sleptSeconds >= NIGHT_RESTED_S) {
+      needs.set(NEED_ENERGY, NEED_FULL, needsClock());
+    }
+    stepDay = snapshot.stepDay;
+    savedSteps = snapshot.steps;
+  }
+  LOGI(LOG_PET, "Loaded Hunger Level: %d%%", (int)needs.level(NEED_HUNGER, needsClock()));
+  stepDetector.setSteps(savedSteps);
+
+  // Accelerometer shares the display's I2C bus (started by u8g2.begin())
+  if (accel.begin()) {
+    LOGI(LOG_STEPS, "Accelerometer found, %u steps today", savedSteps);
+    i2cBus.addJob("accel", updateSteps, STEP_POLL_INTERVAL_MS, STEP_POLL_PRIORITY);
+  } else {
+    LOGW(LOG_STEPS, "No accelerometer found, pedometer disabled.");
+  }
+
+  ledgerStarted = treatLedger.begin();
+  if (ledgerStarted) {
+    TreatState treats = treatLedger.state(0);
+    LOGI(LOG_STEPS, "Treat ledger: %u treats", treats.treats);
+  } else {
+    LOGW(LOG_SYS, "No ledger partition, treats disabled.");
+  }
 
-  Serial.println("Setup complete!");
+  // Neutral eyes, first blink soon after startup. Seeded from the hardware
+  // RNG; /trace snapshots carry the PRNG state, so replays don't need it.
+  trace.record(petClock.now(), TRACE_BOOT, resumed);
+  eyes.begin(((uint64_t)esp_random() << 32) | esp_random());
+  pinMode(NIGHT_WAKE_PIN, INPUT_PULLUP);
+
+  if (resumed) {
+    pet.restore((EyeState)snapshot.eyeState, snapshot.manualMode, snapshot.readingLight,
+                snapshot.needMood);
+    eyes.draw();
+    LOGI(LOG_POWER, "Resumed after %u s asleep, first frame at %lu ms", sleptSeconds, millis());
+
+    // At night a button press is just a peek: no network until morning.
+    // Otherwise connect in the background while the eyes carry on.
+    struct tm local;
+    time_t now = time(nullptr);
+    localtime_r(&now, &local);
+    nightPeek = nightWakeCause() == NIGHT_WAKE_BUTTON && now >= EPOCH_VALID && nightTime(local);
+    if (!nightPeek) {
+      startNetwork();
+    }
+  } else {
+    // Setup WiFi, OTA and Web Server
+    setupWiFi();
+    setupOTA();
+    setupWebServer();
+    setupPetBle(DEVICE_NAME);
+    networkStarted = true;
+  }
+  // Requests over the BLE bulk pipe (the trace download)
+  bleBulkSetReceiver(onBulkRequest);
+  noteActivity();
+  power.begin();
+
+  LOGI(LOG_SYS, "Setup complete!");
 }
 
 void loop() {
-  unsigned long currentTime = millis();
+  power.frameStart();
 
-  // Handle OTA updates and Web Server
-  ArduinoOTA.handle();
-  server.handleClient();
+  if (networkStarted) {
+    // Handle OTA updates and Web Server
+    ArduinoOTA.handle();
+    server.handleClient();
 
-  // Hunger decrease logic
-  if (currentTime - lastHungerDecreaseTime >= HUNGER_DECREASE_INTERVAL_MS) {
-    if (hungerLevel > 0) {
-      hungerLevel -= HUNGER_DECREASE_AMOUNT_PERCENT;
-      if (hungerLevel < 0) {
-        hungerLevel = 0; // Ensure hunger doesn't go below 0
-      }
-      preferences.putInt("hunger", hungerLevel); // Save hunger level whenever it changes
-      Serial.printf("Hunger Level: %d%%\n", hungerLevel);
+    // Keep or roll back a freshly flashed image once it has run long enough
+    // to show it works (otaImageHealthy() below)
+    otaHealthCheck(millis(), otaImageHealthy);
+
+    // Apply queued BLE commands and notify subscribers of state changes
+    petBleLoop(millis());
+    bleTraceLoop();
+
+    // A connection made in the background after waking from night mode
+    if (!wifiServicesStarted && WiFi.status() == WL_CONNECTED) {
+      onWiFiConnected();
     }
-    lastHungerDecreaseTime = currentTime;
   }
 
-  // Handle return from happy state after feeding
-  if (happyStateEndTime > 0 && currentTime >= happyStateEndTime) {
-    if (!wasManualModeBeforeFeed) { // Only set to neutral if it was auto mode before feed
-      setEyeState(STATE_NEUTRAL);
-    }
-    manualMode = wasManualModeBeforeFeed; // Restore original manual mode
-    happyStateEndTime = 0; // Reset timer
-    Serial.println("Returned from happy state after feeding.");
+  // Loop time, taken after the commands above; pet.update() reads its own
+  // clock, so it never sees time go backwards either
+  unsigned long currentTime = millis();
+
+  // The wake button doubles as a "someone is here" signal
+  if (digitalRead(NIGHT_WAKE_PIN) == LOW) {
+    noteActivity();
   }
 
+  // Needs decay on their own; just keep the clock they run on sane
+  updateNeedsClock(currentTime);
+
+  // Sensor jobs on the shared I2C bus (pedometer FIFO drain); drawing a
+  // frame also runs them between display pages
+  i2cBus.service();
+
   // Skip eye animation if OTA is in progress
-  if (otaInProgress) {
+  if (otaInProgress || httpUpdate.inProgress()) {
     return;
   }
 
+  // Show progress instead of the eyes while a BLE firmware transfer is
+  // moving. A dropped or stalled one waiting to resume keeps the face, but
+  // holds off night mode so the partial image survives.
+  bool bleOtaShowing = bleOtaReceiving(currentTime);
+  if (!bleOtaShowing && lastBleOtaPercent <= 100) {
+    lastBleOtaPercent = 101;
+    eyes.invalidate();
+  }
+
+  // Sleep through the night, a long idle spell, or the end of a night-time peek
+  if (bleOtaSize() == 0 && nightModeDue(currentTime)) {
+    enterNightMode();
+  }
+
   // Reconnect WiFi if disconnected (every 2 seconds)
-  if (WiFi.status() != WL_CONNECTED &&
+  if (networkStarted && WiFi.status() != WL_CONNECTED &&
       currentTime - lastNetworkCheckTime > networkCheckInterval) {
-    Serial.println("WiFi disconnected, attempting to reconnect...");
+    LOGW(LOG_NET, "WiFi disconnected, attempting to reconnect...");
     WiFi.reconnect();
     lastNetworkCheckTime = currentTime;
   }
 
-  // Blinking logic - random intervals with probability
-  if (!isBlinking && currentTime - lastBlinkTime > random(minBlinkInterval, maxBlinkInterval)) {
-    if (random(100) < blinkProbability) { // 70% chance to blink
-      isBlinking = true;
-      blinkState = 1;
-      lastBlinkTime = currentTime;
+  // Blinking, transitions, the needs override and random expression
+  // changes, then the frame if the face changed. The most pressing need
+  // shows on the face unless it's the happy spell after a feed.
+  bool wasFeeding = pet.feeding();
+  bool wasNeedMood = pet.moodFromNeeds();
+  bool drawn = false;
+  if (bleOtaShowing) {
+    unsigned int percentComplete = (bleOtaWritten() * 100) / bleOtaSize();
+    if (percentComplete != lastBleOtaPercent) {
+      drawUpdateProgress(percentComplete);
+      lastBleOtaPercent = percentComplete;
+    }
+  } else {
+    drawn = eyes.frame();
+  }
+  if (wasFeeding && !pet.feeding()) {
+    LOGI(LOG_PET, "Returned from happy state after feeding.");
+  }
+  if (pet.moodFromNeeds() != wasNeedMood) {
+    if (pet.moodFromNeeds()) {
+      LOGI(LOG_PET, "Pet needs attention, setting state %d.", pet.state());
     } else {
-      // Reset the timer even if it don't blink this time
-      lastBlinkTime = currentTime;
+      LOGI(LOG_PET, "Pet needs met, returning to NEUTRAL state.");
     }
   }
 
-  // Process blink animation
-  if (isBlinking) {
-    if (currentTime - lastBlinkTime > blinkDuration / 4) {
-      blinkState++;
-      if (blinkState > 3) {
-        isBlinking = false;
-        blinkState = 0;
-      }
-      lastBlinkTime = currentTime;
-    }
+  PowerLoad load = POWER_LOAD_STATIC;
+  uint32_t ioUs = 0;
+  if (drawn) {
+    framesDrawn++;
+    load = POWER_LOAD_ANIMATING;
+    ioUs = i2cBus.lastFlushUs();
+  }
+
+  if (bleOtaShowing || currentTime - lastRequestTime < NETWORK_BUSY_MS) {
+    load = POWER_LOAD_NETWORK;
+  }
+
+  // Wait for the next frame at the lowest clock (and light sleep) that keeps up
+  power.frameEnd(load, ioUs, networkStarted);
+}
+
+// Days since 1970 in local time, or 0 until NTP has set the clock
+uint32_t currentDay() {
+  time_t now = time(nullptr);
+  if (now < 1600000000) { // clock not set yet
+    return 0;
   }
+  struct tm local;
+  localtime_r(&now, &local);
+  return (uint32_t)((now + local.tm_gmtoff) / 86400);
+}
 
-  // Handle transitions between states
-  if (isTransitioning) {
-    float progress = (float)(currentTime - transitionStartTime) / transitionDuration;
-    if (progress >= 1.0) {
-      // Transition complete
-      progress = 1.0;
-      isTransitioning = false;
-      currentEyeState = targetEyeState;
+void updateSteps(unsigned long currentTime) {
+  uint32_t day = currentDay();
+  if (day != 0 && day != stepDay) {
+    // New day (or first time the clock is known): start counting from zero
+    if (stepDay != 0) {
+      stepDetector.setSteps(0);
     }
+    stepDay = day;
+    preferences.putUInt("stepDay", stepDay);
+    lastStepSaveTime = 0;
+  }
+
+  if (stepDetector.poll(accel) > 0) {
+    noteActivity();
+    LOGD(LOG_STEPS, "Steps today: %u", stepDetector.steps());
+  }
+
+  // Save whenever it changes, but at most once a minute
+  if (stepDetector.steps() != savedSteps &&
+      (lastStepSaveTime == 0 || currentTime - lastStepSaveTime >= STEP_SAVE_INTERVAL_MS)) {
+    savedSteps = stepDetector.steps();
+    preferences.putUInt("steps", savedSteps);
+    lastStepSaveTime = currentTime;
+  }
+}
+
+// Seconds for the needs engine: the epoch once NTP has synced, and until
+// then counting on from the last saved value. Time spent switched off is
+// caught up in one go at the first sync.
+uint32_t needsClock() {
+  time_t now = time(nullptr);
+  if (now >= EPOCH_VALID) {
+    return (uint32_t)now;
+  }
+  return needsBootClock + millis() / 1000;
+}
 
-    // Interpolate between states
-    transitionProgress = progress;
-    leftEyeWidth = leftEyeWidth + (leftTargetWidth - leftEyeWidth) * progress;
-    leftEyeHeight = leftEyeHeight + (leftTargetHeight - leftEyeHeight) * progress;
-    rightEyeWidth = rightEyeWidth + (rightTargetWidth - rightEyeWidth) * progress;
-    rightEyeHeight = rightEyeHeight + (rightTargetHeight - rightEyeHeight) * progress;
-    leftOffsetX = leftOffsetX + (leftTargetOffsetX - leftOffsetX) * progress;
-    leftOffsetY = leftOffsetY + (leftTargetOffsetY - leftOffsetY) * progress;
-    rightOffsetX = rightOffsetX + (rightTargetOffsetX - rightOffsetX) * progress;
-    rightOffsetY = rightOffsetY + (rightTargetOffsetY - rightOffsetY) * progress;
-    leftAngle = leftAngle + (leftTargetAngle - leftAngle) * progress;
-    rightAngle = rightAngle + (rightTargetAngle - rightAngle) * progress;
-  }
-
-  // Hunger-based eye state override
-  // This override should apply unless it's currently in the temporary STATE_HAPPY
-  if (currentEyeState != STATE_HAPPY) {
-    if (hungerLevel <= 0) { // Critically hungry (0%)
-        // If the pet is critically hungry (0%) and not already sad, force SAD state
-        // This takes precedence over other auto states, but a manual state can persist unless critically hungry (0%).
-        if (!manualMode || (manualMode && currentEyeState != STATE_SAD)) { // If auto mode, or if manual and not already sad due to hunger
-              setEyeState(STATE_SAD);
-              Serial.println("Pet is critically hungry (0%), setting state to SAD.");
-        }
-    } else if (hungerLevel > 0 && currentEyeState == STATE_SAD) {
-        // If hunger has improved and currently sad (presumably due to hunger),
-        // and not in manual mode, return to neutral.
-        if (!manualMode) { // Only revert if not in manual override
-            setEyeState(STATE_NEUTRAL);
-            Serial.println("Pet hunger improved, returning to NEUTRAL state.");
-        }
+void saveNeeds() {
+  preferences.putBytes("needs", needs.anchors(), sizeof(NeedAnchor) * NEED_COUNT);
+  preferences.putUInt("needsClock", needsClock());
+}
+
+// Asked once, OTA_HEALTH_CHECK_MS after a fresh OTA boot. A client that got
+// through (an HTTP request, a BLE command or connection) is proof enough.
+// Otherwise the image must have drawn a face and round-tripped the needs
+// through Preferences and the treat ledger through flash without errors.
+// WiFi being up isn't asked for: it may just be out of range.
+bool otaImageHealthy() {
+  if (lastRequestTime != 0 || petBleClientSeen()) {
+    return true;
+  }
+  if (framesDrawn == 0) {
+    LOGW(LOG_OTA, "Health check: no frame drawn.");
+    return false;
+  }
+  saveNeeds();
+  NeedAnchor anchors[NEED_COUNT];
+  if (preferences.getBytes("needs", anchors, sizeof(anchors)) != sizeof(anchors) ||
+      memcmp(anchors, needs.anchors(), sizeof(anchors)) != 0) {
+    LOGW(LOG_OTA, "Health check: needs did not read back.");
+    return false;
+  }
+  if (ledgerStarted) {
+    TreatState before = treatLedger.state(0);
+    if (!treatLedger.begin() || treatLedger.state(0).treats != before.treats) {
+      LOGW(LOG_OTA, "Health check: treat ledger did not read back.");
+      return false;
     }
   }
+  return true;
+}
 
+void updateNeedsClock(unsigned long currentTime) {
+  uint32_t now = needsClock();
+  if (!needsClockSynced && now >= EPOCH_VALID) {
+    needsClockSynced = true;
+    if (needsBootClock < EPOCH_VALID) {
+      // Anchors were taken on uptime - move them onto the real clock
+      needs.shiftTime((int32_t)(now - (needsBootClock + currentTime / 1000)));
+      saveNeeds();
+    }
+  }
+  // Remember roughly when we were last on, in case NTP is unavailable next boot
+  if (currentTime - lastNeedsClockSave >= NEEDS_CLOCK_SAVE_MS) {
+    preferences.putUInt("needsClock", now);
+    lastNeedsClockSave = currentTime;
+  }
+}
 
- // State change logic with improved randomization
-  if (!manualMode && !isTransitioning && currentEyeState != STATE_SAD && currentTime - lastStateChangeTime >
-      (currentEyeState == STATE_NEUTRAL ?
-        random(minNeutralDuration, maxNeutralDuration) :
-        random(minEmotionDuration, maxEmotionDuration))) {
+// Anything that shows someone is around postpones night mode
+void noteActivity() {
+  lastActivityTime = millis();
+}
 
-    // Decide next state - increased favor for neutral state
-    if (currentEyeState != STATE_NEUTRAL && random(100) < neutralStateProbability) {
-      // Go back to neutral
-      setEyeState(STATE_NEUTRAL);
-    } else {
-      // Choose a new random state that's not recently used
-      EyeState newState;
-      bool validState = false;
-
-      while (!validState) {
-        if (random(100) < emotionChangeProbability) {
-          // Pick an emotion state (0-4)
-          newState = (EyeState)random(5);
-        } else {
-          // Pick a directional state (5-9)
-          newState = (EyeState)(random(5) + 5);
-        }
-
-        // Don't use the current state or recently used states, and not STATE_HAPPY
-        if (newState != currentEyeState && !wasStateRecentlyUsed(newState) && newState != STATE_HAPPY) {
-          validState = true;
-        }
-      }
+// A request over WiFi or BLE: also keep the CPU at full speed for a while
+void noteRequest() {
+  noteActivity();
+  lastRequestTime = millis();
+}
 
-      setEyeState(newState);
-      recordStateUse(newState);
+bool nightModeDue(unsigned long currentTime) {
+  if (pet.readingLight() || pet.feeding()) {
+    return false;
+  }
+  unsigned long idle = currentTime - lastActivityTime;
+  if (nightPeek) {
+    return idle >= NIGHT_PEEK_MS;
+  }
+  time_t now = time(nullptr);
+  if (now >= EPOCH_VALID) {
+    struct tm local;
+    localtime_r(&now, &local);
+    if (nightTime(local)) {
+      return idle >= NIGHT_SETTLE_MS;
     }
+  }
+  return idle >= NIGHT_IDLE_MS;
+}
 
-    lastStateChangeTime = currentTime;
+// Power everything down and deep-sleep until morning (or for a nap when the
+// time isn't known or it's daytime), remembering exactly how the pet looked
+void enterNightMode() {
+  PetSnapshot snapshot;
+  snapshot.eyeState = pet.state();
+  snapshot.needMood = pet.moodFromNeeds();
+  snapshot.manualMode = pet.manualMode();
+  snapshot.readingLight = pet.readingLight();
+  memcpy(snapshot.needs, needs.anchors(), sizeof(snapshot.needs));
+  snapshot.steps = stepDetector.steps();
+  snapshot.stepDay = stepDay;
+
+  // Flash copies too, in case the battery runs out overnight
+  saveNeeds();
+  if (stepDetector.steps() != savedSteps) {
+    savedSteps = stepDetector.steps();
+    preferences.putUInt("steps", savedSteps);
   }
 
-  // Draw the eyes based on current state
-  drawEyes();
+  uint32_t seconds = NIGHT_NAP_S;
+  time_t now = time(nullptr);
+  if (now >= EPOCH_VALID) {
+    struct tm local;
+    localtime_r(&now, &local);
+    if (nightTime(local)) {
+      seconds = nightSecondsUntilMorning(local);
+    }
+  }
 
-  // Small delay to control frame rate
-  delay(16);  // ~60fps
+  u8g2.setPowerSave(1);
+  accel.powerDown();
+  if (networkStarted) {
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+  }
+  nightSleep(snapshot, seconds);
 }
 
 // Setup WiFi Connection
@@ -337,28 +579,17 @@ void setupWiFi() {
   unsigned long startTime = millis();
   while (WiFi.status() != WL_CONNECTED && millis() - startTime < 20000) {
     delay(500);
-    Serial.print(".");
   }
 
   if (WiFi.status() == WL_CONNECTED) {
-    Serial.println("");
-    Serial.print("Connected to ");
-    Serial.println(ssid);
-    Serial.print("IP address: ");
-    Serial.println(WiFi.localIP().toString());
-
-    // Setup mDNS responder
-    if (!MDNS.begin(DEVICE_NAME)) {
-      Serial.println("Error setting up MDNS responder!");
-    } else {
-      Serial.println("mDNS responder started");
-      MDNS.addService("http", "tcp", 80);
-    }
+    LOGI(LOG_NET, "Connected to %s, IP address %s", ssid, WiFi.localIP().toString().c_str());
+
+    onWiFiConnected();
 
     drawStatusScreen("Connected", "" + WiFi.localIP().toString());
     delay(3000);  // Show IP for 3 seconds
   } else {
-    Serial.println("WiFi connection failed!");
+    LOGE(LOG_NET, "WiFi connection failed!");
     drawStatusScreen("Failed", "to connect", "Will retry...");
     delay(2000);
   }
@@ -366,6 +597,33 @@ void setupWiFi() {
   delay(3500);
 }
 
+// Time and mDNS, once per boot as soon as WiFi is up
+void onWiFiConnected() {
+  wifiServicesStarted = true;
+
+  // Local time for the daily step count
+  configTzTime(PET_TIMEZONE, "pool.ntp.org");
+
+  // Setup mDNS responder
+  if (!MDNS.begin(DEVICE_NAME)) {
+    LOGE(LOG_NET, "Error setting up MDNS responder!");
+  } else {
+    LOGI(LOG_NET, "mDNS responder started");
+    MDNS.addService("http", "tcp", 80);
+  }
+}
+
+// Network bring-up after a night-mode wake: same services as setup(), but
+// WiFi connects in the background instead of holding up the eyes
+void startNetwork() {
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(ssid, password);
+  setupOTA();
+  setupWebServer();
+  setupPetBle(DEVICE_NAME);
+  networkStarted = true;
+}
+
 // Setup OTA Updates
 void setupOTA() {
   // Port defaults to 3232
@@ -385,38 +643,25 @@ void setupOTA() {
       type = "filesystem";
       // NOTE: if updating SPIFFS this would be the place to unmount SPIFFS using SPIFFS.end()
     }
-    Serial.println("Start updating " + type);
+    LOGI(LOG_OTA, "Start updating %s", type.c_str());
     otaInProgress = true;
     drawStatusScreen("Update", "Starting...");
   });
 
   ArduinoOTA.onEnd([]() {
-    Serial.println("\\nOTA update complete!");
+    LOGI(LOG_OTA, "OTA update complete!");
+    logFlush();
     drawStatusScreen("Update", "complete.", "Restarting.");
     delay(1000);
   });
 
   ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
     unsigned int percentComplete = progress / (total / 100);
-    Serial.printf("OTA Progress: %u%%\\r", percentComplete);
-
-    // Update the display with progress
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_9x15_tf);
-    u8g2.drawStr(0, 15, "Updating");
-
-    // Draw progress bar
-    u8g2.drawFrame(0, 25, 128, 10);
-    u8g2.drawBox(0, 25, (percentComplete * 128) / 100, 10);
-
-    // Display percentage
-    String percentStr = String(percentComplete) + "%";
-    u8g2.drawStr(52, 50, percentStr.c_str());
-    u8g2.sendBuffer();
+    LOGD(LOG_OTA, "OTA Progress: %u%%", percentComplete);
+    drawUpdateProgress(percentComplete);
   });
 
   ArduinoOTA.onError([](ota_error_t error) {
-    Serial.printf("Error[%u]: ", error);
     String errorMsg;
 
     if (error == OTA_AUTH_ERROR) {
@@ -431,14 +676,14 @@ void setupOTA() {
       errorMsg = "End Failed";
     }
 
-    Serial.println(errorMsg);
+    LOGE(LOG_OTA, "Error[%u]: %s", error, errorMsg.c_str());
     drawStatusScreen("OTA Error", errorMsg);
     delay(2000);
     otaInProgress = false;
   });
 
   ArduinoOTA.begin();
-  Serial.println("OTA ready");
+  LOGI(LOG_OTA, "OTA ready");
 }
 
 // Setup Web Server
@@ -449,13 +694,25 @@ void setupWebServer() {
   server.on("/readinglight", HTTP_GET, handleReadingLight);
   server.on("/manual", HTTP_GET, handleManualMode);
   server.on("/feed", HTTP_GET, handleFeed);
+  server.on("/clip", HTTP_GET, handleClip);
+  EyeLookRoute<HungryEyes::gaze>::add(server, eyes, noteRequest);
+  server.on("/bus", HTTP_GET, handleBusStats);
+  server.on("/treats", HTTP_GET, handleTreats);
+  server.on("/needs", HTTP_GET, handleNeeds);
+  server.on("/night", HTTP_GET, handleNight);
+  server.on("/power", HTTP_GET, handlePower);
+  server.on("/log", HTTP_GET, handleLog);
+  server.on("/trace", HTTP_GET, handleTrace);
+  server.on("/steps", HTTP_GET, handleSteps);
+  server.on("/update", HTTP_POST, handleUpdateDone, handleUpdateUpload);
   server.begin();
-  Serial.println("Web server started");
+  LOGI(LOG_NET, "Web server started");
 
 }
 
 // Web Server Route Handlers
 void handleRoot() {
+  noteRequest();
   String html = "<!DOCTYPE html><html lang='en'><head>";
   html += "<meta charset='UTF-8'>";
   html += "<meta name='viewport' content='width=device-width, initial-scale=1.0'>";
@@ -586,11 +843,50 @@ void handleRoot() {
 }
 
 
+// Pet commands - shared by the HTTP handlers below and the BLE service
+bool petSetEmotion(int state) {
+  noteRequest();
+  return pet.setEmotion(state);
+}
+
+void petSetReadingLight(bool on) {
+  noteRequest();
+  pet.setReadingLight(on);
+}
+
+void petSetManualMode(bool on) {
+  noteRequest();
+  pet.setManualMode(on);
+}
+
+void petFeed() {
+  noteRequest();
+  // Reset hunger level to full (100%); a treat cheers the pet up too
+  uint32_t now = needsClock();
+  needs.set(NEED_HUNGER, NEED_FULL, now);
+  needs.add(NEED_HAPPINESS, 20, now);
+  saveNeeds();
+  trace.record(petClock.now(), TRACE_NEED, NEED_HUNGER, NEED_FULL);
+  LOGI(LOG_PET, "Hunger level reset to 100%% after feeding.");
+
+  // Happy eyes for a few seconds, with manual mode held so nothing else
+  // takes over, then back to the previous mode
+  pet.feed();
+}
+
+PetStatus petStatus() {
+  PetStatus status;
+  status.eyeState = pet.state();
+  status.manualMode = pet.manualMode();
+  status.readingLight = pet.readingLight();
+  status.hunger = (uint8_t)needs.level(NEED_HUNGER, needsClock());
+  return status;
+}
+
 void handleEmotion() {
   if (server.hasArg("state")) {
     int stateValue = server.arg("state").toInt();
-    if (stateValue >= 0 && stateValue < STATE_COUNT) {
-      setEyeState((EyeState)stateValue);
+    if (petSetEmotion(stateValue)) {
       server.send(200, "text/plain", "Emotion set to " + String(stateValue));
     } else {
       server.send(400, "text/plain", "Invalid state value");
@@ -601,9 +897,9 @@ void handleEmotion() {
 }
 
 void handleReadingLight() {
-  readingLightOn = !readingLightOn; // Toggle the reading light
+  petSetReadingLight(!pet.readingLight()); // Toggle the reading light
 
-  if (readingLightOn) {
+  if (pet.readingLight()) {
     server.send(200, "text/plain", "Reading light ON");
   } else {
     server.send(200, "text/plain", "Reading light OFF");
@@ -612,356 +908,316 @@ void handleReadingLight() {
 
 
 void handleManualMode() {
-  manualMode = !manualMode; // Toggle manual mode
+  petSetManualMode(!pet.manualMode()); // Toggle manual mode
 
-  if (manualMode) {
+  if (pet.manualMode()) {
     server.send(200, "text/plain", "Manual mode ON");
   } else {
     server.send(200, "text/plain", "Manual mode OFF");
-    // Reset to neutral when exiting manual mode
-    setEyeState(STATE_NEUTRAL);
   }
 }
 
 void handleFeed() {
-  // Reset hunger level to full (100%)
-  hungerLevel = 100;
-  preferences.putInt("hunger", hungerLevel); // Save hunger level when fed
-  Serial.println("Hunger level reset to 100% after feeding.");
-
-  // Set happy expression for feeding
-  setEyeState(STATE_HAPPY);
-
-  // Store the current manual mode state
-  wasManualModeBeforeFeed = manualMode;
-
-  // Temporarily set manual mode to prevent other state changes during feeding
-  manualMode = true;
-
-  // Schedule return to previous mode after 3 seconds
-  happyStateEndTime = millis() + 3000; // 3 seconds from now
-
+  petFeed();
   server.send(200, "text/plain", "Pet fed! Happy eyes activated");
 }
-void drawStatusScreen(const String& line1, const String& line2, const String& line3) {
-  u8g2.clearBuffer();
-  u8g2.setFont(u8g2_font_9x15_tf);
 
-  int width = u8g2.getStrWidth(line1.c_str());
-  u8g2.drawStr((screenWidth - width) / 2, 15, line1.c_str());
-
-  if (line2.length() > 0) {
-    width = u8g2.getStrWidth(line2.c_str());
-    u8g2.drawStr((screenWidth - width) / 2, 35, line2.c_str());
+// /clip?name=sneeze - play an animation over the face
+void handleClip() {
+  noteRequest();
+  const EyeClip* clip = findClip(server.arg("name"));
+  if (!clip || !eyes.play(*clip)) {
+    server.send(400, "text/plain", "Unknown clip");
+    return;
   }
+  server.send(200, "text/plain", String("Playing ") + clip->name);
+}
 
-  if (line3.length() > 0) {
-    width = u8g2.getStrWidth(line3.c_str());
-    u8g2.drawStr((screenWidth - width) / 2, 55, line3.c_str());
+// Reply to /treats and /steps with the ledger state, whatever the outcome,
+// so a client that lost a race can recompute and retry straight away
+void sendLedgerState(LedgerStatus status) {
+  TreatState treats = treatLedger.state(currentDay());
+  int code = 200;
+  if (status == LEDGER_CONFLICT || status == LEDGER_WRONG_DAY || status == LEDGER_NO_TREATS) {
+    code = 409;
+  } else if (status == LEDGER_NO_CLOCK) {
+    code = 503;
+  } else if (status == LEDGER_FLASH_ERROR) {
+    code = 500;
   }
-
-  u8g2.sendBuffer();
+  String json = "{\"day\":" + String(treats.day) + ",\"steps\":" + String(treats.steps) +
+                ",\"converted\":" + String(treats.converted) + ",\"treats\":" + String(treats.treats) +
+                ",\"perTreat\":" + String(LEDGER_STEPS_PER_TREAT) + ",\"status\":\"" +
+                TreatLedger::statusString(status) + "\"}";
+  server.send(code, "application/json", json);
 }
 
-// Check if a state was recently used
-bool wasStateRecentlyUsed(EyeState state) {
-  for (int i = 0; i < 3; i++) {
-    if (recentStates[i] == state) {
-      return true;
+// /treats                      - current balance
+// /treats?convert=1            - turn all unconverted steps into treats
+// /treats?spend=N[&base=T]     - use N treats, optionally only if the balance is still T
+void handleTreats() {
+  noteRequest();
+  LedgerStatus status = LEDGER_OK;
+  if (server.hasArg("convert")) {
+    uint32_t added;
+    status = treatLedger.convert(currentDay(), added);
+    if (added > 0) {
+      LOGI(LOG_STEPS, "Converted steps into %u treats", added);
     }
+  } else if (server.hasArg("spend")) {
+    uint32_t base = server.hasArg("base") ? server.arg("base").toInt() : LEDGER_ANY;
+    status = treatLedger.spend(currentDay(), server.arg("spend").toInt(), base);
   }
-  return false;
-}
-
-void recordStateUse(EyeState state) {
-  recentStates[recentStateIndex] = state;
-  recentStateIndex = (recentStateIndex + 1) % 3;
+  sendLedgerState(status);
 }
 
-void setEyeState(EyeState newState) {
-  if (isTransitioning || newState == currentEyeState) {
+// /steps?day=D&base=B&delta=N - add N steps to day D, the client's own
+// local day, whose total it last saw as B. Replays, stale clients and a
+// D that isn't today here (a phone in another time zone) get 409.
+void handleSteps() {
+  noteRequest();
+  if (!server.hasArg("day") || !server.hasArg("base") || !server.hasArg("delta")) {
+    server.send(400, "text/plain", "Need day, base and delta");
     return;
   }
+  sendLedgerState(treatLedger.addSteps(currentDay(), server.arg("day").toInt(),
+                                       server.arg("base").toInt(), server.arg("delta").toInt()));
+}
 
-  targetEyeState = newState;
-  isTransitioning = true;
-  transitionStartTime = millis();
-  transitionProgress = 0.0;
-
-  updateEyeDimensions(
-    newState,
-    leftTargetWidth, leftTargetHeight,
-    rightTargetWidth, rightTargetHeight,
-    leftTargetOffsetX, leftTargetOffsetY,
-    rightTargetOffsetX, rightTargetOffsetY,
-    leftTargetAngle, rightTargetAngle
-  );
+// /needs              - current level of every need
+// /needs?care=<need>  - top one up (energy after a rest, cleanliness after
+//                       a wash, ...); hunger goes through /feed
+void handleNeeds() {
+  noteRequest();
+  uint32_t now = needsClock();
+  if (server.hasArg("care")) {
+    int need = 0;
+    while (need < NEED_COUNT && server.arg("care") != PetNeeds::name((PetNeed)need)) {
+      need++;
+    }
+    if (need == NEED_COUNT || need == NEED_HUNGER) {
+      server.send(400, "text/plain", "Unknown need");
+      return;
+    }
+    needs.set((PetNeed)need, NEED_FULL, now);
+    saveNeeds();
+    trace.record(petClock.now(), TRACE_NEED, need, NEED_FULL);
+  }
 
-  if (newState == STATE_HAPPY) {
-    numActiveStars = 2; // Only two stars
+  String json = "{";
+  for (int need = 0; need < NEED_COUNT; need++) {
+    if (need > 0) {
+      json += ",";
+    }
+    json += "\"" + String(PetNeeds::name((PetNeed)need)) + "\":" +
+            String((int)needs.level((PetNeed)need, now));
+  }
+  json += "}";
+  server.send(200, "application/json", json);
+}
 
-    // Top-right, small star
-    happyStars[0].x = 105;
-    happyStars[0].y = 15;
-    happyStars[0].size = 3;
+// Night mode: time spent asleep and the average current it works out to
+void handleNight() {
+  server.send(200, "text/plain", nightReport());
+}
 
-    // Bottom-left, a little big star
-    happyStars[1].x = 20;
-    happyStars[1].y = 50;
-    happyStars[1].size = 6;
+// Frame pacing: clock, light sleep share and deadline misses
+void handlePower() {
+  server.send(200, "text/plain", power.report());
+}
 
-  } else {
-    numActiveStars = 0; // Clear stars when not in happy state
-  }
-}
-
-void updateEyeDimensions(EyeState state, float &leftW, float &leftH, float &rightW, float &rightH,
-                         float &leftX, float &leftY, float &rightX, float &rightY,
-                         float &leftA, float &rightA) {
-  // Set default dimensions
-  leftW = eyeBaseWidth;
-  leftH = eyeBaseHeight;
-  rightW = eyeBaseWidth;
-  rightH = eyeBaseHeight;
-  leftX = 0;
-  leftY = 0;
-  rightX = 0;
-  rightY = 0;
-  leftA = 0;
-  rightA = 0;
-
-  // Apply state-specific transformations - more dramatic emotional changes
-  switch (state) {
-    case STATE_ANGRY:
-      // Angry eyes - angled inward and narrowed
-      leftW = eyeBaseWidth * 0.7;
-      leftH = eyeBaseHeight * 0.7;
-      rightW = eyeBaseWidth * 0.7;
-      rightH = eyeBaseHeight * 0.7;
-      leftX = -5;
-      rightX = 5;
-      leftY = -2;
-      rightY = -2;
-      leftA = -0.5;  // Angle in radians (~30 degrees inward)
-      rightA = 0.5;
-      break;
-
-    case STATE_SURPRISED:
-      // Surprised - wide, round eyes
-      leftW = eyeBaseWidth * 1.4;
-      leftH = eyeBaseWidth * 1.4;  // Round shape
-      rightW = eyeBaseWidth * 1.4;
-      rightH = eyeBaseWidth * 1.4;
-      leftY = -5;
-      rightY = -5;
-      break;
-
-    case STATE_SLEEPY:
-      // Sad - droopy eyes
-      leftW = eyeBaseWidth * 0.9;
-      leftH = eyeBaseHeight * 0.7;
-      rightW = eyeBaseWidth * 0.9;
-      rightH = eyeBaseHeight * 0.7;
-      leftY = 8;
-      rightY = 8;
-      leftA = 0.3;  // Outer corners drooping
-      rightA = -0.3;
-      break;
-
-    case STATE_SUSPICIOUS:
-      // Suspicious - one eyebrow raised
-      leftW = eyeBaseWidth * 0.75;
-      leftH = eyeBaseHeight * 0.6;
-      rightW = eyeBaseWidth * 0.9;
-      rightH = eyeBaseHeight * 0.9;
-      leftY = -5;
-      rightY = 3;
-      leftA = 0.2;
-      break;
-
-    case STATE_LEFT:
-      // Looking left - improved positioning
-      // Left eye (smaller)
-      leftW = eyeBaseWidth * 0.5;    // Slightly larger than before (was 0.4)
-      leftH = eyeBaseHeight * 0.7;   // Slightly larger than before (was 0.6)
-      leftX = -10;                   // Keep same position for smaller eye
-
-      // Right eye (bigger)
-      rightW = eyeBaseWidth * 0.8;   // Reduced width (was 1.2)
-      rightH = eyeBaseHeight * 1.1;  // Slightly increased height
-      rightX = -12;                  // Move closer to the smaller eye (was -4)
-      break;
-
-    case STATE_RIGHT:
-      // Looking right - improved positioning
-      // Left eye (bigger)
-      leftW = eyeBaseWidth * 0.8;    // Reduced width (was 1.2)
-      leftH = eyeBaseHeight * 1.1;   // Slightly increased height
-      leftX = 12;                    // Move closer to the smaller eye (was 4)
-
-      // Right eye (smaller)
-      rightW = eyeBaseWidth * 0.5;   // Slightly larger than before (was 0.4)
-      rightH = eyeBaseHeight * 0.7;  // Slightly larger than before (was 0.6)
-      rightX = 10;                   // Keep same position for smaller eye
-      break;
-
-    case STATE_UP:
-      // Looking up - more dramatic
-      leftW = eyeBaseWidth * 0.9;
-      leftH = eyeBaseHeight * 0.65;
-      rightW = eyeBaseWidth * 0.9;
-      rightH = eyeBaseHeight * 0.65;
-      leftY = -12;
-      rightY = -12;
-      break;
-
-    case STATE_DOWN:
-      // Looking down - more dramatic
-      leftW = eyeBaseWidth * 0.9;
-      leftH = eyeBaseHeight * 0.65;
-      rightW = eyeBaseWidth * 0.9;
-      rightH = eyeBaseHeight * 0.65;
-      leftY = 12;
-      rightY = 12;
-      break;
-
-    case STATE_SAD:
-      // Sleepy - half-closed eyes
-      leftW = eyeBaseWidth * 1.0;
-      leftH = eyeBaseHeight * 0.45;
-      rightW = eyeBaseWidth * 1.0;
-      rightH = eyeBaseHeight * 0.45;
-      leftY = 8;
-      rightY = 8;
-      break;
-
-    case STATE_HAPPY:
-      // Happy - aiming for a "crescent moon" or "smiling eye" effect
-      leftW = eyeBaseWidth * 1.3;   // Slightly wider
-      leftH = eyeBaseHeight * 0.3;  // **Significantly flatter to create the "line" effect**
-      rightW = eyeBaseWidth * 1.3;
-      rightH = eyeBaseHeight * 0.3; // **Significantly flatter**
-
-      leftY = -6; // **Move eyes higher up the face to simulate upward curve of a smile**
-      rightY = -6; // **Move eyes higher up**
-
-      leftX = -3; // Slightly shift inwards for a more "squinty" happy look
-      rightX = 3; // Slightly shift inwards
-
-      // Add a slight outward rotation to give an upward curved appearance
-      leftA = -0.05; // Rotate left eye slightly clockwise (outer corner up)
-      rightA = 0.05; // Rotate right eye slightly counter-clockwise (outer corner up)
-      break;
-
-    case STATE_NEUTRAL:
-    default:
-      // Normal state - no changes
-      break;
-  }
-}
-
-// Function to draw a 4-sided star (diamond shape)
-void drawStar(int x, int y, int size) {
-  u8g2.setDrawColor(1); // Ensure stars are white
-  // Draw a filled diamond shape
-  u8g2.drawTriangle(x, y - size, x + size, y, x, y + size);
-  u8g2.drawTriangle(x, y - size, x - size, y, x, y + size);
-}
-
-void drawEyes() {
-  // Skip drawing if OTA is in progress
-  if (otaInProgress) {
-    return;
+// /log                              - recent log output
+// /log?module=<name|all>&level=<l>  - set the minimum level for a module,
+//                                     e.g. module=steps&level=debug
+void handleLog() {
+  if (server.hasArg("level")) {
+    LogLevel level;
+    if (!logParseLevel(server.arg("level").c_str(), level)) {
+      server.send(400, "text/plain", "Unknown level");
+      return;
+    }
+    String name = server.hasArg("module") ? server.arg("module") : "all";
+    LogModule module;
+    if (name == "all") {
+      for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+        logSetLevel((LogModule)i, level);
+      }
+    } else if (logParseModule(name.c_str(), module)) {
+      logSetLevel(module, level);
+    } else {
+      server.send(400, "text/plain", "Unknown module");
+      return;
+    }
   }
 
-  u8g2.clearBuffer();
+  String text;
+  for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+    text += String(logModuleName((LogModule)i)) + "=" + logLevelName(logLevel((LogModule)i)) + " ";
+  }
+  text += "\ndropped " + String(logDropped()) + "\n\n" + logTail();
+  server.send(200, "text/plain", text);
+}
 
-    // Check if reading light is on - if so, fill entire screen
-    if (readingLightOn) {
-      u8g2.setDrawColor(1);
-      u8g2.drawBox(0, 0, screenWidth, screenHeight); // Fill entire screen
-      u8g2.sendBuffer();
-      return; // Exit early, don't draw eyes
+// Behaviour trace for tools/trace_replay.cpp: a TraceHeader, then the
+// records oldest first
+void handleTrace() {
+  TraceHeader header = trace.header();
+  server.setContentLength(sizeof(header) + header.count * sizeof(TraceRecord));
+  server.send(200, "application/octet-stream", "");
+  server.sendContent((const char*)&header, sizeof(header));
+  TraceRecord chunk[32];
+  for (size_t sent = 0; sent < header.count;) {
+    size_t n = 0;
+    while (n < 32 && sent < header.count) {
+      chunk[n++] = trace.at(sent++);
     }
+    server.sendContent((const char*)chunk, n * sizeof(TraceRecord));
+  }
+}
 
-  // Calculate current eye openness based on blinking
-  float opennessFactor = 1.0;
-  if (isBlinking) {
-    if (blinkState == 1) {      // Half-closing
-      opennessFactor = 0.5;
-    } else if (blinkState == 2) { // Fully closed
-      opennessFactor = 0.1;
-    } else {                    // Half-opening
-      opennessFactor = 0.5;
+// The same trace over the BLE bulk pipe (tools/ble_trace.py), for when
+// there's no WiFi. The host writes "trace\n" to bulk RX and reads the /trace
+// body from bulk TX, a TX buffer at a time from loop(). The header is taken
+// when the request arrives and the records it counts go out as they were;
+// if one is overwritten before it's sent (a very slow link) the download
+// stops there, and the host sees fewer records than the header says.
+TraceHeader bleTraceHeader;
+uint32_t bleTraceFirst = 0;   // total() at the first record counted
+size_t bleTraceOffset = 0;    // bytes of the body sent so far
+bool bleTraceSending = false;
+
+// Up to max bytes of the body from offset; 0 at the end
+size_t bleTraceBytes(size_t offset, uint8_t* out, size_t max) {
+  size_t size = sizeof(TraceHeader) + bleTraceHeader.count * sizeof(TraceRecord);
+  size_t done = 0;
+  while (done < max && offset < size) {
+    const uint8_t* from;
+    size_t left;
+    if (offset < sizeof(TraceHeader)) {
+      from = (const uint8_t*)&bleTraceHeader + offset;
+      left = sizeof(TraceHeader) - offset;
+    } else {
+      size_t index = (offset - sizeof(TraceHeader)) / sizeof(TraceRecord);
+      size_t within = (offset - sizeof(TraceHeader)) % sizeof(TraceRecord);
+      uint32_t oldest = trace.total() - trace.count();
+      if (bleTraceFirst + index < oldest) {
+        break; // overwritten since the request
+      }
+      from = (const uint8_t*)&trace.at(bleTraceFirst + index - oldest) + within;
+      left = sizeof(TraceRecord) - within;
     }
+    size_t n = min(left, max - done);
+    memcpy(out + done, from, n);
+    done += n;
+    offset += n;
   }
+  return done;
+}
 
-  // Calculate actual eye dimensions including blink effect
-  float leftCurrentHeight = leftEyeHeight * opennessFactor;
-  float rightCurrentHeight = rightEyeHeight * opennessFactor;
-
-  // Draw filled eyes
-  u8g2.setDrawColor(1); // White fill
-
-  // Draw left eye using our custom fill function
-  drawFilledEllipse(
-    leftEyeX + leftOffsetX,
-    eyeY + leftOffsetY,
-    leftEyeWidth,
-    leftCurrentHeight,
-    leftAngle
-  );
-
-  // Draw right eye using our custom fill function
-  drawFilledEllipse(
-    rightEyeX + rightOffsetX,
-    eyeY + rightOffsetY,
-    rightEyeWidth,
-    rightCurrentHeight,
-    rightAngle
-  );
-
-  if (currentEyeState == STATE_HAPPY) {
-    u8g2.setDrawColor(1); // Ensure stars are white
-    unsigned long currentTime = millis(); // Get current time for twinkling
-
-    for (int i = 0; i < numActiveStars; i++) {
-      // Twinkling effect: vary the size of the star
-      // Using a sine wave for smooth oscillation
-      float twinkleAmplitude = 2.0; // How much the size changes (e.g., +/- 2 pixels)
-      float twinkleSpeed = 150.0;   // Controls speed of twinkle (smaller value = faster)
-      float twinkleOffset = sin((float)currentTime / twinkleSpeed + i * 0.5) * twinkleAmplitude;
-
-      // Ensure the size doesn't go below 1 or too small
-      int currentStarSize = max(1, happyStars[i].size + (int)twinkleOffset);
-
-      drawStar(happyStars[i].x, happyStars[i].y, currentStarSize);
+// Bulk RX, one request per line; anything else (the RX benchmark's
+// pattern) is ignored
+void onBulkRequest(const uint8_t* data, size_t len) {
+  static char line[16];
+  static size_t lineLen = 0;
+  for (size_t i = 0; i < len; i++) {
+    if (data[i] != '\n') {
+      if (lineLen < sizeof(line)) {
+        line[lineLen] = (char)data[i];
+      }
+      lineLen++;
+      continue;
+    }
+    if (lineLen == 5 && memcmp(line, "trace", 5) == 0) {
+      bleTraceHeader = trace.header();
+      bleTraceFirst = trace.total() - bleTraceHeader.count;
+      bleTraceOffset = 0;
+      bleTraceSending = true;
+      LOGI(LOG_BLE, "Sending trace over BLE, %u records", (unsigned)bleTraceHeader.count);
     }
+    lineLen = 0;
   }
-  u8g2.sendBuffer();
 }
 
-void drawFilledEllipse(int x0, int y0, int width, int height, float angle) {
-  int a = width / 2;
-  int b = height / 2;
+void bleTraceLoop() {
+  if (!bleTraceSending) {
+    return;
+  }
+  if (!bleBulkConnected()) {
+    bleTraceSending = false;
+    return;
+  }
+  uint8_t chunk[128];
+  size_t len;
+  while ((len = bleTraceBytes(bleTraceOffset, chunk, sizeof(chunk))) > 0) {
+    size_t sent = bleBulkSend(chunk, len);
+    bleTraceOffset += sent;
+    if (sent < len) {
+      return; // TX buffer full, or the host unsubscribed
+    }
+  }
+  bleTraceSending = false;
+}
 
-  for (int y = -b; y <= b; y++) {
-    float relY = (b > 1) ? (float)y / b : 0;
-    int halfWidth = a * sqrt(1.0 - relY * relY);
+// Shared I2C bus: utilization and worst-case sensor latency
+void handleBusStats() {
+  server.send(200, "text/plain", i2cBus.report());
+}
 
-    if (halfWidth > 0) {
-      if (angle == 0) {
-        u8g2.drawHLine(x0 - halfWidth, y0 + y, halfWidth * 2);
-      } else {
-        float sinA = sin(angle);
-        float cosA = cos(angle);
+// Called by the web server for every chunk of a multipart firmware upload.
+// Expects ?sha256=<hex digest of the final image> and optionally
+// &size=<image bytes> and &encoding=raw|zlib|delta on the URL.
+void handleUpdateUpload() {
+  HTTPUpload& upload = server.upload();
 
-        int x1 = x0 + (-halfWidth * cosA - y * sinA);
-        int y1 = y0 + (-halfWidth * sinA + y * cosA);
-        int x2 = x0 + (halfWidth * cosA - y * sinA);
-        int y2 = y0 + (halfWidth * sinA + y * cosA);
-        u8g2.drawLine(x1, y1, x2, y2);
-      }
+  if (upload.status == UPLOAD_FILE_START) {
+    size_t size = server.hasArg("size") ? server.arg("size").toInt() : 0;
+    LOGI(LOG_OTA, "HTTP update: %s (%u bytes, %s)", upload.filename.c_str(), size,
+         server.arg("encoding").c_str());
+    drawStatusScreen("Update", "Starting...");
+    httpUpdate.start(server.arg("encoding").c_str(), size, server.arg("sha256").c_str(), millis());
+    if (httpUpdate.status() != OTA_STREAM_OK) {
+      LOGE(LOG_OTA, "HTTP update rejected: %s", OtaStream::statusString(httpUpdate.status()));
+    }
+  } else if (upload.status == UPLOAD_FILE_WRITE) {
+    if (httpUpdate.write(upload.buf, upload.currentSize) && httpUpdate.size() > 0) {
+      drawUpdateProgress((httpUpdate.written() * 100) / httpUpdate.size());
     }
+  } else if (upload.status == UPLOAD_FILE_END) {
+    httpUpdate.end();
+    LOGI(LOG_OTA, "HTTP update finished: %u bytes on the wire, %u bytes written in %lu ms, %s",
+         httpUpdate.received(), httpUpdate.written(), millis() - httpUpdate.startTime(),
+         OtaStream::statusString(httpUpdate.status()));
+  } else if (upload.status == UPLOAD_FILE_ABORTED) {
+    // No done handler follows a dropped connection; give the face back here
+    httpUpdate.abort();
+    LOGW(LOG_OTA, "HTTP update aborted by client.");
   }
 }
+
+// Also the answer to a POST with no file in it: "No update in progress"
+void handleUpdateDone() {
+  OtaStreamStatus status = httpUpdate.status();
+  if (status == OTA_STREAM_OK) {
+    server.send(200, "text/plain", "Update OK (" + String(httpUpdate.received()) + " bytes received, " +
+                String(millis() - httpUpdate.startTime()) + " ms), rebooting");
+    drawStatusScreen("Update", "complete.", "Restarting.");
+    delay(1000);
+    logFlush();
+    ESP.restart();
+  } else {
+    server.send(400, "text/plain", String("Update failed: ") + OtaStream::statusString(status));
+    drawStatusScreen("OTA Error", OtaStream::statusString(status));
+    delay(2000);
+    httpUpdate.stop();
+  }
+}
+
+void drawUpdateProgress(unsigned int percentComplete) {
+  eyes.invalidate();
+  eyeProgressScreen(u8g2, percentComplete);
+}
+
+void drawStatusScreen(const String& line1, const String& line2, const String& line3) {
+  eyes.invalidate();
+  eyeStatusScreen(u8g2, line1, line2, line3);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+// Host stand-in for the parts of the Arduino core the eye engine and its
+// tools use, so src/ builds and runs off-device (see CMakeLists.txt).
+// Time doesn't pass on its own: millis() only moves when the test or
+// benchmark moves it (hostSetMillis(), hostAdvanceMillis(), delay()), so
+// every run is repeatable.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// The mock clock
+void hostSetMillis(unsigned long ms);
+void hostAdvanceMillis(unsigned long ms);
+
+// Arduino's random(): [0, max) and [min, max), from a fixed-seed PRNG
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+uint32_t esp_random();
+
+inline void pinMode(int, int) {}
+inline int digitalRead(int) { return HIGH; }
+inline void digitalWrite(int, int) {}
+inline int analogRead(int) { return 0; }
+
+// Enough of Arduino's String for the web handlers and status screens
+class String {
+public:
+  String(const char* s = "") : _s(s ? s : "") {}
+  String(const std::string& s) : _s(s) {}
+  String(char c) : _s(1, c) {}
+  String(int v) : _s(std::to_string(v)) {}
+  String(unsigned int v) : _s(std::to_string(v)) {}
+  String(long v) : _s(std::to_string(v)) {}
+  String(unsigned long v) : _s(std::to_string(v)) {}
+  String(double v, int decimals = 2) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    _s = buf;
+  }
+
+  const char* c_str() const { return _s.c_str(); }
+  size_t length() const { return _s.size(); }
+  void reserve(size_t size) { _s.reserve(size); }
+  long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(_s.c_str(), nullptr); }
+  int indexOf(char c) const {
+    size_t i = _s.find(c);
+    return i == std::string::npos ? -1 : (int)i;
+  }
+  String substring(int from, int to = -1) const {
+    return String(_s.substr(from, to < 0 ? std::string::npos : to - from));
+  }
+
+  String& operator+=(const String& s) { _s += s._s; return *this; }
+  String& operator+=(const char* s) { _s += s; return *this; }
+  String& operator+=(char c) { _s += c; return *this; }
+  String operator+(const String& s) const { return String(_s + s._s); }
+  String operator+(const char* s) const { return String(_s + s); }
+  bool operator==(const String& s) const { return _s == s._s; }
+  bool operator==(const char* s) const { return _s == s; }
+  bool operator!=(const String& s) const { return _s != s._s; }
+  bool operator!=(const char* s) const { return _s != s; }
+
+private:
+  std::string _s;
+};
+
+inline String operator+(const char* a, const String& b) { return String(a) + b; }
+
+// Serial goes to stdout
+class HardwareSerial {
+public:
+  void begin(long) {}
+  size_t write(const uint8_t* data, size_t size) { return fwrite(data, 1, size, stdout); }
+  void flush() { fflush(stdout); }
+  template <typename... Args>
+  void printf(const char* format, Args... args) { ::printf(format, args...); }
+  void print(const String& s) { fputs(s.c_str(), stdout); }
+  void println(const String& s = "") { puts(s.c_str()); }
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+  void restart() {}
+  uint32_t getFreeHeap() { return 0; }
+};
+
+extern EspClass ESP;
@@ -0,0 +1,29 @@
+#pragma once
+
+// Host stand-in for the ESP32 Preferences (NVS) store, kept in memory.
+// Every Preferences object shares the same store, as on the device, until
+// hostClearPreferences().
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false);
+  void end() {}
+  bool clear();
+
+  uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+  size_t putUInt(const char* key, uint32_t value);
+  int32_t getInt(const char* key, int32_t defaultValue = 0);
+  size_t putInt(const char* key, int32_t value);
+  size_t getBytes(const char* key, void* buffer, size_t size);
+  size_t putBytes(const char* key, const void* value, size_t size);
+
+private:
+  std::string path(const char* key) const { return _name + "/" + key; }
+
+  std::string _name;
+  bool _readOnly = false;
+};
+
+void hostClearPreferences();
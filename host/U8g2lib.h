@@ -0,0 +1,154 @@
+#pragma once
+
+// Host stand-in for U8g2, laid out like the real buffers: pages of 8 rows,
+// a byte per column, LSB at the top. Each display class below owns a
+// buffer like its U8g2 namesake: the whole panel for the _F_ classes, one
+// page for the _1_ ones, which draw a frame a page at a time between
+// firstPage() and nextPage(). Lines, boxes and frames match U8g2 pixel for
+// pixel, and are clipped to the page in the buffer; triangles are filled
+// per scanline between the edges, which can differ from U8g2's polygon
+// filler by a pixel at the tips. Text isn't drawn, but getStrWidth()
+// measures it with the font's advance so layouts still work.
+//
+// sendBuffer() only counts frames; the pixels stay readable with pixel(),
+// from the buffer, or for page-mode panels from a copy of what was sent.
+// setBusMicros() makes sending take real time, as long as the bus would,
+// for timing how sends overlap.
+
+#include <stdint.h>
+
+#define U8G2_R0 0
+#define U8X8_PIN_NONE 255
+
+// Fonts are just their advance width and height here
+extern const uint8_t u8g2_font_9x15_tf[];
+extern const uint8_t u8g2_font_6x10_tf[];
+
+class U8G2 {
+public:
+  void begin() {}
+  void setPowerSave(int) {}
+  void setBusClock(uint32_t) {}
+  void setI2CAddress(int) {}
+
+  int getDisplayWidth() const { return _width; }
+  int getDisplayHeight() const { return _height; }
+  uint8_t* getBufferPtr() { return _buffer; }
+  int getBufferTileWidth() const { return _width / 8; }
+  int getBufferTileHeight() const { return _bufferPages; }
+  int getBufferCurrTileRow() const { return _page; }
+
+  void clearBuffer();
+  void sendBuffer();
+  void updateDisplayArea(int x, int y, int width, int height);
+  void firstPage();
+  int nextPage();
+
+  // 0 clears, 1 sets, 2 inverts
+  void setDrawColor(int color) { _color = color; }
+  void setFont(const uint8_t* font) { _font = font; }
+  int getStrWidth(const char* text) const;
+  int drawStr(int, int, const char* text) { return getStrWidth(text); }
+
+  void drawPixel(int x, int y);
+  void drawHLine(int x, int y, int length);
+  void drawVLine(int x, int y, int length);
+  void drawLine(int x0, int y0, int x1, int y1);
+  void drawBox(int x, int y, int width, int height);
+  void drawFrame(int x, int y, int width, int height);
+  void drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2);
+
+  // Host only
+  bool pixel(int x, int y) const;
+  uint32_t frames() const { return _frames; }
+  uint32_t areas() const { return _areas; }
+  void setBusMicros(uint32_t frameMicros) { _busMicros = frameMicros; }
+
+protected:
+  // screen is null for a full buffer
+  U8G2(uint8_t* buffer, int width, int height, int bufferPages, uint8_t* screen);
+
+private:
+  void plot(int x, int y);
+  void wait(int pages) const;
+
+  uint8_t* _buffer;
+  int _width;
+  int _height;
+  int _bufferPages;
+  int _page;         // first page in the buffer
+  int _clipTop;      // rows in the buffer
+  int _clipBottom;
+  uint8_t* _screen;
+  int _color;
+  const uint8_t* _font;
+  uint32_t _frames;
+  uint32_t _areas;
+  uint32_t _busMicros;
+};
+
+// A panel's frame buffer, ahead of U8G2 so it exists before U8G2 clears it
+template <int Width, int Height>
+struct U8G2Buffer {
+  uint8_t pixels[Width * Height / 8];
+};
+
+template <int Width, int Height>
+class U8G2Panel : private U8G2Buffer<Width, Height>, public U8G2 {
+public:
+  static constexpr int WIDTH = Width;
+  static constexpr int HEIGHT = Height;
+
+protected:
+  U8G2Panel() : U8G2(U8G2Buffer<Width, Height>::pixels, Width, Height, Height / 8, nullptr) {}
+};
+
+// One page of buffer, and (host only) what the panel shows
+template <int Width, int Height>
+struct U8G2PageBuffer {
+  uint8_t pixels[Width];
+  uint8_t screen[Width * Height / 8];
+};
+
+template <int Width, int Height>
+class U8G2PagePanel : private U8G2PageBuffer<Width, Height>, public U8G2 {
+public:
+  static constexpr int WIDTH = Width;
+  static constexpr int HEIGHT = Height;
+
+protected:
+  U8G2PagePanel()
+      : U8G2(U8G2PageBuffer<Width, Height>::pixels, Width, Height, 1, U8G2PageBuffer<Width, Height>::screen) {}
+};
+
+// Hardware I2C: (rotation, reset, clock, data)
+#define U8G2_HOST_I2C(name, base, width, height)                                                   \
+  class name : public base<width, height> {                                                        \
+  public:                                                                                          \
+    name(int, int = U8X8_PIN_NONE, int = U8X8_PIN_NONE, int = U8X8_PIN_NONE) {}                    \
+  }
+
+// Hardware 4-wire SPI: (rotation, cs, dc, reset)
+#define U8G2_HOST_SPI(name, base, width, height)                                                   \
+  class name : public base<width, height> {                                                        \
+  public:                                                                                          \
+    name(int, int, int, int = U8X8_PIN_NONE) {}                                                    \
+  }
+
+U8G2_HOST_I2C(U8G2_SSD1306_128X64_NONAME_F_HW_I2C, U8G2Panel, 128, 64);
+U8G2_HOST_I2C(U8G2_SSD1306_128X64_NONAME_F_2ND_HW_I2C, U8G2Panel, 128, 64);
+U8G2_HOST_SPI(U8G2_SSD1306_128X64_NONAME_F_4W_HW_SPI, U8G2Panel, 128, 64);
+U8G2_HOST_I2C(U8G2_SH1106_128X64_NONAME_F_HW_I2C, U8G2Panel, 128, 64);
+U8G2_HOST_I2C(U8G2_SH1106_128X64_NONAME_F_2ND_HW_I2C, U8G2Panel, 128, 64);
+U8G2_HOST_SPI(U8G2_SH1106_128X64_NONAME_F_4W_HW_SPI, U8G2Panel, 128, 64);
+U8G2_HOST_I2C(U8G2_SH1107_128X128_F_HW_I2C, U8G2Panel, 128, 128);
+U8G2_HOST_SPI(U8G2_SH1107_128X128_F_4W_HW_SPI, U8G2Panel, 128, 128);
+
+U8G2_HOST_I2C(U8G2_SSD1306_128X64_NONAME_1_HW_I2C, U8G2PagePanel, 128, 64);
+U8G2_HOST_I2C(U8G2_SSD1306_128X64_NONAME_1_2ND_HW_I2C, U8G2PagePanel, 128, 64);
+U8G2_HOST_SPI(U8G2_SSD1306_128X64_NONAME_1_4W_HW_SPI, U8G2PagePanel, 128, 64);
+U8G2_HOST_I2C(U8G2_SH1106_128X64_NONAME_1_HW_I2C, U8G2PagePanel, 128, 64);
+U8G2_HOST_I2C(U8G2_SH1106_128X64_NONAME_1_2ND_HW_I2C, U8G2PagePanel, 128, 64);
+U8G2_HOST_SPI(U8G2_SH1106_128X64_NONAME_1_4W_HW_SPI, U8G2PagePanel, 128, 64);
+U8G2_HOST_I2C(U8G2_SH1107_128X128_1_HW_I2C, U8G2PagePanel, 128, 128);
+U8G2_HOST_SPI(U8G2_SH1107_128X128_1_4W_HW_SPI, U8G2PagePanel, 128, 128);
@@ -0,0 +1,70 @@
+#pragma once
+
+// Host stand-in for the ESP32 WebServer. Routes are registered as usual;
+// request() then dispatches a GET or POST straight to the handler, with the
+// query arguments given as "name=value&..." (no URL decoding), and the
+// response is kept for the caller to check.
+
+#include <Arduino.h>
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST };
+enum HTTPUploadStatus { UPLOAD_FILE_START, UPLOAD_FILE_WRITE, UPLOAD_FILE_END, UPLOAD_FILE_ABORTED };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+struct HTTPUpload {
+  HTTPUploadStatus status;
+  String filename;
+  size_t totalSize;
+  size_t currentSize;
+  uint8_t buf[1436];
+};
+
+class WebServer {
+public:
+  typedef std::function<void()> THandlerFunction;
+
+  explicit WebServer(int port = 80) { (void)port; }
+
+  void begin() {}
+  void handleClient() {}
+
+  void on(const char* uri, HTTPMethod method, THandlerFunction handler);
+  void on(const char* uri, HTTPMethod method, THandlerFunction handler, THandlerFunction upload);
+  void onNotFound(THandlerFunction handler) { _notFound = handler; }
+
+  bool hasArg(const char* name) const;
+  String arg(const char* name) const;
+
+  void send(int code, const char* contentType = "", const String& content = "");
+  void send_P(int code, const char* contentType, const char* content, size_t length);
+  void setContentLength(size_t) {}
+  void sendHeader(const char*, const String&, bool = false) {}
+  void sendContent(const String& content) { _body += content.c_str(); }
+  void sendContent(const char* content, size_t length) { _body.append(content, length); }
+  HTTPUpload& upload() { return _upload; }
+
+  // Host only: run the handler for uri, returns the status code (404 if
+  // nothing matched)
+  int request(HTTPMethod method, const char* uri, const char* query = "");
+  const std::string& body() const { return _body; }
+
+private:
+  struct Route {
+    std::string uri;
+    HTTPMethod method;
+    THandlerFunction handler;
+  };
+
+  std::vector<Route> _routes;
+  std::vector<std::pair<std::string, std::string> > _args;
+  THandlerFunction _notFound;
+  HTTPUpload _upload;
+  int _code = 0;
+  std::string _body;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+// Host stand-in for the mbedtls SHA-256 the ESP32 core ships, so
+// src/ota_stream.cpp hashes uploads the same way on the desktop. Only the
+// calls it makes; SHA-224 isn't supported.
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct mbedtls_sha256_context {
+  uint32_t state[8];
+  uint64_t total;        // bytes hashed so far
+  uint8_t buffer[64];    // partial block
+};
+
+void mbedtls_sha256_init(mbedtls_sha256_context* ctx);
+void mbedtls_sha256_free(mbedtls_sha256_context* ctx);
+int mbedtls_sha256_starts(mbedtls_sha256_context* ctx, int is224);
+int mbedtls_sha256_update(mbedtls_sha256_context* ctx, const unsigned char* input, size_t len);
+int mbedtls_sha256_finish(mbedtls_sha256_context* ctx, unsigned char output[32]);
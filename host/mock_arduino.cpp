@@ -0,0 +1,155 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <WebServer.h>
+
+#include <map>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static unsigned long hostMillis = 0;
+static uint64_t randomState = 1;
+
+unsigned long millis() { return hostMillis; }
+unsigned long micros() { return hostMillis * 1000UL; }
+void delay(unsigned long ms) { hostMillis += ms; }
+void delayMicroseconds(unsigned int) {}
+
+void hostSetMillis(unsigned long ms) { hostMillis = ms; }
+void hostAdvanceMillis(unsigned long ms) { hostMillis += ms; }
+
+// splitmix64; good enough for the odd random() outside PetRandom
+static uint32_t nextRandom() {
+  uint64_t z = (randomState += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+long random(long max) { return max > 0 ? (long)(nextRandom() % (uint32_t)max) : 0; }
+long random(long min, long max) { return max > min ? min + random(max - min) : min; }
+void randomSeed(unsigned long seed) { randomState = seed; }
+uint32_t esp_random() { return nextRandom(); }
+
+// Preferences
+
+static std::map<std::string, std::string> preferenceStore;
+
+void hostClearPreferences() { preferenceStore.clear(); }
+
+bool Preferences::begin(const char* name, bool readOnly) {
+  _name = name;
+  _readOnly = readOnly;
+  return true;
+}
+
+bool Preferences::clear() {
+  if (_readOnly) {
+    return false;
+  }
+  std::string prefix = _name + "/";
+  for (auto i = preferenceStore.begin(); i != preferenceStore.end();) {
+    i = i->first.compare(0, prefix.size(), prefix) == 0 ? preferenceStore.erase(i) : std::next(i);
+  }
+  return true;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t size) {
+  auto i = preferenceStore.find(path(key));
+  if (i == preferenceStore.end() || i->second.size() > size) {
+    return 0;
+  }
+  memcpy(buffer, i->second.data(), i->second.size());
+  return i->second.size();
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t size) {
+  if (_readOnly) {
+    return 0;
+  }
+  preferenceStore[path(key)].assign((const char*)value, size);
+  return size;
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+  uint32_t value;
+  return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+}
+
+size_t Preferences::putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) {
+  int32_t value;
+  return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+
+// WebServer
+
+void WebServer::on(const char* uri, HTTPMethod method, THandlerFunction handler) {
+  Route route = {uri, method, handler};
+  _routes.push_back(route);
+}
+
+void WebServer::on(const char* uri, HTTPMethod method, THandlerFunction handler, THandlerFunction) {
+  on(uri, method, handler);
+}
+
+bool WebServer::hasArg(const char* name) const {
+  for (const auto& a : _args) {
+    if (a.first == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+String WebServer::arg(const char* name) const {
+  for (const auto& a : _args) {
+    if (a.first == name) {
+      return String(a.second);
+    }
+  }
+  return String();
+}
+
+void WebServer::send(int code, const char*, const String& content) {
+  _code = code;
+  _body = content.c_str();
+}
+
+void WebServer::send_P(int code, const char*, const char* content, size_t length) {
+  _code = code;
+  _body.assign(content, length);
+}
+
+int WebServer::request(HTTPMethod method, const char* uri, const char* query) {
+  _args.clear();
+  for (const char* p = query; *p;) {
+    const char* end = strchr(p, '&');
+    if (!end) {
+      end = p + strlen(p);
+    }
+    const char* eq = (const char*)memchr(p, '=', end - p);
+    if (eq) {
+      _args.emplace_back(std::string(p, eq), std::string(eq + 1, end));
+    } else if (end > p) {
+      _args.emplace_back(std::string(p, end), std::string());
+    }
+    p = *end ? end + 1 : end;
+  }
+
+  _code = 404;
+  _body.clear();
+  for (const Route& route : _routes) {
+    if (route.uri == uri && (route.method == HTTP_ANY || route.method == method)) {
+      route.handler();
+      return _code;
+    }
+  }
+  if (_notFound) {
+    _notFound();
+  }
+  return _code;
+}
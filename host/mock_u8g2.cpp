@@ -0,0 +1,208 @@
+#include <U8g2lib.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+const uint8_t u8g2_font_9x15_tf[] = {9, 15};
+const uint8_t u8g2_font_6x10_tf[] = {6, 10};
+
+U8G2::U8G2(uint8_t* buffer, int width, int height, int bufferPages, uint8_t* screen)
+    : _buffer(buffer), _width(width), _height(height), _bufferPages(bufferPages), _page(0), _clipTop(0),
+      _clipBottom(bufferPages * 8), _screen(screen), _color(1), _font(u8g2_font_6x10_tf), _frames(0), _areas(0),
+      _busMicros(0) {
+  clearBuffer();
+  if (_screen) {
+    memset(_screen, 0, _width * _height / 8);
+  }
+}
+
+void U8G2::clearBuffer() { memset(_buffer, 0, _width * _bufferPages); }
+
+void U8G2::wait(int pages) const {
+  if (_busMicros) {
+    std::this_thread::sleep_for(std::chrono::microseconds((uint64_t)_busMicros * pages * 8 / _height));
+  }
+}
+
+void U8G2::sendBuffer() {
+  if (_screen) {
+    memcpy(_screen + _page * _width, _buffer, _width * _bufferPages);
+  }
+  _frames++;
+  wait(_bufferPages);
+}
+
+void U8G2::updateDisplayArea(int, int, int width, int height) {
+  _areas++;
+  if (_busMicros) {
+    int tiles = (_width / 8) * (_height / 8);
+    std::this_thread::sleep_for(std::chrono::microseconds((uint64_t)_busMicros * width * height / tiles));
+  }
+}
+
+void U8G2::firstPage() {
+  _page = 0;
+  _clipTop = 0;
+  _clipBottom = _bufferPages * 8;
+  clearBuffer();
+}
+
+int U8G2::nextPage() {
+  if (_screen) {
+    memcpy(_screen + _page * _width, _buffer, _width * _bufferPages);
+  }
+  wait(_bufferPages);
+  _page += _bufferPages;
+  if (_page >= _height / 8) {
+    _frames++;
+    _page = 0;
+    _clipTop = 0;
+    _clipBottom = _bufferPages * 8;
+    return 0;
+  }
+  _clipTop = _page * 8;
+  _clipBottom = std::min(_clipTop + _bufferPages * 8, _height);
+  clearBuffer();
+  return 1;
+}
+
+int U8G2::getStrWidth(const char* text) const { return (int)strlen(text) * _font[0]; }
+
+void U8G2::plot(int x, int y) {
+  uint8_t& cell = _buffer[((y >> 3) - _page) * _width + x];
+  uint8_t bit = 1 << (y & 7);
+  if (_color == 0) {
+    cell &= ~bit;
+  } else if (_color == 1) {
+    cell |= bit;
+  } else {
+    cell ^= bit;
+  }
+}
+
+bool U8G2::pixel(int x, int y) const {
+  if (x < 0 || x >= _width || y < 0 || y >= _height) {
+    return false;
+  }
+  const uint8_t* pixels = _screen ? _screen : _buffer;
+  return pixels[(y >> 3) * _width + x] & (1 << (y & 7));
+}
+
+void U8G2::drawPixel(int x, int y) {
+  if (x >= 0 && x < _width && y >= _clipTop && y < _clipBottom) {
+    plot(x, y);
+  }
+}
+
+void U8G2::drawHLine(int x, int y, int length) {
+  if (y < _clipTop || y >= _clipBottom) {
+    return;
+  }
+  int end = std::min(x + length, _width);
+  for (int i = std::max(x, 0); i < end; i++) {
+    plot(i, y);
+  }
+}
+
+void U8G2::drawVLine(int x, int y, int length) {
+  if (x < 0 || x >= _width) {
+    return;
+  }
+  int end = std::min(y + length, _clipBottom);
+  for (int i = std::max(y, _clipTop); i < end; i++) {
+    plot(x, i);
+  }
+}
+
+// Bresenham, both ends included, stepping along the longer axis (as
+// u8g2_DrawLine does)
+void U8G2::drawLine(int x0, int y0, int x1, int y1) {
+  int dx = abs(x1 - x0);
+  int dy = abs(y1 - y0);
+  bool steep = dy > dx;
+  if (steep) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+    std::swap(dx, dy);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+  int err = dx >> 1;
+  int step = y1 > y0 ? 1 : -1;
+  int y = y0;
+  for (int x = x0; x <= x1; x++) {
+    if (steep) {
+      drawPixel(y, x);
+    } else {
+      drawPixel(x, y);
+    }
+    err -= dy;
+    if (err < 0) {
+      y += step;
+      err += dx;
+    }
+  }
+}
+
+void U8G2::drawBox(int x, int y, int width, int height) {
+  for (int row = 0; row < height; row++) {
+    drawHLine(x, y + row, width);
+  }
+}
+
+void U8G2::drawFrame(int x, int y, int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  drawHLine(x, y, width);
+  if (height > 1) {
+    drawHLine(x, y + height - 1, width);
+  }
+  if (height > 2) {
+    drawVLine(x, y + 1, height - 2);
+    drawVLine(x + width - 1, y + 1, height - 2);
+  }
+}
+
+// Where the edge a-b crosses row y, rounded to the nearest pixel; widens
+// [left, right] to include it
+static void edgeSpan(int xa, int ya, int xb, int yb, int y, int& left, int& right) {
+  if (y < std::min(ya, yb) || y > std::max(ya, yb)) {
+    return;
+  }
+  if (ya == yb) {
+    left = std::min(left, std::min(xa, xb));
+    right = std::max(right, std::max(xa, xb));
+    return;
+  }
+  int num = (y - ya) * (xb - xa);
+  int den = yb - ya;
+  if (den < 0) {
+    num = -num;
+    den = -den;
+  }
+  int x = xa + (num >= 0 ? (num + den / 2) / den : -((-num + den / 2) / den));
+  left = std::min(left, x);
+  right = std::max(right, x);
+}
+
+void U8G2::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2) {
+  int top = std::max(std::min(y0, std::min(y1, y2)), _clipTop);
+  int bottom = std::min(std::max(y0, std::max(y1, y2)), _clipBottom - 1);
+  for (int y = top; y <= bottom; y++) {
+    int left = _width * 4;
+    int right = -_width * 4;
+    edgeSpan(x0, y0, x1, y1, y, left, right);
+    edgeSpan(x1, y1, x2, y2, y, left, right);
+    edgeSpan(x2, y2, x0, y0, y, left, right);
+    if (left <= right) {
+      drawHLine(left, y, right - left + 1);
+    }
+  }
+}
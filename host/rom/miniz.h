@@ -0,0 +1,102 @@
+#pragma once
+
+// Host stand-in for the tinfl inflater in the ESP32's ROM (miniz), so
+// src/ota_decode.cpp decodes uploads the same way on the desktop. Only the
+// calls it makes, over the system zlib. As on the device the output buffer
+// is the whole history: the window is sized from it on the first call, and
+// a stream that needs more fails.
+//
+// zlib's state is carved out of the decompressor itself, so a
+// tinfl_decompressor from malloc() is freed with free(), as with miniz.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zlib.h>
+
+typedef uint8_t mz_uint8;
+typedef uint32_t mz_uint32;
+
+enum {
+  TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+  TINFL_FLAG_HAS_MORE_INPUT = 2,
+  TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+  TINFL_FLAG_COMPUTE_ADLER32 = 8
+};
+
+typedef enum {
+  TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS = -4,
+  TINFL_STATUS_BAD_PARAM = -3,
+  TINFL_STATUS_ADLER32_MISMATCH = -2,
+  TINFL_STATUS_FAILED = -1,
+  TINFL_STATUS_DONE = 0,
+  TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+  TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+struct tinfl_decompressor {
+  z_stream stream;
+  bool started;
+  size_t used;                  // of arena
+  alignas(16) uint8_t arena[48 * 1024]; // inflate state and window
+};
+
+inline void tinfl_init(tinfl_decompressor* r) {
+  r->started = false;
+  r->used = 0;
+}
+
+inline voidpf tinflHostAlloc(voidpf opaque, uInt items, uInt size) {
+  tinfl_decompressor* r = (tinfl_decompressor*)opaque;
+  size_t bytes = ((size_t)items * size + 15) & ~(size_t)15;
+  if (bytes > sizeof(r->arena) - r->used) {
+    return Z_NULL;
+  }
+  voidpf p = r->arena + r->used;
+  r->used += bytes;
+  return p;
+}
+
+inline void tinflHostFree(voidpf, voidpf) {}
+
+inline tinfl_status tinfl_decompress(tinfl_decompressor* r, const mz_uint8* pIn_buf_next, size_t* pIn_buf_size,
+                                     mz_uint8* pOut_buf_start, mz_uint8* pOut_buf_next, size_t* pOut_buf_size,
+                                     const mz_uint32 decomp_flags) {
+  if (!r->started) {
+    // Power of two output buffer, as tinfl needs when it wraps
+    size_t window = (size_t)(pOut_buf_next - pOut_buf_start) + *pOut_buf_size;
+    int bits = 8;
+    while (bits < 15 && ((size_t)1 << bits) < window) {
+      bits++;
+    }
+    r->stream = z_stream();
+    r->stream.zalloc = tinflHostAlloc;
+    r->stream.zfree = tinflHostFree;
+    r->stream.opaque = r;
+    int windowBits = (decomp_flags & TINFL_FLAG_PARSE_ZLIB_HEADER) ? bits : -bits;
+    if (inflateInit2(&r->stream, windowBits) != Z_OK) {
+      return TINFL_STATUS_BAD_PARAM;
+    }
+    r->started = true;
+  }
+
+  r->stream.next_in = (Bytef*)pIn_buf_next;
+  r->stream.avail_in = (uInt)*pIn_buf_size;
+  r->stream.next_out = pOut_buf_next;
+  r->stream.avail_out = (uInt)*pOut_buf_size;
+  int result = inflate(&r->stream, Z_NO_FLUSH);
+  *pIn_buf_size -= r->stream.avail_in;
+  *pOut_buf_size -= r->stream.avail_out;
+
+  if (result == Z_STREAM_END) {
+    return TINFL_STATUS_DONE;
+  }
+  if (result != Z_OK && result != Z_BUF_ERROR) {
+    return TINFL_STATUS_FAILED;
+  }
+  if (r->stream.avail_out == 0) {
+    return TINFL_STATUS_HAS_MORE_OUTPUT;
+  }
+  return (decomp_flags & TINFL_FLAG_HAS_MORE_INPUT) ? TINFL_STATUS_NEEDS_MORE_INPUT
+                                                     : TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS;
+}
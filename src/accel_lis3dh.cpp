@@ -0,0 +1,92 @@
+#include "accel_lis3dh.h"
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// Register map (ST LIS3DH datasheet)
+static const uint8_t REG_WHO_AM_I = 0x0F;
+static const uint8_t REG_CTRL1 = 0x20;
+static const uint8_t REG_CTRL4 = 0x23;
+static const uint8_t REG_CTRL5 = 0x24;
+static const uint8_t REG_OUT_X_L = 0x28;
+static const uint8_t REG_FIFO_CTRL = 0x2E;
+static const uint8_t REG_FIFO_SRC = 0x2F;
+static const uint8_t AUTO_INCREMENT = 0x80;
+static const uint8_t WHO_AM_I_VALUE = 0x33;
+
+bool Lis3dhSource::writeRegister(uint8_t reg, uint8_t value) {
+  Wire.beginTransmission(_address);
+  Wire.write(reg);
+  Wire.write(value);
+  return Wire.endTransmission() == 0;
+}
+
+uint8_t Lis3dhSource::readRegister(uint8_t reg) {
+  Wire.beginTransmission(_address);
+  Wire.write(reg);
+  Wire.endTransmission(false);
+  Wire.requestFrom(_address, (uint8_t)1);
+  return Wire.available() ? Wire.read() : 0;
+}
+
+bool Lis3dhSource::begin() {
+  _present = readRegister(REG_WHO_AM_I) == WHO_AM_I_VALUE;
+  if (!_present) {
+    return false;
+  }
+  writeRegister(REG_CTRL1, 0x47);     // 50 Hz, normal mode, X/Y/Z enabled
+  writeRegister(REG_CTRL4, 0x98);     // block data update, +/-4 g, high resolution
+  writeRegister(REG_CTRL5, 0x40);     // FIFO enable
+  writeRegister(REG_FIFO_CTRL, 0x80); // stream mode
+  return true;
+}
+
+void Lis3dhSource::powerDown() {
+  if (_present) {
+    writeRegister(REG_CTRL1, 0x00); // ODR 0: power-down mode
+  }
+}
+
+size_t Lis3dhSource::read(AccelSample* out, size_t max) {
+  if (!_present) {
+    return 0;
+  }
+  size_t count = readRegister(REG_FIFO_SRC) & 0x1F;
+  if (count > max) {
+    count = max;
+  }
+
+  // Burst-read in slices the Wire buffer can hold (6 bytes per sample).
+  // A short read (bus error, NACK) ends the burst, and only the samples
+  // that actually arrived are returned.
+  size_t done = 0;
+  while (done < count) {
+    size_t slice = count - done;
+    if (slice > 20) {
+      slice = 20;
+    }
+    Wire.beginTransmission(_address);
+    Wire.write(REG_OUT_X_L | AUTO_INCREMENT);
+    Wire.endTransmission(false);
+    Wire.requestFrom(_address, (uint8_t)(slice * 6));
+    size_t decoded = 0;
+    while (decoded < slice && Wire.available() >= 6) {
+      int16_t raw[3];
+      for (int axis = 0; axis < 3; axis++) {
+        uint8_t lo = Wire.read();
+        uint8_t hi = Wire.read();
+        raw[axis] = (int16_t)((hi << 8) | lo);
+      }
+      // 12-bit left-justified, 2 mg/digit at +/-4 g
+      out[done].x = (raw[0] >> 4) * 2;
+      out[done].y = (raw[1] >> 4) * 2;
+      out[done].z = (raw[2] >> 4) * 2;
+      done++;
+      decoded++;
+    }
+    if (decoded < slice) {
+      break;
+    }
+  }
+  return done;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "pedometer.h"
+
+// LIS3DH on the shared I2C bus, sampling at 50 Hz into its 32-sample FIFO
+// (stream mode). read() empties the FIFO in one burst, so the bus is only
+// touched a few times a second instead of once per sample.
+
+const uint8_t LIS3DH_ADDRESS = 0x18; // SDO/SA0 low; 0x19 if tied high
+
+class Lis3dhSource : public AccelSource {
+public:
+  explicit Lis3dhSource(uint8_t address = LIS3DH_ADDRESS) : _address(address), _present(false) {}
+
+  bool begin();
+  bool present() const { return _present; }
+  size_t read(AccelSample* out, size_t max) override;
+  // Stop sampling (about 0.5 uA) until the next begin()
+  void powerDown();
+
+private:
+  bool writeRegister(uint8_t reg, uint8_t value);
+  uint8_t readRegister(uint8_t reg);
+
+  uint8_t _address;
+  bool _present;
+};
@@ -0,0 +1,358 @@
+#include "ble_bulk.h"
+#include "log.h"
+
+#include <Arduino.h>
+#include <BLEDevice.h>
+#include <BLEServer.h>
+#include <BLE2902.h>
+
+#define BULK_RX_CHAR_UUID    "beb54840-36e1-4688-b7f5-ea07361b26a8"
+#define BULK_TX_CHAR_UUID    "beb54841-36e1-4688-b7f5-ea07361b26a8"
+#define BULK_CTRL_CHAR_UUID  "beb54842-36e1-4688-b7f5-ea07361b26a8"
+
+// Single-producer/single-consumer byte ring. RX is filled on the Bluedroid
+// task and drained in loop(); TX is filled and drained in loop().
+template <size_t N>
+struct ByteRing {
+    uint8_t data[N];
+    volatile size_t head = 0; // written by producer
+    volatile size_t tail = 0; // written by consumer
+
+    size_t used() const { return head - tail; }
+    size_t space() const { return N - used(); }
+
+    size_t push(const uint8_t* src, size_t len) {
+        if (len > space()) len = space();
+        for (size_t i = 0; i < len; i++) {
+            data[(head + i) % N] = src[i];
+        }
+        head += len;
+        return len;
+    }
+
+    size_t pop(uint8_t* dst, size_t len) {
+        if (len > used()) len = used();
+        for (size_t i = 0; i < len; i++) {
+            dst[i] = data[(tail + i) % N];
+        }
+        tail += len;
+        return len;
+    }
+};
+
+struct BulkControl {
+    uint8_t opcode;
+    uint32_t arg;
+};
+
+static ByteRing<BLE_BULK_RX_BUFFER> rxRing;
+static ByteRing<BLE_BULK_TX_BUFFER> txRing;
+static QueueHandle_t controlQueue = nullptr;
+
+static BLEServer* bulkServer = nullptr;
+static BLECharacteristic* txCharacteristic = nullptr;
+static BLECharacteristic* ctrlCharacteristic = nullptr;
+static BLE2902* txSubscription = nullptr;
+static BLE2902* ctrlSubscription = nullptr;
+static BleBulkReceiver receiver = nullptr;
+
+// Link state, updated from the GATTS event handler
+static volatile bool connected = false;
+static volatile bool congested = false;
+static volatile uint16_t mtu = 23;
+static esp_bd_addr_t peerAddress;
+
+// Flow control: packets granted to the host vs. packets it has sent
+static uint32_t packetsGranted = 0;
+static volatile uint32_t packetsReceived = 0;
+static volatile uint32_t rxOverflows = 0;
+
+static bool fastLink = false;
+static volatile unsigned long lastTrafficTime = 0;
+static unsigned long txPendingSince = 0;
+
+// Benchmarks
+static uint32_t txBenchRemaining = 0;
+static uint32_t txBenchBytes = 0;
+static unsigned long txBenchStart = 0;
+static bool txBenchRunning = false;
+static volatile uint32_t rxBenchBytes = 0;
+static volatile unsigned long rxBenchStart = 0;
+static volatile unsigned long rxBenchLast = 0;
+
+static void putLE32(uint8_t* p, uint32_t v) {
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static void gattsEventHandler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if,
+                              esp_ble_gatts_cb_param_t* param) {
+    switch (event) {
+        case ESP_GATTS_CONNECT_EVT:
+            memcpy(peerAddress, param->connect.remote_bda, sizeof(esp_bd_addr_t));
+            mtu = 23;
+            congested = false;
+            packetsReceived = 0;
+            packetsGranted = 0;
+            fastLink = true; // so the first loop asks for the idle interval
+            connected = true;
+            break;
+        case ESP_GATTS_DISCONNECT_EVT:
+            connected = false;
+            break;
+        case ESP_GATTS_MTU_EVT:
+            mtu = param->mtu.mtu;
+            break;
+        case ESP_GATTS_CONGEST_EVT:
+            congested = param->congest.congested;
+            break;
+        default:
+            break;
+    }
+}
+
+class BulkRxCallbacks : public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pCharacteristic) {
+        std::string value = pCharacteristic->getValue();
+        size_t len = value.length();
+        unsigned long now = millis();
+
+        if (rxRing.push((const uint8_t*)value.data(), len) != len) {
+            rxOverflows++; // host ignored its credits
+        }
+        packetsReceived++;
+        if (rxBenchStart == 0) {
+            rxBenchStart = now;
+        }
+        rxBenchBytes += len;
+        rxBenchLast = now;
+        lastTrafficTime = now;
+    }
+};
+
+class BulkControlCallbacks : public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pCharacteristic) {
+        std::string value = pCharacteristic->getValue();
+        if (value.length() == 0) {
+            return;
+        }
+        BulkControl control;
+        control.opcode = (uint8_t)value[0];
+        control.arg = 0;
+        for (size_t i = 1; i < value.length() && i <= 4; i++) {
+            control.arg |= (uint32_t)(uint8_t)value[i] << (8 * (i - 1));
+        }
+        xQueueSend(controlQueue, &control, 0);
+    }
+};
+
+static void notifyControl(const uint8_t* data, size_t len) {
+    ctrlCharacteristic->setValue((uint8_t*)data, len);
+    ctrlCharacteristic->notify();
+}
+
+static void setLinkSpeed(bool fast) {
+    if (fast == fastLink) {
+        return;
+    }
+    fastLink = fast;
+    if (fast) {
+        bulkServer->updateConnParams(peerAddress, BLE_FAST_MIN_INTERVAL, BLE_FAST_MAX_INTERVAL,
+                                     BLE_FAST_LATENCY, BLE_FAST_TIMEOUT);
+    } else {
+        bulkServer->updateConnParams(peerAddress, BLE_IDLE_MIN_INTERVAL, BLE_IDLE_MAX_INTERVAL,
+                                     BLE_IDLE_LATENCY, BLE_IDLE_TIMEOUT);
+    }
+}
+
+static void runControl(const BulkControl& control, unsigned long currentTime) {
+    uint8_t event[9];
+    switch (control.opcode) {
+        case BLE_BULK_CTRL_TX_BENCH:
+            txBenchRemaining = control.arg;
+            txBenchBytes = control.arg;
+            txBenchStart = currentTime;
+            txBenchRunning = true;
+            lastTrafficTime = currentTime;
+            break;
+        case BLE_BULK_CTRL_RX_BENCH:
+            rxBenchBytes = 0;
+            rxBenchStart = 0;
+            rxBenchLast = 0;
+            break;
+        case BLE_BULK_CTRL_RX_REPORT:
+            event[0] = BLE_BULK_EVT_RX_REPORT;
+            putLE32(event + 1, rxBenchBytes);
+            putLE32(event + 5, rxBenchLast - rxBenchStart);
+            notifyControl(event, 9);
+            LOGI(LOG_BLE, "BLE bulk RX: %u bytes, %u overflows", rxBenchBytes, rxOverflows);
+            break;
+    }
+}
+
+// Grant the host as many packets as the RX buffer can hold in the worst
+// case (every packet full-size at the largest MTU we accept).
+static void grantCredits() {
+    if (!ctrlSubscription->getNotifications()) {
+        // Host can't hear grants yet; start counting once it subscribes
+        packetsGranted = packetsReceived;
+        return;
+    }
+    const uint32_t maxPacket = BLE_BULK_MTU - 3;
+    uint32_t outstanding = packetsGranted - packetsReceived;
+    uint32_t capacity = rxRing.space() / maxPacket;
+    if (capacity <= outstanding) {
+        return;
+    }
+    uint32_t grant = capacity - outstanding;
+    // Batch small grants; always grant when the host has nothing left
+    if (outstanding > 0 && grant < capacity / 2) {
+        return;
+    }
+    uint8_t event[3] = { BLE_BULK_EVT_CREDITS, (uint8_t)grant, (uint8_t)(grant >> 8) };
+    notifyControl(event, 3);
+    packetsGranted += grant;
+}
+
+static void flushTx(unsigned long currentTime) {
+    size_t payload = bleBulkPayloadSize();
+    uint8_t packet[BLE_BULK_MTU - 3];
+
+    for (int sent = 0; sent < BLE_BULK_MAX_NOTIFY_PER_LOOP && !congested; sent++) {
+        size_t pending = txRing.used();
+        if (pending == 0) {
+            txPendingSince = 0;
+            return;
+        }
+        if (txPendingSince == 0) {
+            txPendingSince = currentTime;
+        }
+        // Hold back a partial packet briefly so small sends get batched
+        if (pending < payload && currentTime - txPendingSince < BLE_BULK_FLUSH_MS) {
+            return;
+        }
+        size_t len = txRing.pop(packet, payload);
+        txCharacteristic->setValue(packet, len);
+        txCharacteristic->notify();
+        txPendingSince = txRing.used() > 0 ? currentTime : 0;
+        lastTrafficTime = currentTime;
+    }
+}
+
+static void runTxBench(unsigned long currentTime) {
+    uint8_t pattern[64];
+    while (txBenchRemaining > 0 && txRing.space() > 0) {
+        size_t chunk = min((size_t)txBenchRemaining, sizeof(pattern));
+        uint32_t offset = txBenchBytes - txBenchRemaining;
+        for (size_t i = 0; i < chunk; i++) {
+            pattern[i] = (uint8_t)(offset + i);
+        }
+        size_t queued = txRing.push(pattern, chunk);
+        txBenchRemaining -= queued;
+        if (queued < chunk) {
+            break;
+        }
+    }
+    if (txBenchRemaining == 0 && txRing.used() == 0) {
+        uint32_t elapsed = currentTime - txBenchStart;
+        uint8_t event[9];
+        event[0] = BLE_BULK_EVT_TX_DONE;
+        putLE32(event + 1, txBenchBytes);
+        putLE32(event + 5, elapsed);
+        notifyControl(event, 9);
+        txBenchRunning = false;
+        LOGI(LOG_BLE, "BLE bulk TX: %u bytes in %u ms (%.1f KB/s, MTU %u)",
+             txBenchBytes, elapsed, elapsed ? txBenchBytes / 1.024 / elapsed : 0.0, mtu);
+    }
+}
+
+void setupBleBulk(BLEServer* server, BLEService* service) {
+    bulkServer = server;
+    controlQueue = xQueueCreate(4, sizeof(BulkControl));
+    BLEDevice::setMTU(BLE_BULK_MTU);
+    BLEDevice::setCustomGattsHandler(gattsEventHandler);
+
+    BLECharacteristic *pRx = service->createCharacteristic(
+                                 BULK_RX_CHAR_UUID,
+                                 BLECharacteristic::PROPERTY_WRITE_NR
+                             );
+    pRx->setCallbacks(new BulkRxCallbacks());
+
+    txCharacteristic = service->createCharacteristic(
+                           BULK_TX_CHAR_UUID,
+                           BLECharacteristic::PROPERTY_NOTIFY
+                       );
+    txSubscription = new BLE2902();
+    txCharacteristic->addDescriptor(txSubscription);
+
+    ctrlCharacteristic = service->createCharacteristic(
+                             BULK_CTRL_CHAR_UUID,
+                             BLECharacteristic::PROPERTY_WRITE |
+                             BLECharacteristic::PROPERTY_NOTIFY
+                         );
+    ctrlSubscription = new BLE2902();
+    ctrlCharacteristic->addDescriptor(ctrlSubscription);
+    ctrlCharacteristic->setCallbacks(new BulkControlCallbacks());
+}
+
+void bleBulkSetReceiver(BleBulkReceiver newReceiver) {
+    receiver = newReceiver;
+}
+
+size_t bleBulkSend(const uint8_t* data, size_t len) {
+    if (!connected || !txSubscription->getNotifications()) {
+        return 0;
+    }
+    return txRing.push(data, len);
+}
+
+void bleBulkNoteTraffic() {
+    lastTrafficTime = millis();
+}
+
+bool bleBulkConnected() {
+    return connected;
+}
+
+uint16_t bleBulkPayloadSize() {
+    return mtu - 3;
+}
+
+void bleBulkLoop(unsigned long currentTime) {
+    if (bulkServer == nullptr) {
+        return;
+    }
+    if (!connected) {
+        // Drop anything left over from the previous connection
+        rxRing.tail = rxRing.head;
+        txRing.tail = txRing.head;
+        txBenchRemaining = 0;
+        txBenchRunning = false;
+        return;
+    }
+
+    BulkControl control;
+    while (xQueueReceive(controlQueue, &control, 0) == pdTRUE) {
+        runControl(control, currentTime);
+    }
+
+    // Hand received data to the application in whatever sized pieces the
+    // ring yields; without a receiver (e.g. RX benchmark) it is discarded.
+    uint8_t chunk[128];
+    size_t len;
+    while ((len = rxRing.pop(chunk, sizeof(chunk))) > 0) {
+        if (receiver != nullptr) {
+            receiver(chunk, len);
+        }
+    }
+    grantCredits();
+
+    if (txBenchRunning) {
+        runTxBench(currentTime);
+    }
+    flushTx(currentTime);
+
+    // Signed: the BLE task may have stamped a time later than currentTime
+    bool busy = txRing.used() > 0 || txBenchRunning ||
+                (long)(currentTime - lastTrafficTime) < (long)BLE_BULK_IDLE_MS;
+    setLinkSpeed(busy);
+}
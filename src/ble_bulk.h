@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class BLEServer;
+class BLEService;
+
+/*
+  High-throughput byte pipe over BLE, for logs, traces and framebuffers.
+  Lives in the pet GATT service next to the command/state characteristics.
+  Hungry.cpp serves its behaviour trace over it (tools/ble_trace.py).
+
+  Bulk RX (WRITE_NR): beb54840-36e1-4688-b7f5-ea07361b26a8
+    Host -> device data. The host may only send as many packets as it has
+    been granted credits for; the device grants more as loop() drains them.
+  Bulk TX (NOTIFY):   beb54841-36e1-4688-b7f5-ea07361b26a8
+    Device -> host data. bleBulkSend() calls are coalesced into packets of
+    up to MTU-3 bytes rather than one notification per call.
+  Control (WRITE, NOTIFY): beb54842-36e1-4688-b7f5-ea07361b26a8
+    host -> device: [BLE_BULK_CTRL_TX_BENCH, u32 bytes]  stream a test pattern
+                    [BLE_BULK_CTRL_RX_BENCH]             reset RX counters
+                    [BLE_BULK_CTRL_RX_REPORT]            report RX counters
+    device -> host: [BLE_BULK_EVT_CREDITS, u16 packets]
+                    [BLE_BULK_EVT_TX_DONE, u32 bytes, u32 ms]
+                    [BLE_BULK_EVT_RX_REPORT, u32 bytes, u32 ms]
+  All multi-byte values are little endian.
+
+  While bulk data (or anything reported with bleBulkNoteTraffic()) is
+  moving the link is switched to a short connection interval; after
+  BLE_BULK_IDLE_MS without traffic it drops back to a long, low-power one.
+*/
+
+const uint16_t BLE_BULK_MTU = 517;
+
+// Connection intervals are in 1.25 ms units, supervision timeout in 10 ms
+const uint16_t BLE_FAST_MIN_INTERVAL = 6;    // 7.5 ms
+const uint16_t BLE_FAST_MAX_INTERVAL = 12;   // 15 ms
+const uint16_t BLE_FAST_LATENCY = 0;
+const uint16_t BLE_FAST_TIMEOUT = 400;       // 4 s
+const uint16_t BLE_IDLE_MIN_INTERVAL = 240;  // 300 ms
+const uint16_t BLE_IDLE_MAX_INTERVAL = 320;  // 400 ms
+const uint16_t BLE_IDLE_LATENCY = 0;
+const uint16_t BLE_IDLE_TIMEOUT = 600;       // 6 s
+
+const unsigned long BLE_BULK_IDLE_MS = 1000;  // no traffic -> low-power interval
+const unsigned long BLE_BULK_FLUSH_MS = 20;   // max time a partial packet waits
+const int BLE_BULK_MAX_NOTIFY_PER_LOOP = 8;   // keep loop() responsive
+
+const size_t BLE_BULK_RX_BUFFER = 8192;
+const size_t BLE_BULK_TX_BUFFER = 4096;
+
+const uint8_t BLE_BULK_CTRL_TX_BENCH = 0x01;
+const uint8_t BLE_BULK_CTRL_RX_BENCH = 0x02;
+const uint8_t BLE_BULK_CTRL_RX_REPORT = 0x03;
+const uint8_t BLE_BULK_EVT_CREDITS = 0x80;
+const uint8_t BLE_BULK_EVT_TX_DONE = 0x81;
+const uint8_t BLE_BULK_EVT_RX_REPORT = 0x82;
+
+// Called from loop() with bulk data received from the host
+typedef void (*BleBulkReceiver)(const uint8_t* data, size_t len);
+
+void setupBleBulk(BLEServer* server, BLEService* service);
+void bleBulkSetReceiver(BleBulkReceiver receiver);
+
+// Queue bytes for the host. Returns the number of bytes accepted, which is
+// less than len if the TX buffer is full or nobody is subscribed.
+size_t bleBulkSend(const uint8_t* data, size_t len);
+
+// Flush batched notifications, hand received data to the receiver, grant
+// credits and pick the connection interval. Call from loop().
+void bleBulkLoop(unsigned long currentTime);
+
+// Other services moving data over the same link (BLE OTA) call this on
+// each packet, so the link stays on the short interval while they do.
+// Safe from the BLE task.
+void bleBulkNoteTraffic();
+
+bool bleBulkConnected();
+uint16_t bleBulkPayloadSize(); // negotiated MTU - 3
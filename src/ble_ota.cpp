@@ -0,0 +1,243 @@
+#include "ble_ota.h"
+#include "ble_bulk.h"
+#include "log.h"
+#include "ota_stream.h"
+
+#include <Arduino.h>
+#include <BLEDevice.h>
+#include <BLEServer.h>
+#include <BLE2902.h>
+#include <Update.h>
+#include <freertos/ringbuf.h>
+
+#define OTA_SERVICE_UUID     "4fafc202-1fb5-459e-8fcc-c5c9c331914b"
+#define OTA_CTRL_CHAR_UUID   "beb54850-36e1-4688-b7f5-ea07361b26a8"
+#define OTA_DATA_CHAR_UUID   "beb54851-36e1-4688-b7f5-ea07361b26a8"
+
+struct BleOtaControl {
+    uint8_t opcode;
+    uint32_t size;
+    uint8_t digest[OTA_DIGEST_LEN];
+};
+
+static UpdatePartitionSink sink;
+static OtaStream stream(sink);
+
+// Chunks are written to flash from loop(), not from the Bluedroid task.
+// The ring holds one full window so a well-behaved host never overflows it.
+static RingbufHandle_t dataRing = nullptr;
+static QueueHandle_t controlQueue = nullptr;
+static BLECharacteristic* ctrlCharacteristic = nullptr;
+
+// Current session
+static uint32_t sessionSize = 0;
+static uint8_t sessionDigest[OTA_DIGEST_LEN];
+static uint16_t nextSeq = 0;
+static bool nakSent = false;
+static int chunksSinceAck = 0;
+static unsigned long lastActivityTime = 0;
+
+static void putLE16(uint8_t* p, uint16_t v) {
+    p[0] = v; p[1] = v >> 8;
+}
+
+static void putLE32(uint8_t* p, uint32_t v) {
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static void notifyPosition(uint8_t event, int status) {
+    uint8_t buf[8];
+    size_t len = 0;
+    buf[len++] = event;
+    if (status >= 0) {
+        buf[len++] = (uint8_t)status;
+    }
+    putLE16(buf + len, nextSeq);
+    putLE32(buf + len + 2, stream.written());
+    len += 6;
+    ctrlCharacteristic->setValue(buf, len);
+    ctrlCharacteristic->notify();
+}
+
+static void notifyDone(OtaStreamStatus status) {
+    uint8_t buf[2] = { BLE_OTA_EVT_DONE, (uint8_t)status };
+    ctrlCharacteristic->setValue(buf, 2);
+    ctrlCharacteristic->notify();
+}
+
+class OtaControlCallbacks : public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pCharacteristic) {
+        std::string value = pCharacteristic->getValue();
+        if (value.length() == 0) {
+            return;
+        }
+        BleOtaControl control;
+        memset(&control, 0, sizeof(control));
+        control.opcode = (uint8_t)value[0];
+        if (control.opcode == BLE_OTA_BEGIN) {
+            if (value.length() != 1 + 4 + OTA_DIGEST_LEN) {
+                return;
+            }
+            const uint8_t* p = (const uint8_t*)value.data() + 1;
+            control.size = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+            memcpy(control.digest, p + 4, OTA_DIGEST_LEN);
+        }
+        xQueueSend(controlQueue, &control, 0);
+    }
+};
+
+class OtaDataCallbacks : public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pCharacteristic) {
+        std::string value = pCharacteristic->getValue();
+        if (value.length() < 2 || value.length() > 2 + BLE_OTA_MAX_CHUNK) {
+            return;
+        }
+        // If the ring is full the chunk is dropped; the sequence gap makes
+        // the loop NAK and the host resends from there.
+        xRingbufferSend(dataRing, value.data(), value.length(), 0);
+        bleBulkNoteTraffic(); // keep the link on the fast interval
+    }
+};
+
+static void beginSession(const BleOtaControl& control) {
+    bool sameImage = stream.active() && control.size == sessionSize &&
+                     memcmp(control.digest, sessionDigest, OTA_DIGEST_LEN) == 0;
+    if (sameImage) {
+        LOGI(LOG_OTA, "BLE OTA: resuming at %u of %u bytes", stream.written(), sessionSize);
+        nakSent = false;
+        chunksSinceAck = 0;
+        notifyPosition(BLE_OTA_EVT_READY, OTA_STREAM_OK);
+        return;
+    }
+
+    if (stream.active()) {
+        stream.abort(); // a different image replaces the interrupted one
+    }
+    nextSeq = 0;
+    nakSent = false;
+    chunksSinceAck = 0;
+    if (Update.isRunning()) {
+        notifyPosition(BLE_OTA_EVT_READY, OTA_STREAM_BEGIN_FAILED); // HTTP update in progress
+        return;
+    }
+
+    char digestHex[OTA_DIGEST_LEN * 2 + 1];
+    for (size_t i = 0; i < OTA_DIGEST_LEN; i++) {
+        sprintf(digestHex + i * 2, "%02x", control.digest[i]);
+    }
+    OtaStreamStatus status = stream.begin(control.size, digestHex);
+    if (status == OTA_STREAM_OK) {
+        sessionSize = control.size;
+        memcpy(sessionDigest, control.digest, OTA_DIGEST_LEN);
+        LOGI(LOG_OTA, "BLE OTA: receiving %u bytes", sessionSize);
+    }
+    notifyPosition(BLE_OTA_EVT_READY, status);
+}
+
+static void endSession() {
+    OtaStreamStatus status = stream.end();
+    LOGI(LOG_OTA, "BLE OTA finished: %u bytes, %s", stream.written(), OtaStream::statusString(status));
+    notifyDone(status);
+    if (status == OTA_STREAM_OK) {
+        delay(500); // let the notification go out
+        logFlush();
+        ESP.restart();
+    }
+}
+
+static void writeChunk(const uint8_t* item, size_t len) {
+    uint16_t seq = item[0] | (item[1] << 8);
+    if (seq != nextSeq) {
+        if (!nakSent) {
+            notifyPosition(BLE_OTA_EVT_NAK, -1);
+            nakSent = true;
+        }
+        return;
+    }
+    nakSent = false;
+
+    OtaStreamStatus status = stream.write(item + 2, len - 2);
+    if (status != OTA_STREAM_OK) {
+        LOGE(LOG_OTA, "BLE OTA write failed: %s", OtaStream::statusString(status));
+        notifyDone(status);
+        return;
+    }
+    nextSeq++;
+    if (++chunksSinceAck >= BLE_OTA_ACK_EVERY || stream.written() >= sessionSize) {
+        notifyPosition(BLE_OTA_EVT_ACK, -1);
+        chunksSinceAck = 0;
+    }
+}
+
+void setupBleOta(BLEServer* server) {
+    dataRing = xRingbufferCreate(BLE_OTA_WINDOW * (BLE_OTA_MAX_CHUNK + 2 + 8), RINGBUF_TYPE_NOSPLIT);
+    controlQueue = xQueueCreate(4, sizeof(BleOtaControl));
+
+    BLEService *pService = server->createService(OTA_SERVICE_UUID);
+
+    ctrlCharacteristic = pService->createCharacteristic(
+                             OTA_CTRL_CHAR_UUID,
+                             BLECharacteristic::PROPERTY_WRITE |
+                             BLECharacteristic::PROPERTY_NOTIFY
+                         );
+    ctrlCharacteristic->addDescriptor(new BLE2902());
+    ctrlCharacteristic->setCallbacks(new OtaControlCallbacks());
+
+    BLECharacteristic *pData = pService->createCharacteristic(
+                                   OTA_DATA_CHAR_UUID,
+                                   BLECharacteristic::PROPERTY_WRITE_NR
+                               );
+    pData->setCallbacks(new OtaDataCallbacks());
+
+    pService->start();
+}
+
+bool bleOtaLoop(unsigned long currentTime) {
+    if (dataRing == nullptr) {
+        return false;
+    }
+
+    // Data first, so a BEGIN after a reconnect sees every chunk that made it
+    size_t len;
+    uint8_t* item;
+    while ((item = (uint8_t*)xRingbufferReceive(dataRing, &len, 0)) != nullptr) {
+        if (stream.active()) {
+            writeChunk(item, len);
+        }
+        vRingbufferReturnItem(dataRing, item);
+        lastActivityTime = currentTime;
+    }
+
+    BleOtaControl control;
+    while (xQueueReceive(controlQueue, &control, 0) == pdTRUE) {
+        lastActivityTime = currentTime;
+        if (control.opcode == BLE_OTA_BEGIN) {
+            beginSession(control);
+        } else if (control.opcode == BLE_OTA_END) {
+            endSession();
+        } else if (control.opcode == BLE_OTA_ABORT) {
+            stream.abort();
+            notifyDone(OTA_STREAM_IDLE);
+        }
+    }
+
+    if (stream.active() && !bleBulkConnected() &&
+        currentTime - lastActivityTime > BLE_OTA_RESUME_TIMEOUT_MS) {
+        LOGW(LOG_OTA, "BLE OTA: client never came back, dropping partial image.");
+        stream.abort();
+    }
+    return stream.active();
+}
+
+size_t bleOtaWritten() {
+    return stream.written();
+}
+
+size_t bleOtaSize() {
+    return stream.active() ? stream.expectedSize() : 0;
+}
+
+bool bleOtaReceiving(unsigned long currentTime) {
+    return stream.active() && bleBulkConnected() &&
+           currentTime - lastActivityTime < BLE_OTA_STALL_MS;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class BLEServer;
+
+/*
+  Firmware update over BLE, for when WiFi is unavailable.
+
+  Service: 4fafc202-1fb5-459e-8fcc-c5c9c331914b
+  Control (WRITE, NOTIFY): beb54850-36e1-4688-b7f5-ea07361b26a8
+    host -> device: [BLE_OTA_BEGIN, u32 size, 32 byte SHA-256]
+                    [BLE_OTA_END]
+                    [BLE_OTA_ABORT]
+    device -> host: [BLE_OTA_EVT_READY, status, u16 seq, u32 offset]
+                    [BLE_OTA_EVT_ACK,   u16 seq, u32 offset]
+                    [BLE_OTA_EVT_NAK,   u16 seq, u32 offset]
+                    [BLE_OTA_EVT_DONE,  status]
+  Data (WRITE_NR): beb54851-36e1-4688-b7f5-ea07361b26a8
+    [u16 seq, image bytes...] - up to MTU-5 bytes of image per chunk
+
+  READY/ACK/NAK all say "next expected chunk is seq, at image offset".
+  The host keeps at most BLE_OTA_WINDOW chunks unacknowledged; the device
+  acks every BLE_OTA_ACK_EVERY chunks once they are written to flash, and
+  NAKs the first out-of-order chunk so the host can rewind.
+
+  If the link drops, the partially written image is kept. Sending BEGIN
+  again with the same size and digest resumes at the last written offset
+  instead of starting over. The image is checked against the digest before
+  the boot partition is switched (see OtaStream).
+  status is an OtaStreamStatus; multi-byte values are little endian.
+*/
+
+const uint8_t BLE_OTA_BEGIN = 0x01;
+const uint8_t BLE_OTA_END = 0x02;
+const uint8_t BLE_OTA_ABORT = 0x03;
+const uint8_t BLE_OTA_EVT_READY = 0x81;
+const uint8_t BLE_OTA_EVT_ACK = 0x82;
+const uint8_t BLE_OTA_EVT_NAK = 0x83;
+const uint8_t BLE_OTA_EVT_DONE = 0x84;
+
+const int BLE_OTA_WINDOW = 8;
+const int BLE_OTA_ACK_EVERY = 4;
+const size_t BLE_OTA_MAX_CHUNK = 512;
+
+// Give up on an interrupted transfer nobody came back for
+const unsigned long BLE_OTA_RESUME_TIMEOUT_MS = 5 * 60 * 1000UL;
+// A transfer counts as moving until it has been quiet this long
+const unsigned long BLE_OTA_STALL_MS = 3000;
+
+void setupBleOta(BLEServer* server);
+
+// Writes received chunks to flash and answers control requests.
+// Call from loop(); returns true while a transfer is in progress.
+bool bleOtaLoop(unsigned long currentTime);
+
+// Image bytes written so far and the expected total, for a progress bar
+size_t bleOtaWritten();
+size_t bleOtaSize();
+
+// True while a client is connected and chunks or control requests arrived
+// in the last BLE_OTA_STALL_MS; false while waiting for a resume
+bool bleOtaReceiving(unsigned long currentTime);
@@ -0,0 +1,52 @@
+#include "event_trace.h"
+
+#include <string.h>
+
+static_assert(sizeof(TraceRecord) == 12, "trace records are downloaded as raw bytes");
+static_assert(sizeof(TraceHeader) == 16, "trace header is downloaded as raw bytes");
+
+static const char* const TYPE_NAMES[TRACE_TYPE_COUNT] = {
+  "boot", "command", "random", "state", "blink", "mood",
+  "feed-end", "need", "frame", "snapshot", "timer", "rng"
+};
+
+EventTrace::EventTrace() {
+  clear();
+}
+
+void EventTrace::record(uint32_t time, TraceType type, uint8_t arg, uint16_t value, int32_t data) {
+  TraceRecord& record = _records[_total % TRACE_RECORDS];
+  record.time = time;
+  record.type = type;
+  record.arg = arg;
+  record.value = value;
+  record.data = data;
+  if (type == TRACE_SNAPSHOT) {
+    _lastSnapshot = _total;
+  }
+  _total++;
+}
+
+const TraceRecord& EventTrace::at(size_t index) const {
+  uint32_t first = _total - count();
+  return _records[(first + index) % TRACE_RECORDS];
+}
+
+TraceHeader EventTrace::header() const {
+  TraceHeader header;
+  memcpy(header.magic, "PTR1", 4);
+  header.version = TRACE_VERSION;
+  header.recordSize = sizeof(TraceRecord);
+  header.count = count();
+  header.total = _total;
+  return header;
+}
+
+void EventTrace::clear() {
+  _total = 0;
+  _lastSnapshot = 0;
+}
+
+const char* EventTrace::typeName(uint8_t type) {
+  return type < TRACE_TYPE_COUNT ? TYPE_NAMES[type] : "?";
+}
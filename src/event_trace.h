@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Flight recorder for the pet's behaviour: every input (commands, the needs
+// mood) and every decision (random draws, state changes, blinks, the end of
+// a feed) goes into a fixed ring of binary records in RAM, with a record
+// per drawn frame carrying a hash of what was on screen and how long the
+// frame took. /trace downloads it; tools/trace_replay.cpp feeds the inputs
+// back through the same PetBehavior code on the host and checks that every
+// decision and frame comes out identical.
+//
+// The behaviour writes a snapshot of its full state, PRNG included, every
+// TRACE_SNAPSHOT_EVERY records (when no blink or transition is under way),
+// so a replay can start from whatever is left after the ring wraps.
+//
+// Not thread-safe: record from the loop() task only, like the pet commands.
+
+enum TraceType : uint8_t {
+  TRACE_BOOT,      // arg: 1 if resumed from night mode
+  TRACE_COMMAND,   // arg: TraceCommand, data: parameter
+  TRACE_RANDOM,    // value: range (max - min), data: result
+  TRACE_STATE,     // arg: from state (| TRACE_FROM_UPDATE), value: to state
+  TRACE_BLINK,     // a blink started
+  TRACE_MOOD,      // needs input changed; arg: 1 if a need shows, value: its mood
+  TRACE_FEED_END,  // happy timeout fired; arg: manual mode restored
+  TRACE_NEED,      // arg: PetNeed, value: level after a feed or care
+  TRACE_FRAME,     // value: render + flush time in us, data: frame hash
+  TRACE_SNAPSHOT,  // arg: state (| TRACE_FROM_UPDATE), value: flags, data: recent states
+  TRACE_TIMER,     // follows a snapshot; arg: timer, data: value in ms
+  TRACE_RNG,       // follows the timers; arg: word, data: PetRandom state word
+  TRACE_TYPE_COUNT
+};
+
+enum TraceCommand : uint8_t {
+  TRACE_CMD_EMOTION,
+  TRACE_CMD_READING_LIGHT,
+  TRACE_CMD_MANUAL,
+  TRACE_CMD_FEED
+};
+
+// Set in a TRACE_STATE or TRACE_SNAPSHOT arg when written by update() rather
+// than a command or begin()/restore()
+const uint8_t TRACE_FROM_UPDATE = 0x80;
+
+struct TraceRecord {
+  uint32_t time;   // ms, the pet's clock
+  uint8_t type;    // TraceType
+  uint8_t arg;
+  uint16_t value;
+  int32_t data;
+};
+
+// /trace body: this header, then count records oldest first, little-endian
+struct TraceHeader {
+  char magic[4];        // "PTR1"
+  uint16_t version;
+  uint16_t recordSize;
+  uint32_t count;       // records that follow
+  uint32_t total;       // records written since boot, dropped ones included
+};
+
+const uint16_t TRACE_VERSION = 2;
+const size_t TRACE_RECORDS = 1024;        // 12 KB; several minutes of an idle pet
+const uint32_t TRACE_SNAPSHOT_EVERY = 256;
+
+class EventTrace {
+public:
+  EventTrace();
+
+  void record(uint32_t time, TraceType type, uint8_t arg = 0, uint16_t value = 0, int32_t data = 0);
+
+  size_t count() const { return _total < TRACE_RECORDS ? _total : TRACE_RECORDS; }
+  uint32_t total() const { return _total; }
+  // index 0 is the oldest record still held
+  const TraceRecord& at(size_t index) const;
+  TraceHeader header() const;
+
+  // Time for the behaviour to write another snapshot
+  bool snapshotDue() const { return _total - _lastSnapshot >= TRACE_SNAPSHOT_EVERY; }
+
+  void clear();
+
+  static const char* typeName(uint8_t type);
+
+private:
+  TraceRecord _records[TRACE_RECORDS];
+  uint32_t _total;
+  uint32_t _lastSnapshot;
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+// Generated by tools/eye_assets.py from:
+//   art/eyes/angry.pbm
+//   art/eyes/down.pbm
+//   art/eyes/happy.pbm
+//   art/eyes/left.pbm
+//   art/eyes/neutral.pbm
+//   art/eyes/right.pbm
+//   art/eyes/sad.pbm
+//   art/eyes/sleepy.pbm
+//   art/eyes/surprised.pbm
+//   art/eyes/suspicious.pbm
+//   art/eyes/up.pbm
+// Edit the artwork and rerun the tool rather than editing this file.
+
+#include "eye_bitmap.h"
+#include "eye_state.h"
+
+constexpr uint8_t EYE_ART_ANGRY_DATA[] = {
+  0xff, 0x00, 0xff, 0x00, 0x98, 0x00, 0x11, 0xa0, 0xf8, 0xdc, 0xfc, 0xee, 0x7e, 0xef, 0xbe, 0xdf,
+  0xde, 0xee, 0xec, 0xf6, 0xf0, 0xf8, 0xe0, 0x70, 0x80, 0xa9, 0x00, 0x11, 0x80, 0xf0, 0xa0, 0xf8,
+  0x58, 0xf6, 0xbc, 0xee, 0x7e, 0xdf, 0xfe, 0xbf, 0xfe, 0xee, 0xfc, 0xdc, 0xf8, 0xa0, 0xb1, 0x00,
+  0x15, 0x2f, 0xfd, 0xb7, 0xfe, 0xdb, 0xff, 0xed, 0xff, 0xd6, 0x7f, 0xeb, 0xbf, 0xed, 0xbb, 0xf6,
+  0xbd, 0xfb, 0xde, 0x7d, 0xee, 0xb0, 0x40, 0xa1, 0x00, 0x15, 0x40, 0xf0, 0xde, 0xfd, 0xbe, 0xfb,
+  0x7d, 0xf7, 0xbb, 0xef, 0x7e, 0xdf, 0x7d, 0xdf, 0xfa, 0xdd, 0xf5, 0xbb, 0xeb, 0x77, 0xd7, 0x2f,
+  0xb3, 0x00, 0x13, 0x07, 0x0b, 0x17, 0xfd, 0x5b, 0xfe, 0xad, 0xff, 0xd7, 0x7f, 0xeb, 0xbf, 0xf5,
+  0xdb, 0xfa, 0x7d, 0xfd, 0xbe, 0xfe, 0x5f, 0xa1, 0x00, 0x13, 0x5f, 0xfb, 0xbe, 0xf7, 0x7d, 0xef,
+  0x7b, 0xdf, 0xb6, 0xbf, 0x7d, 0x7f, 0xfb, 0xfd, 0xf6, 0x7b, 0xed, 0x17, 0x0b, 0x07, 0xba, 0x00,
+  0x0d, 0x01, 0x01, 0x06, 0x03, 0x07, 0x07, 0x0f, 0x07, 0x0f, 0x07, 0x07, 0x03, 0x03, 0x01, 0xa3,
+  0x00, 0x0d, 0x01, 0x03, 0x03, 0x07, 0x07, 0x0f, 0x07, 0x0f, 0x07, 0x07, 0x03, 0x06, 0x00, 0x01,
+  0xff, 0x00, 0xff, 0x00, 0x9f, 0x00,
+};
+constexpr EyeBitmap EYE_ART_ANGRY = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_ANGRY_DATA), EYE_ART_ANGRY_DATA};
+
+constexpr uint8_t EYE_ART_DOWN_DATA[] = {
+  0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xa4, 0x00, 0x87, 0x80, 0xa5, 0x00, 0x87, 0x80, 0xc1, 0x00,
+  0x05, 0x80, 0xe0, 0xf0, 0xfc, 0xfe, 0xfe, 0x8b, 0xff, 0x05, 0xfe, 0xfe, 0xfc, 0xf0, 0xe0, 0x80,
+  0x95, 0x00, 0x05, 0x80, 0xe0, 0xf0, 0xfc, 0xfe, 0xfe, 0x8b, 0xff, 0x05, 0xfe, 0xfe, 0xfc, 0xf0,
+  0xe0, 0x80, 0xb8, 0x00, 0x00, 0x10, 0x97, 0xff, 0x00, 0x10, 0x93, 0x00, 0x00, 0x10, 0x97, 0xff,
+  0x00, 0x10, 0xb8, 0x00, 0x03, 0x03, 0x0f, 0x1f, 0x7f, 0x8f, 0xff, 0x03, 0x7f, 0x1f, 0x0f, 0x03,
+  0x95, 0x00, 0x03, 0x03, 0x0f, 0x1f, 0x7f, 0x8f, 0xff, 0x03, 0x7f, 0x1f, 0x0f, 0x03, 0xbf, 0x00,
+  0x01, 0x01, 0x01, 0x87, 0x03, 0x01, 0x01, 0x01, 0xa1, 0x00, 0x01, 0x01, 0x01, 0x87, 0x03, 0x01,
+  0x01, 0x01, 0xa2, 0x00,
+};
+constexpr EyeBitmap EYE_ART_DOWN = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_DOWN_DATA), EYE_ART_DOWN_DATA};
+
+constexpr uint8_t EYE_ART_HAPPY_DATA[] = {
+  0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x01, 0x80, 0x80, 0x83, 0xc0, 0x8a, 0xe0, 0x89, 0xf0, 0x83,
+  0xe0, 0x02, 0xc0, 0xc0, 0x80, 0x91, 0x00, 0x02, 0x80, 0xc0, 0xc0, 0x83, 0xe0, 0x8a, 0xf0, 0x89,
+  0xe0, 0x83, 0xc0, 0x01, 0x80, 0x80, 0xa7, 0x00, 0x04, 0x06, 0x0f, 0x1f, 0x3f, 0x3f, 0x83, 0x7f,
+  0x89, 0xff, 0x00, 0xfb, 0x89, 0x7f, 0x83, 0x3f, 0x03, 0x1f, 0x1f, 0x0f, 0x06, 0x8d, 0x00, 0x03,
+  0x06, 0x0f, 0x1f, 0x1f, 0x83, 0x3f, 0x8a, 0x7f, 0x00, 0xfd, 0x88, 0xff, 0x83, 0x7f, 0x04, 0x3f,
+  0x3f, 0x1f, 0x0f, 0x06, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x92, 0x00,
+};
+constexpr EyeBitmap EYE_ART_HAPPY = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_HAPPY_DATA), EYE_ART_HAPPY_DATA};
+
+constexpr uint8_t EYE_ART_LEFT_DATA[] = {
+  0xff, 0x00, 0xc2, 0x00, 0x04, 0x80, 0xe0, 0xf0, 0xf8, 0xfc, 0x85, 0xfe, 0x04, 0xfc, 0xf8, 0xf0,
+  0xe0, 0x80, 0xc6, 0x00, 0x02, 0xc0, 0xf0, 0xf8, 0x83, 0xfc, 0x02, 0xf8, 0xf0, 0xc0, 0x9b, 0x00,
+  0x02, 0x80, 0xf8, 0xfe, 0x8f, 0xff, 0x02, 0xfe, 0xf8, 0x80, 0xc2, 0x00, 0x00, 0xfe, 0x89, 0xff,
+  0x00, 0xfe, 0x9a, 0x00, 0x95, 0xff, 0xc1, 0x00, 0x00, 0x01, 0x8b, 0xff, 0x00, 0x01, 0x98, 0x00,
+  0x00, 0x01, 0x95, 0xff, 0x00, 0x01, 0xc2, 0x00, 0x02, 0x07, 0x1f, 0x3f, 0x83, 0x7f, 0x02, 0x3f,
+  0x1f, 0x07, 0x9b, 0x00, 0x01, 0x03, 0x3f, 0x91, 0xff, 0x01, 0x3f, 0x03, 0xec, 0x00, 0x04, 0x03,
+  0x0f, 0x1f, 0x3f, 0x7f, 0x85, 0xff, 0x04, 0x7f, 0x3f, 0x1f, 0x0f, 0x03, 0xff, 0x00, 0xac, 0x00,
+};
+constexpr EyeBitmap EYE_ART_LEFT = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_LEFT_DATA), EYE_ART_LEFT_DATA};
+
+constexpr uint8_t EYE_ART_NEUTRAL_DATA[] = {
+  0xff, 0x00, 0x9f, 0x00, 0x04, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0x87, 0xf8, 0x04, 0xf0, 0xf0, 0xe0,
+  0xc0, 0x80, 0x9b, 0x00, 0x04, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0x87, 0xf8, 0x04, 0xf0, 0xf0, 0xe0,
+  0xc0, 0x80, 0xbb, 0x00, 0x02, 0xc0, 0xf8, 0xfc, 0x93, 0xff, 0x02, 0xfc, 0xf8, 0xc0, 0x93, 0x00,
+  0x02, 0xc0, 0xf8, 0xfc, 0x93, 0xff, 0x02, 0xfc, 0xf8, 0xc0, 0xb6, 0x00, 0x00, 0xfe, 0x99, 0xff,
+  0x00, 0xfe, 0x91, 0x00, 0x00, 0xfe, 0x99, 0xff, 0x00, 0xfe, 0xb4, 0x00, 0x00, 0x01, 0x9b, 0xff,
+  0x00, 0x01, 0x8f, 0x00, 0x00, 0x01, 0x9b, 0xff, 0x00, 0x01, 0xb5, 0x00, 0x02, 0x07, 0x3f, 0x7f,
+  0x93, 0xff, 0x02, 0x7f, 0x3f, 0x07, 0x93, 0x00, 0x02, 0x07, 0x3f, 0x7f, 0x93, 0xff, 0x02, 0x7f,
+  0x3f, 0x07, 0xba, 0x00, 0x05, 0x01, 0x03, 0x07, 0x0f, 0x1f, 0x1f, 0x87, 0x3f, 0x05, 0x1f, 0x1f,
+  0x0f, 0x07, 0x03, 0x01, 0x99, 0x00, 0x05, 0x01, 0x03, 0x07, 0x0f, 0x1f, 0x1f, 0x87, 0x3f, 0x05,
+  0x1f, 0x1f, 0x0f, 0x07, 0x03, 0x01, 0xff, 0x00, 0x9e, 0x00,
+};
+constexpr EyeBitmap EYE_ART_NEUTRAL = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_NEUTRAL_DATA), EYE_ART_NEUTRAL_DATA};
+
+constexpr uint8_t EYE_ART_RIGHT_DATA[] = {
+  0xff, 0x00, 0xac, 0x00, 0x04, 0x80, 0xe0, 0xf0, 0xf8, 0xfc, 0x85, 0xfe, 0x04, 0xfc, 0xf8, 0xf0,
+  0xe0, 0x80, 0xec, 0x00, 0x02, 0x80, 0xf8, 0xfe, 0x8f, 0xff, 0x02, 0xfe, 0xf8, 0x80, 0x9b, 0x00,
+  0x02, 0xc0, 0xf0, 0xf8, 0x83, 0xfc, 0x02, 0xf8, 0xf0, 0xc0, 0xc3, 0x00, 0x95, 0xff, 0x9a, 0x00,
+  0x00, 0xfe, 0x89, 0xff, 0x00, 0xfe, 0xc1, 0x00, 0x00, 0x01, 0x95, 0xff, 0x00, 0x01, 0x98, 0x00,
+  0x00, 0x01, 0x8b, 0xff, 0x00, 0x01, 0xc1, 0x00, 0x01, 0x03, 0x3f, 0x91, 0xff, 0x01, 0x3f, 0x03,
+  0x9b, 0x00, 0x02, 0x07, 0x1f, 0x3f, 0x83, 0x7f, 0x02, 0x3f, 0x1f, 0x07, 0xc6, 0x00, 0x04, 0x03,
+  0x0f, 0x1f, 0x3f, 0x7f, 0x85, 0xff, 0x04, 0x7f, 0x3f, 0x1f, 0x0f, 0x03, 0xff, 0x00, 0xc2, 0x00,
+};
+constexpr EyeBitmap EYE_ART_RIGHT = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_RIGHT_DATA), EYE_ART_RIGHT_DATA};
+
+constexpr uint8_t EYE_ART_SAD_DATA[] = {
+  0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x9a, 0x00, 0x04, 0xe0, 0xf0, 0xf8, 0xfc, 0xfc,
+  0x82, 0xfe, 0x8b, 0xff, 0x82, 0xfe, 0x04, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0x91, 0x00, 0x04, 0xe0,
+  0xf0, 0xf8, 0xfc, 0xfc, 0x82, 0xfe, 0x8b, 0xff, 0x82, 0xfe, 0x04, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0,
+  0xb4, 0x00, 0x05, 0x01, 0x0f, 0x1f, 0x3f, 0x7f, 0x7f, 0x91, 0xff, 0x05, 0x7f, 0x7f, 0x3f, 0x1f,
+  0x0f, 0x01, 0x8f, 0x00, 0x05, 0x01, 0x0f, 0x1f, 0x3f, 0x7f, 0x7f, 0x91, 0xff, 0x05, 0x7f, 0x7f,
+  0x3f, 0x1f, 0x0f, 0x01, 0xbc, 0x00, 0x8b, 0x01, 0xa1, 0x00, 0x8b, 0x01, 0xff, 0x00, 0xa2, 0x00,
+};
+constexpr EyeBitmap EYE_ART_SAD = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_SAD_DATA), EYE_ART_SAD_DATA};
+
+constexpr uint8_t EYE_ART_SLEEPY_DATA[] = {
+  0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x9e, 0x00, 0x14, 0x80, 0xc0, 0xe0, 0xb0, 0xd8, 0xe8, 0xfc,
+  0xb4, 0xda, 0xfa, 0x7e, 0xae, 0xf4, 0xfc, 0xbc, 0xf4, 0xf8, 0x78, 0x60, 0xe0, 0xc0, 0x97, 0x00,
+  0x14, 0xc0, 0xe0, 0x60, 0x78, 0xf8, 0xf4, 0xbc, 0xfc, 0xf4, 0xae, 0x7e, 0xfa, 0xda, 0xb4, 0xfc,
+  0xe8, 0xd8, 0xb0, 0xe0, 0xc0, 0x80, 0xba, 0x00, 0x19, 0xd0, 0xf8, 0xaf, 0xf7, 0xfe, 0x7f, 0xef,
+  0xfd, 0xff, 0xbf, 0xdf, 0xff, 0xff, 0xbf, 0xf7, 0xff, 0x7f, 0xee, 0xff, 0xff, 0xfd, 0xff, 0xff,
+  0xfa, 0xfe, 0xf4, 0x93, 0x00, 0x19, 0xf4, 0xfe, 0xfa, 0xff, 0xff, 0xfd, 0xff, 0xff, 0xee, 0x7f,
+  0xff, 0xff, 0xbf, 0xff, 0xff, 0xdf, 0xbf, 0xff, 0xfd, 0xef, 0x7f, 0xfe, 0xf7, 0xaf, 0xf8, 0xd0,
+  0xb7, 0x00, 0x19, 0x2f, 0x7f, 0x5f, 0xff, 0xff, 0xbf, 0xff, 0xff, 0x77, 0xfe, 0xff, 0xff, 0xfd,
+  0xff, 0xff, 0xfb, 0xfd, 0xff, 0xbf, 0xf7, 0xfe, 0x7f, 0xef, 0xf5, 0x1f, 0x0b, 0x93, 0x00, 0x19,
+  0x0b, 0x1f, 0xf5, 0xef, 0x7f, 0xfe, 0xf7, 0xbf, 0xff, 0xfd, 0xfb, 0xff, 0xff, 0xfd, 0xef, 0xff,
+  0xfe, 0x77, 0xff, 0xff, 0xbf, 0xff, 0xff, 0x5f, 0x7f, 0x2f, 0xb9, 0x00, 0x14, 0x03, 0x07, 0x06,
+  0x1e, 0x1f, 0x2f, 0x3d, 0x3f, 0x2f, 0x75, 0x7e, 0x5f, 0x5b, 0x2d, 0x3f, 0x17, 0x1b, 0x0d, 0x07,
+  0x03, 0x01, 0x99, 0x00, 0x14, 0x01, 0x03, 0x07, 0x0d, 0x1b, 0x17, 0x3f, 0x2d, 0x5b, 0x5f, 0x7e,
+  0x75, 0x2f, 0x3f, 0x3d, 0x2f, 0x1f, 0x1e, 0x06, 0x07, 0x03, 0xff, 0x00, 0x9d, 0x00,
+};
+constexpr EyeBitmap EYE_ART_SLEEPY = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_SLEEPY_DATA), EYE_ART_SLEEPY_DATA};
+
+constexpr uint8_t EYE_ART_SURPRISED_DATA[] = {
+  0xa2, 0x00, 0x8b, 0x80, 0xa1, 0x00, 0x8b, 0x80, 0xba, 0x00, 0x08, 0x80, 0xc0, 0xe0, 0xf0, 0xf8,
+  0xfc, 0xfc, 0xfe, 0xfe, 0x8f, 0xff, 0x08, 0xfe, 0xfe, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x80,
+  0x8b, 0x00, 0x08, 0x80, 0xc0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfc, 0xfe, 0xfe, 0x8f, 0xff, 0x08, 0xfe,
+  0xfe, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x80, 0xac, 0x00, 0x02, 0xe0, 0xf8, 0xfe, 0xa1, 0xff,
+  0x02, 0xfe, 0xf8, 0xe0, 0x85, 0x00, 0x02, 0xe0, 0xf8, 0xfe, 0xa1, 0xff, 0x02, 0xfe, 0xf8, 0xe0,
+  0xa8, 0x00, 0x00, 0x08, 0xa7, 0xff, 0x00, 0x08, 0x83, 0x00, 0x00, 0x08, 0xa7, 0xff, 0x00, 0x08,
+  0xa8, 0x00, 0x02, 0x03, 0x0f, 0x3f, 0xa1, 0xff, 0x02, 0x3f, 0x0f, 0x03, 0x85, 0x00, 0x02, 0x03,
+  0x0f, 0x3f, 0xa1, 0xff, 0x02, 0x3f, 0x0f, 0x03, 0xad, 0x00, 0x09, 0x01, 0x03, 0x07, 0x0f, 0x1f,
+  0x1f, 0x3f, 0x3f, 0x7f, 0x7f, 0x8b, 0xff, 0x09, 0x7f, 0x7f, 0x3f, 0x3f, 0x1f, 0x1f, 0x0f, 0x07,
+  0x03, 0x01, 0x8d, 0x00, 0x09, 0x01, 0x03, 0x07, 0x0f, 0x1f, 0x1f, 0x3f, 0x3f, 0x7f, 0x7f, 0x8b,
+  0xff, 0x09, 0x7f, 0x7f, 0x3f, 0x3f, 0x1f, 0x1f, 0x0f, 0x07, 0x03, 0x01, 0xff, 0x00, 0xff, 0x00,
+  0x98, 0x00,
+};
+constexpr EyeBitmap EYE_ART_SURPRISED = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_SURPRISED_DATA), EYE_ART_SURPRISED_DATA};
+
+constexpr uint8_t EYE_ART_SUSPICIOUS_DATA[] = {
+  0xff, 0x00, 0xa3, 0x00, 0x82, 0x80, 0x02, 0xc0, 0xc0, 0x40, 0x83, 0x80, 0xf0, 0x00, 0x08, 0xe0,
+  0xf0, 0xfc, 0xde, 0xef, 0xef, 0xfd, 0xfe, 0xbf, 0x82, 0xdf, 0x00, 0xff, 0x83, 0xbf, 0x03, 0xbe,
+  0x7c, 0x70, 0x60, 0x98, 0x00, 0x05, 0x80, 0xc0, 0xe0, 0xf8, 0xf8, 0xfc, 0x87, 0xfe, 0x05, 0xfc,
+  0xf8, 0xf8, 0xe0, 0xc0, 0x80, 0xbc, 0x00, 0x03, 0xbd, 0xbf, 0xbf, 0xfb, 0x83, 0x7f, 0x00, 0xf7,
+  0x82, 0xff, 0x01, 0x7f, 0xfb, 0x83, 0xff, 0x03, 0xf7, 0xff, 0xff, 0x2f, 0x96, 0x00, 0x01, 0xf0,
+  0xfe, 0x93, 0xff, 0x01, 0xfe, 0xf0, 0xba, 0x00, 0x03, 0x01, 0x03, 0x0f, 0x1f, 0x82, 0x3f, 0x0d,
+  0x7f, 0x7f, 0x6f, 0x7e, 0xfe, 0xff, 0x5f, 0x6f, 0x77, 0x3d, 0x1e, 0x0f, 0x03, 0x01, 0x96, 0x00,
+  0x00, 0x08, 0x97, 0xff, 0x00, 0x08, 0xe6, 0x00, 0x01, 0x07, 0x3f, 0x93, 0xff, 0x01, 0x3f, 0x07,
+  0xea, 0x00, 0x04, 0x01, 0x03, 0x0f, 0x0f, 0x1f, 0x87, 0x3f, 0x04, 0x1f, 0x0f, 0x0f, 0x03, 0x01,
+  0xff, 0x00, 0x9f, 0x00,
+};
+constexpr EyeBitmap EYE_ART_SUSPICIOUS = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_SUSPICIOUS_DATA), EYE_ART_SUSPICIOUS_DATA};
+
+constexpr uint8_t EYE_ART_UP_DATA[] = {
+  0xa4, 0x00, 0x87, 0x80, 0xa5, 0x00, 0x87, 0x80, 0xc1, 0x00, 0x05, 0x80, 0xe0, 0xf0, 0xfc, 0xfe,
+  0xfe, 0x8b, 0xff, 0x05, 0xfe, 0xfe, 0xfc, 0xf0, 0xe0, 0x80, 0x95, 0x00, 0x05, 0x80, 0xe0, 0xf0,
+  0xfc, 0xfe, 0xfe, 0x8b, 0xff, 0x05, 0xfe, 0xfe, 0xfc, 0xf0, 0xe0, 0x80, 0xb8, 0x00, 0x00, 0x10,
+  0x97, 0xff, 0x00, 0x10, 0x93, 0x00, 0x00, 0x10, 0x97, 0xff, 0x00, 0x10, 0xb8, 0x00, 0x03, 0x03,
+  0x0f, 0x1f, 0x7f, 0x8f, 0xff, 0x03, 0x7f, 0x1f, 0x0f, 0x03, 0x95, 0x00, 0x03, 0x03, 0x0f, 0x1f,
+  0x7f, 0x8f, 0xff, 0x03, 0x7f, 0x1f, 0x0f, 0x03, 0xbf, 0x00, 0x01, 0x01, 0x01, 0x87, 0x03, 0x01,
+  0x01, 0x01, 0xa1, 0x00, 0x01, 0x01, 0x01, 0x87, 0x03, 0x01, 0x01, 0x01, 0xff, 0x00, 0xff, 0x00,
+  0xff, 0x00, 0xa2, 0x00,
+};
+constexpr EyeBitmap EYE_ART_UP = {128, 64, EYE_BITMAP_RLE, sizeof(EYE_ART_UP_DATA), EYE_ART_UP_DATA};
+
+// Artwork for each EyeState, nullptr where there is none
+constexpr const EyeBitmap* EYE_ARTWORK[STATE_COUNT] = {
+  &EYE_ART_NEUTRAL,
+  &EYE_ART_ANGRY,
+  &EYE_ART_SURPRISED,
+  &EYE_ART_SAD,
+  &EYE_ART_SUSPICIOUS,
+  &EYE_ART_LEFT,
+  &EYE_ART_RIGHT,
+  &EYE_ART_UP,
+  &EYE_ART_DOWN,
+  &EYE_ART_SLEEPY,
+  &EYE_ART_HAPPY,
+};
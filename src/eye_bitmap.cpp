@@ -0,0 +1,75 @@
+#include "eye_bitmap.h"
+
+#include <string.h>
+
+static bool blitTiles(uint8_t* buffer, int tileWidth, int tiles, const uint8_t* data, size_t size) {
+  size_t maskBytes = (tiles + 7) / 8;
+  if (size < maskBytes) {
+    return false;
+  }
+  const uint8_t* tile = data + maskBytes;
+  const uint8_t* end = data + size;
+  memset(buffer, 0, tiles * 8);
+  for (int i = 0; i < tiles; i++) {
+    if (!(data[i >> 3] & (1 << (i & 7)))) {
+      continue;
+    }
+    if (end - tile < 8) {
+      return false;
+    }
+    int page = i / tileWidth;
+    int column = (i % tileWidth) * 8;
+    memcpy(buffer + page * tileWidth * 8 + column, tile, 8);
+    tile += 8;
+  }
+  return tile == end;
+}
+
+static bool blitRle(uint8_t* buffer, size_t length, const uint8_t* data, size_t size) {
+  size_t out = 0;
+  size_t in = 0;
+  while (in < size) {
+    uint8_t control = data[in++];
+    if (control < 0x80) {
+      size_t count = control + 1;
+      if (in + count > size || out + count > length) {
+        return false;
+      }
+      memcpy(buffer + out, data + in, count);
+      in += count;
+      out += count;
+    } else {
+      size_t count = control - 0x7f;
+      if (in >= size || out + count > length) {
+        return false;
+      }
+      memset(buffer + out, data[in++], count);
+      out += count;
+    }
+  }
+  return out == length;
+}
+
+bool eyeBlitBitmap(U8G2& display, const EyeBitmap& bitmap) {
+  int tileWidth = display.getBufferTileWidth();
+  int tileHeight = display.getBufferTileHeight();
+  if (bitmap.width != tileWidth * 8 || bitmap.height != tileHeight * 8) {
+    return false;
+  }
+  uint8_t* buffer = display.getBufferPtr();
+  size_t length = (size_t)tileWidth * tileHeight * 8;
+
+  switch (bitmap.encoding) {
+    case EYE_BITMAP_RAW:
+      if (bitmap.size != length) {
+        return false;
+      }
+      memcpy(buffer, bitmap.data, length);
+      return true;
+    case EYE_BITMAP_TILES:
+      return blitTiles(buffer, tileWidth, tileWidth * tileHeight, bitmap.data, bitmap.size);
+    case EYE_BITMAP_RLE:
+      return blitRle(buffer, length, bitmap.data, bitmap.size);
+  }
+  return false;
+}
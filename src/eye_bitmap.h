@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <U8g2lib.h>
+
+// Full-screen 1bpp artwork, stored in the U8g2 frame buffer's own layout:
+// pages of 8 rows, one byte per column with the top row in bit 0. That
+// makes drawing a frame a decode straight into the buffer, a few hundred
+// byte copies with no per-pixel work. The arrays are generated by
+// tools/eye_assets.py (see src/eye_artwork.h) and live in flash.
+
+enum EyeBitmapEncoding {
+  // The buffer as is, width * height / 8 bytes
+  EYE_BITMAP_RAW,
+  // A bitmask of the 8x8 tiles that aren't blank (bit i of byte i / 8 for
+  // tile i, row by row), then 8 bytes for each of those tiles
+  EYE_BITMAP_TILES,
+  // PackBits over the buffer bytes: a control byte c < 0x80 is followed by
+  // c + 1 literal bytes, c >= 0x80 by one byte to repeat c - 0x7f times
+  EYE_BITMAP_RLE
+};
+
+struct EyeBitmap {
+  uint8_t width;     // pixels
+  uint8_t height;    // pixels, a multiple of 8
+  uint8_t encoding;  // EyeBitmapEncoding
+  uint16_t size;     // bytes of data
+  const uint8_t* data;
+};
+
+// Replace the display's buffer with the bitmap. Returns false if it isn't
+// the display's size or the data is malformed; the buffer may then be
+// partly overwritten.
+bool eyeBlitBitmap(U8G2& display, const EyeBitmap& bitmap);
@@ -0,0 +1,165 @@
+#include "eye_clip.h"
+
+#include <string.h>
+
+size_t MemoryClipSource::read(uint32_t offset, uint8_t* data, size_t size) {
+  if (offset >= _size) {
+    return 0;
+  }
+  if (size > _size - offset) {
+    size = _size - offset;
+  }
+  memcpy(data, _data + offset, size);
+  return size;
+}
+
+#ifdef ARDUINO
+size_t FileClipSource::read(uint32_t offset, uint8_t* data, size_t size) {
+  if (_file.position() != offset && !_file.seek(offset)) {
+    return 0;
+  }
+  return _file.read(data, size);
+}
+#endif
+
+static uint16_t readLe16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+
+ClipPlayer::ClipPlayer()
+    : _source(nullptr), _frames(0), _period(0), _start(0), _bufferValid(false), _shown(-1), _next(0),
+      _key(-1), _keyOffset(0), _chunkOffset(0), _chunkLength(0), _chunkPos(0) {}
+
+bool ClipPlayer::start(ClipSource& source, U8G2& display, uint32_t now) {
+  _source = nullptr;
+  uint8_t header[EYE_CLIP_HEADER_SIZE];
+  if (source.read(0, header, sizeof(header)) != sizeof(header) || header[0] != 'E' || header[1] != 'C' ||
+      header[2] != EYE_CLIP_VERSION || header[4] != display.getDisplayWidth() ||
+      header[5] != display.getDisplayHeight()) {
+    return false;
+  }
+  _frames = readLe16(header + 6);
+  _period = readLe16(header + 8);
+  if (_frames == 0 || _period == 0) {
+    return false;
+  }
+  _source = &source;
+  _start = now;
+  _bufferValid = true;
+  _shown = -1;
+  _next = EYE_CLIP_HEADER_SIZE;
+  _key = -1;
+  _keyOffset = 0;
+  _chunkOffset = 0;
+  _chunkLength = 0;
+  _chunkPos = 0;
+  return true;
+}
+
+bool ClipPlayer::render(U8G2& display, uint32_t now) {
+  if (!_source) {
+    return false;
+  }
+  uint32_t due = (now - _start) / _period;
+  if (due >= _frames) {
+    stop();
+    return false;
+  }
+
+  if (!_bufferValid) {
+    // Start over from the last key frame
+    if (_key >= 0) {
+      _shown = _key - 1;
+      _next = _keyOffset;
+    }
+    _bufferValid = true;
+  }
+
+  uint8_t* buffer = display.getBufferPtr();
+  size_t length = (size_t)display.getBufferTileWidth() * display.getBufferTileHeight() * 8;
+  bool changed = false;
+  while (_shown < (int)due) {
+    if (!decodeNext(buffer, length)) {
+      stop();
+      return changed;
+    }
+    changed = true;
+  }
+  return changed;
+}
+
+void ClipPlayer::seek(uint32_t offset) {
+  if (offset >= _chunkOffset && offset <= _chunkOffset + _chunkLength) {
+    _chunkPos = offset - _chunkOffset;
+    return;
+  }
+  _chunkOffset = offset;
+  _chunkLength = 0;
+  _chunkPos = 0;
+}
+
+bool ClipPlayer::fill() {
+  _chunkOffset += _chunkLength;
+  _chunkLength = _source->read(_chunkOffset, _chunk, sizeof(_chunk));
+  _chunkPos = 0;
+  return _chunkLength > 0;
+}
+
+bool ClipPlayer::decodeNext(uint8_t* buffer, size_t length) {
+  seek(_next);
+  uint8_t type, lo, hi;
+  if (!nextByte(type) || !nextByte(lo) || !nextByte(hi)) {
+    return false;
+  }
+  uint32_t left = lo | (hi << 8);
+  bool key = type == EYE_CLIP_KEY;
+  if (!key && (type != EYE_CLIP_DELTA || _shown < 0)) {
+    return false;
+  }
+
+  // PackBits, stored as is (key) or XORed into the frame before (delta)
+  size_t out = 0;
+  while (left > 0) {
+    uint8_t control, value;
+    if (!nextByte(control)) {
+      return false;
+    }
+    left--;
+    if (control < 0x80) {
+      size_t count = control + 1;
+      if (count > left || out + count > length) {
+        return false;
+      }
+      left -= count;
+      for (size_t i = 0; i < count; i++, out++) {
+        if (!nextByte(value)) {
+          return false;
+        }
+        buffer[out] = key ? value : buffer[out] ^ value;
+      }
+    } else {
+      size_t count = control - 0x7f;
+      if (left == 0 || out + count > length || !nextByte(value)) {
+        return false;
+      }
+      left--;
+      if (key) {
+        memset(buffer + out, value, count);
+      } else if (value) {
+        for (size_t i = 0; i < count; i++) {
+          buffer[out + i] ^= value;
+        }
+      }
+      out += count;
+    }
+  }
+  if (out != length) {
+    return false;
+  }
+
+  _shown++;
+  if (key) {
+    _key = _shown;
+    _keyOffset = _next;
+  }
+  _next = _chunkOffset + _chunkPos;
+  return true;
+}
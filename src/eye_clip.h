@@ -0,0 +1,133 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <U8g2lib.h>
+
+// Short full-screen animations (a yawn, a sneeze, eating) played straight
+// into the U8g2 frame buffer. Built from frame images by
+// tools/eye_clips.py, kept as constexpr arrays in flash (src/eye_clips.h)
+// or as .clip files on a filesystem.
+//
+// Clip format, little-endian:
+//   header   'E' 'C' version(1) flags(0) width height frames(u16) periodMs(u16) reserved(u16)
+//   frames   type(u8) length(u16) payload[length], one after the other
+// Frame bytes are in the U8g2 buffer's layout (pages of 8 rows, one byte
+// per column, top row in bit 0) and packed with PackBits as in
+// src/eye_bitmap.h. A key frame (type 0) is the frame itself; a delta
+// frame (type 1) is the frame XORed with the one before, so the unchanged
+// parts are long zero runs that the player skips without touching the
+// buffer.
+//
+// The player streams the clip through a small fixed chunk buffer and never
+// holds more than the frame on screen, which lives in the display buffer
+// itself. Deltas need the previous frame there, so anything else drawn in
+// between must be reported with invalidate(); the player then decodes
+// again from the last key frame.
+
+const uint8_t EYE_CLIP_VERSION = 1;
+const size_t EYE_CLIP_HEADER_SIZE = 12;
+const size_t EYE_CLIP_FRAME_HEADER_SIZE = 3;
+const size_t EYE_CLIP_CHUNK = 64;
+
+enum EyeClipFrameType {
+  EYE_CLIP_KEY = 0,
+  EYE_CLIP_DELTA = 1
+};
+
+// A clip compiled into flash
+struct EyeClip {
+  const char* name;
+  const uint8_t* data;
+  uint32_t size;
+};
+
+// Where the clip bytes come from
+class ClipSource {
+public:
+  virtual ~ClipSource() {}
+  // Copy up to size bytes from offset; returns how many were copied
+  virtual size_t read(uint32_t offset, uint8_t* data, size_t size) = 0;
+};
+
+class MemoryClipSource : public ClipSource {
+public:
+  MemoryClipSource() : _data(nullptr), _size(0) {}
+  MemoryClipSource(const uint8_t* data, uint32_t size) : _data(data), _size(size) {}
+  explicit MemoryClipSource(const EyeClip& clip) : _data(clip.data), _size(clip.size) {}
+  size_t read(uint32_t offset, uint8_t* data, size_t size) override;
+
+private:
+  const uint8_t* _data;
+  uint32_t _size;
+};
+
+#ifdef ARDUINO
+#include <FS.h>
+
+// A .clip file, e.g. LittleFS.open("/yawn.clip"). The default partition
+// table's data partition belongs to the treat ledger (src/treat_ledger.h),
+// so the filesystem needs a partition of its own.
+class FileClipSource : public ClipSource {
+public:
+  explicit FileClipSource(fs::File& file) : _file(file) {}
+  size_t read(uint32_t offset, uint8_t* data, size_t size) override;
+
+private:
+  fs::File& _file;
+};
+#endif
+
+class ClipPlayer {
+public:
+  ClipPlayer();
+
+  // Start playing from the first frame at time now. Returns false (and
+  // stays stopped) if the header isn't a clip for this display.
+  bool start(ClipSource& source, U8G2& display, uint32_t now);
+  void stop() { _source = nullptr; }
+  bool playing() const { return _source != nullptr; }
+
+  // Bring the display buffer to the frame due at now, decoding any frames
+  // in between. Returns true if the buffer changed. Stops after the last
+  // frame has had its period, or on a malformed frame.
+  bool render(U8G2& display, uint32_t now);
+
+  // The display buffer no longer holds the last frame rendered
+  void invalidate() { _bufferValid = false; }
+
+  uint16_t frameCount() const { return _frames; }
+  uint16_t periodMs() const { return _period; }
+  // Frame in the display buffer, -1 before the first
+  int shownFrame() const { return _shown; }
+
+private:
+  bool decodeNext(uint8_t* buffer, size_t length);
+  void seek(uint32_t offset);
+  bool nextByte(uint8_t& value) {
+    if (_chunkPos == _chunkLength && !fill()) {
+      return false;
+    }
+    value = _chunk[_chunkPos++];
+    return true;
+  }
+  bool fill();
+
+  ClipSource* _source;
+  uint16_t _frames;
+  uint16_t _period;
+  uint32_t _start;
+  bool _bufferValid;
+
+  int _shown;           // frame in the buffer
+  uint32_t _next;       // offset of the frame after it
+  int _key;             // last key frame seen, -1 if none
+  uint32_t _keyOffset;
+
+  // Streaming reader
+  uint8_t _chunk[EYE_CLIP_CHUNK];
+  uint32_t _chunkOffset; // source offset of _chunk[0]
+  size_t _chunkLength;
+  size_t _chunkPos;
+};
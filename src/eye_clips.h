@@ -0,0 +1,313 @@
+#pragma once
+
+// Generated by tools/eye_clips.py from:
+//   yawn=art/clips/yawn
+//   sneeze=art/clips/sneeze
+//   eat=art/clips/eat
+// with 80 ms frames and a key frame every 8. Edit the frames and rerun
+// the tool rather than editing this file.
+
+#include "eye_clip.h"
+
+constexpr uint8_t EYE_CLIP_YAWN_DATA[] = {
+  0x45, 0x43, 0x01, 0x00, 0x80, 0x40, 0x10, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00, 0xa6, 0x00, 0xff,
+  0x00, 0x9c, 0x00, 0x06, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xf8, 0x85, 0xfc, 0x06, 0xf8, 0xf8,
+  0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0x9d, 0x00, 0x06, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xf8, 0x85,
+  0xfc, 0x06, 0xf8, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0xb5, 0x00, 0x02, 0xc0, 0xf0, 0xfc, 0x95,
+  0xff, 0x02, 0xfc, 0xf0, 0xc0, 0x95, 0x00, 0x02, 0xc0, 0xf0, 0xfc, 0x95, 0xff, 0x02, 0xfc, 0xf0,
+  0xc0, 0xb0, 0x00, 0x00, 0xfc, 0x9b, 0xff, 0x00, 0xfc, 0x93, 0x00, 0x00, 0xfc, 0x9b, 0xff, 0x00,
+  0xfc, 0xaf, 0x00, 0x00, 0x3f, 0x9b, 0xff, 0x00, 0x3f, 0x93, 0x00, 0x00, 0x3f, 0x9b, 0xff, 0x00,
+  0x3f, 0xb0, 0x00, 0x02, 0x03, 0x0f, 0x3f, 0x95, 0xff, 0x02, 0x3f, 0x0f, 0x03, 0x95, 0x00, 0x02,
+  0x03, 0x0f, 0x3f, 0x95, 0xff, 0x02, 0x3f, 0x0f, 0x03, 0xb5, 0x00, 0x06, 0x01, 0x03, 0x07, 0x0f,
+  0x0f, 0x1f, 0x1f, 0x85, 0x3f, 0x06, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0x9d, 0x00, 0x06,
+  0x01, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x1f, 0x85, 0x3f, 0x06, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03,
+  0x01, 0xff, 0x00, 0x9c, 0x00, 0x00, 0x96, 0x00, 0xff, 0x00, 0xa2, 0x00, 0x87, 0x80, 0xa9, 0x00,
+  0x87, 0x80, 0xbc, 0x00, 0x06, 0xc0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfe, 0xfe, 0x8b, 0xff, 0x06, 0xfe,
+  0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x97, 0x00, 0x06, 0xc0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfe, 0xfe,
+  0x8b, 0xff, 0x06, 0xfe, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0xb0, 0x00, 0x01, 0xc0, 0xfc, 0x9b,
+  0xff, 0x01, 0xfc, 0xc0, 0x91, 0x00, 0x01, 0xc0, 0xfc, 0x9b, 0xff, 0x01, 0xfc, 0xc0, 0xad, 0x00,
+  0x00, 0x0f, 0x9d, 0xff, 0x00, 0x0f, 0x91, 0x00, 0x00, 0x0f, 0x9d, 0xff, 0x00, 0x0f, 0xaf, 0x00,
+  0x04, 0x03, 0x0f, 0x1f, 0x3f, 0x7f, 0x91, 0xff, 0x04, 0x7f, 0x3f, 0x1f, 0x0f, 0x03, 0x95, 0x00,
+  0x04, 0x03, 0x0f, 0x1f, 0x3f, 0x7f, 0x91, 0xff, 0x04, 0x7f, 0x3f, 0x1f, 0x0f, 0x03, 0xb7, 0x00,
+  0x03, 0x01, 0x01, 0x03, 0x03, 0x87, 0x07, 0x03, 0x03, 0x03, 0x01, 0x01, 0xa1, 0x00, 0x03, 0x01,
+  0x01, 0x03, 0x03, 0x87, 0x07, 0x03, 0x03, 0x03, 0x01, 0x01, 0xff, 0x00, 0x9e, 0x00, 0x00, 0x82,
+  0x00, 0xff, 0x00, 0xff, 0x00, 0x9d, 0x00, 0x01, 0x80, 0x80, 0x83, 0xc0, 0x85, 0xe0, 0x83, 0xc0,
+  0x01, 0x80, 0x80, 0x9f, 0x00, 0x01, 0x80, 0x80, 0x83, 0xc0, 0x85, 0xe0, 0x83, 0xc0, 0x01, 0x80,
+  0x80, 0xb4, 0x00, 0x04, 0xc0, 0xf0, 0xf8, 0xfc, 0xfe, 0x95, 0xff, 0x04, 0xfe, 0xfc, 0xf8, 0xf0,
+  0xc0, 0x91, 0x00, 0x04, 0xc0, 0xf0, 0xf8, 0xfc, 0xfe, 0x95, 0xff, 0x04, 0xfe, 0xfc, 0xf8, 0xf0,
+  0xc0, 0xad, 0x00, 0x00, 0x7f, 0x9d, 0xff, 0x00, 0x7f, 0x91, 0x00, 0x00, 0x7f, 0x9d, 0xff, 0x00,
+  0x7f, 0xaf, 0x00, 0x07, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x1f, 0x3f, 0x3f, 0x8b, 0x7f, 0x07, 0x3f,
+  0x3f, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x95, 0x00, 0x07, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x1f,
+  0x3f, 0x3f, 0x8b, 0x7f, 0x07, 0x3f, 0x3f, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0xff, 0x00, 0xff,
+  0x00, 0x98, 0x00, 0x00, 0x58, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x97, 0x00, 0x00, 0x80,
+  0x82, 0xc0, 0x82, 0xe0, 0x8f, 0xf0, 0x82, 0xe0, 0x82, 0xc0, 0x00, 0x80, 0x93, 0x00, 0x00, 0x80,
+  0x82, 0xc0, 0x82, 0xe0, 0x8f, 0xf0, 0x82, 0xe0, 0x82, 0xc0, 0x00, 0x80, 0xad, 0x00, 0x01, 0x3e,
+  0x7f, 0x9d, 0xff, 0x01, 0x7f, 0x3e, 0x8f, 0x00, 0x01, 0x3e, 0x7f, 0x9d, 0xff, 0x01, 0x7f, 0x3e,
+  0xae, 0x00, 0x82, 0x01, 0x82, 0x03, 0x8f, 0x07, 0x82, 0x03, 0x82, 0x01, 0x95, 0x00, 0x82, 0x01,
+  0x82, 0x03, 0x8f, 0x07, 0x82, 0x03, 0x82, 0x01, 0xff, 0x00, 0xff, 0x00, 0x98, 0x00, 0x00, 0x2c,
+  0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x01, 0x10, 0x38, 0x83, 0x7c,
+  0x97, 0xfe, 0x83, 0x7c, 0x01, 0x38, 0x10, 0x8d, 0x00, 0x01, 0x10, 0x38, 0x83, 0x7c, 0x97, 0xfe,
+  0x83, 0x7c, 0x01, 0x38, 0x10, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x00, 0x30, 0x00,
+  0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x82, 0x30, 0x00, 0x38, 0x87, 0x78,
+  0x8b, 0x7c, 0x87, 0x78, 0x00, 0x38, 0x82, 0x30, 0x8d, 0x00, 0x82, 0x30, 0x00, 0x38, 0x87, 0x78,
+  0x8b, 0x7c, 0x87, 0x78, 0x00, 0x38, 0x82, 0x30, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00,
+  0x00, 0x20, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x85, 0x30, 0x97,
+  0x78, 0x85, 0x30, 0x8d, 0x00, 0x85, 0x30, 0x97, 0x78, 0x85, 0x30, 0xff, 0x00, 0xff, 0x00, 0xff,
+  0x00, 0x94, 0x00, 0x01, 0x10, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x00, 0x20, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff,
+  0x00, 0x94, 0x00, 0x85, 0x30, 0x97, 0x78, 0x85, 0x30, 0x8d, 0x00, 0x85, 0x30, 0x97, 0x78, 0x85,
+  0x30, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x01, 0x10, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x00, 0x30, 0x00, 0xff,
+  0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x82, 0x30, 0x00, 0x38, 0x87, 0x78, 0x8b,
+  0x7c, 0x87, 0x78, 0x00, 0x38, 0x82, 0x30, 0x8d, 0x00, 0x82, 0x30, 0x00, 0x38, 0x87, 0x78, 0x8b,
+  0x7c, 0x87, 0x78, 0x00, 0x38, 0x82, 0x30, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x00,
+  0x2c, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x01, 0x10, 0x38, 0x83,
+  0x7c, 0x97, 0xfe, 0x83, 0x7c, 0x01, 0x38, 0x10, 0x8d, 0x00, 0x01, 0x10, 0x38, 0x83, 0x7c, 0x97,
+  0xfe, 0x83, 0x7c, 0x01, 0x38, 0x10, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x94, 0x00, 0x00, 0x58,
+  0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x97, 0x00, 0x00, 0x80, 0x82, 0xc0, 0x82, 0xe0, 0x8f,
+  0xf0, 0x82, 0xe0, 0x82, 0xc0, 0x00, 0x80, 0x93, 0x00, 0x00, 0x80, 0x82, 0xc0, 0x82, 0xe0, 0x8f,
+  0xf0, 0x82, 0xe0, 0x82, 0xc0, 0x00, 0x80, 0xad, 0x00, 0x01, 0x3e, 0x7f, 0x9d, 0xff, 0x01, 0x7f,
+  0x3e, 0x8f, 0x00, 0x01, 0x3e, 0x7f, 0x9d, 0xff, 0x01, 0x7f, 0x3e, 0xae, 0x00, 0x82, 0x01, 0x82,
+  0x03, 0x8f, 0x07, 0x82, 0x03, 0x82, 0x01, 0x95, 0x00, 0x82, 0x01, 0x82, 0x03, 0x8f, 0x07, 0x82,
+  0x03, 0x82, 0x01, 0xff, 0x00, 0xff, 0x00, 0x98, 0x00, 0x00, 0x82, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0x9d, 0x00, 0x01, 0x80, 0x80, 0x83, 0xc0, 0x85, 0xe0, 0x83, 0xc0, 0x01, 0x80, 0x80, 0x9f, 0x00,
+  0x01, 0x80, 0x80, 0x83, 0xc0, 0x85, 0xe0, 0x83, 0xc0, 0x01, 0x80, 0x80, 0xb4, 0x00, 0x04, 0xc0,
+  0xf0, 0xf8, 0xfc, 0xfe, 0x95, 0xff, 0x04, 0xfe, 0xfc, 0xf8, 0xf0, 0xc0, 0x91, 0x00, 0x04, 0xc0,
+  0xf0, 0xf8, 0xfc, 0xfe, 0x95, 0xff, 0x04, 0xfe, 0xfc, 0xf8, 0xf0, 0xc0, 0xad, 0x00, 0x00, 0x7f,
+  0x9d, 0xff, 0x00, 0x7f, 0x91, 0x00, 0x00, 0x7f, 0x9d, 0xff, 0x00, 0x7f, 0xaf, 0x00, 0x07, 0x03,
+  0x07, 0x0f, 0x0f, 0x1f, 0x1f, 0x3f, 0x3f, 0x8b, 0x7f, 0x07, 0x3f, 0x3f, 0x1f, 0x1f, 0x0f, 0x0f,
+  0x07, 0x03, 0x95, 0x00, 0x07, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x1f, 0x3f, 0x3f, 0x8b, 0x7f, 0x07,
+  0x3f, 0x3f, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0xff, 0x00, 0xff, 0x00, 0x98, 0x00, 0x00, 0x96,
+  0x00, 0xff, 0x00, 0xa2, 0x00, 0x87, 0x80, 0xa9, 0x00, 0x87, 0x80, 0xbc, 0x00, 0x06, 0xc0, 0xe0,
+  0xf0, 0xf8, 0xfc, 0xfe, 0xfe, 0x8b, 0xff, 0x06, 0xfe, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x97,
+  0x00, 0x06, 0xc0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfe, 0xfe, 0x8b, 0xff, 0x06, 0xfe, 0xfe, 0xfc, 0xf8,
+  0xf0, 0xe0, 0xc0, 0xb0, 0x00, 0x01, 0xc0, 0xfc, 0x9b, 0xff, 0x01, 0xfc, 0xc0, 0x91, 0x00, 0x01,
+  0xc0, 0xfc, 0x9b, 0xff, 0x01, 0xfc, 0xc0, 0xad, 0x00, 0x00, 0x0f, 0x9d, 0xff, 0x00, 0x0f, 0x91,
+  0x00, 0x00, 0x0f, 0x9d, 0xff, 0x00, 0x0f, 0xaf, 0x00, 0x04, 0x03, 0x0f, 0x1f, 0x3f, 0x7f, 0x91,
+  0xff, 0x04, 0x7f, 0x3f, 0x1f, 0x0f, 0x03, 0x95, 0x00, 0x04, 0x03, 0x0f, 0x1f, 0x3f, 0x7f, 0x91,
+  0xff, 0x04, 0x7f, 0x3f, 0x1f, 0x0f, 0x03, 0xb7, 0x00, 0x03, 0x01, 0x01, 0x03, 0x03, 0x87, 0x07,
+  0x03, 0x03, 0x03, 0x01, 0x01, 0xa1, 0x00, 0x03, 0x01, 0x01, 0x03, 0x03, 0x87, 0x07, 0x03, 0x03,
+  0x03, 0x01, 0x01, 0xff, 0x00, 0x9e, 0x00, 0x00, 0xa6, 0x00, 0xff, 0x00, 0x9c, 0x00, 0x06, 0x80,
+  0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xf8, 0x85, 0xfc, 0x06, 0xf8, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80,
+  0x9d, 0x00, 0x06, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xf8, 0x85, 0xfc, 0x06, 0xf8, 0xf8, 0xf0,
+  0xf0, 0xe0, 0xc0, 0x80, 0xb5, 0x00, 0x02, 0xc0, 0xf0, 0xfc, 0x95, 0xff, 0x02, 0xfc, 0xf0, 0xc0,
+  0x95, 0x00, 0x02, 0xc0, 0xf0, 0xfc, 0x95, 0xff, 0x02, 0xfc, 0xf0, 0xc0, 0xb0, 0x00, 0x00, 0xfc,
+  0x9b, 0xff, 0x00, 0xfc, 0x93, 0x00, 0x00, 0xfc, 0x9b, 0xff, 0x00, 0xfc, 0xaf, 0x00, 0x00, 0x3f,
+  0x9b, 0xff, 0x00, 0x3f, 0x93, 0x00, 0x00, 0x3f, 0x9b, 0xff, 0x00, 0x3f, 0xb0, 0x00, 0x02, 0x03,
+  0x0f, 0x3f, 0x95, 0xff, 0x02, 0x3f, 0x0f, 0x03, 0x95, 0x00, 0x02, 0x03, 0x0f, 0x3f, 0x95, 0xff,
+  0x02, 0x3f, 0x0f, 0x03, 0xb5, 0x00, 0x06, 0x01, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x1f, 0x85, 0x3f,
+  0x06, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0x9d, 0x00, 0x06, 0x01, 0x03, 0x07, 0x0f, 0x0f,
+  0x1f, 0x1f, 0x85, 0x3f, 0x06, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0xff, 0x00, 0x9c, 0x00,
+};
+
+constexpr uint8_t EYE_CLIP_SNEEZE_DATA[] = {
+  0x45, 0x43, 0x01, 0x00, 0x80, 0x40, 0x0c, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00, 0xa6, 0x00, 0xff,
+  0x00, 0x9c, 0x00, 0x06, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xf8, 0x85, 0xfc, 0x06, 0xf8, 0xf8,
+  0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0x9d, 0x00, 0x06, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xf8, 0x85,
+  0xfc, 0x06, 0xf8, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0xb5, 0x00, 0x02, 0xc0, 0xf0, 0xfc, 0x95,
+  0xff, 0x02, 0xfc, 0xf0, 0xc0, 0x95, 0x00, 0x02, 0xc0, 0xf0, 0xfc, 0x95, 0xff, 0x02, 0xfc, 0xf0,
+  0xc0, 0xb0, 0x00, 0x00, 0xfc, 0x9b, 0xff, 0x00, 0xfc, 0x93, 0x00, 0x00, 0xfc, 0x9b, 0xff, 0x00,
+  0xfc, 0xaf, 0x00, 0x00, 0x3f, 0x9b, 0xff, 0x00, 0x3f, 0x93, 0x00, 0x00, 0x3f, 0x9b, 0xff, 0x00,
+  0x3f, 0xb0, 0x00, 0x02, 0x03, 0x0f, 0x3f, 0x95, 0xff, 0x02, 0x3f, 0x0f, 0x03, 0x95, 0x00, 0x02,
+  0x03, 0x0f, 0x3f, 0x95, 0xff, 0x02, 0x3f, 0x0f, 0x03, 0xb5, 0x00, 0x06, 0x01, 0x03, 0x07, 0x0f,
+  0x0f, 0x1f, 0x1f, 0x85, 0x3f, 0x06, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0x9d, 0x00, 0x06,
+  0x01, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x1f, 0x85, 0x3f, 0x06, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03,
+  0x01, 0xff, 0x00, 0x9c, 0x00, 0x00, 0x6a, 0x00, 0xff, 0x00, 0xff, 0x00, 0x9e, 0x00, 0x82, 0x80,
+  0x89, 0xc0, 0x82, 0x80, 0xa1, 0x00, 0x82, 0x80, 0x89, 0xc0, 0x82, 0x80, 0xb6, 0x00, 0x04, 0xe0,
+  0xf0, 0xfc, 0xfc, 0xfe, 0x93, 0xff, 0x04, 0xfe, 0xfc, 0xfc, 0xf0, 0xe0, 0x93, 0x00, 0x04, 0xe0,
+  0xf0, 0xfc, 0xfc, 0xfe, 0x93, 0xff, 0x04, 0xfe, 0xfc, 0xfc, 0xf0, 0xe0, 0xaf, 0x00, 0x04, 0x07,
+  0x0f, 0x3f, 0x3f, 0x7f, 0x93, 0xff, 0x04, 0x7f, 0x3f, 0x3f, 0x0f, 0x07, 0x93, 0x00, 0x04, 0x07,
+  0x0f, 0x3f, 0x3f, 0x7f, 0x93, 0xff, 0x04, 0x7f, 0x3f, 0x3f, 0x0f, 0x07, 0xb6, 0x00, 0x82, 0x01,
+  0x89, 0x03, 0x82, 0x01, 0xa1, 0x00, 0x82, 0x01, 0x89, 0x03, 0x82, 0x01, 0xff, 0x00, 0xff, 0x00,
+  0x9e, 0x00, 0x00, 0x4e, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x97, 0x00, 0x02, 0x80, 0xc0,
+  0xc0, 0x84, 0xe0, 0x8d, 0xf0, 0x84, 0xe0, 0x02, 0xc0, 0xc0, 0x80, 0x93, 0x00, 0x02, 0x80, 0xc0,
+  0xc0, 0x84, 0xe0, 0x8d, 0xf0, 0x84, 0xe0, 0x02, 0xc0, 0xc0, 0x80, 0xaf, 0x00, 0x02, 0x01, 0x03,
+  0x03, 0x84, 0x07, 0x8d, 0x0f, 0x84, 0x07, 0x02, 0x03, 0x03, 0x01, 0x93, 0x00, 0x02, 0x01, 0x03,
+  0x03, 0x84, 0x07, 0x8d, 0x0f, 0x84, 0x07, 0x02, 0x03, 0x03, 0x01, 0xff, 0x00, 0xff, 0x00, 0xff,
+  0x00, 0x97, 0x00, 0x00, 0x9a, 0x00, 0xff, 0x00, 0xff, 0x00, 0x9a, 0x00, 0x08, 0x60, 0xf0, 0xf0,
+  0xe0, 0xe0, 0xc0, 0xc0, 0x80, 0x80, 0xb7, 0x00, 0x08, 0x80, 0x80, 0xc0, 0xc0, 0xe0, 0xe0, 0xf0,
+  0xf0, 0x60, 0xb8, 0x00, 0x14, 0x01, 0x01, 0x03, 0x03, 0x07, 0x07, 0x0f, 0x0f, 0x1e, 0x1e, 0x3c,
+  0x3c, 0x78, 0x78, 0xf0, 0xf0, 0xe0, 0xe0, 0xc0, 0xc0, 0x80, 0x99, 0x00, 0x14, 0x80, 0xc0, 0xc0,
+  0xe0, 0xe0, 0xf0, 0xf0, 0x78, 0x78, 0x3c, 0x3c, 0x1e, 0x1e, 0x0f, 0x0f, 0x07, 0x07, 0x03, 0x03,
+  0x01, 0x01, 0xbb, 0x00, 0x14, 0x80, 0x80, 0xc0, 0xc0, 0xe0, 0xe0, 0xf0, 0xf0, 0x78, 0x78, 0x3c,
+  0x3c, 0x1e, 0x1e, 0x0f, 0x0f, 0x07, 0x07, 0x03, 0x03, 0x01, 0x99, 0x00, 0x14, 0x01, 0x03, 0x03,
+  0x07, 0x07, 0x0f, 0x0f, 0x1e, 0x1e, 0x3c, 0x3c, 0x78, 0x78, 0xf0, 0xf0, 0xe0, 0xe0, 0xc0, 0xc0,
+  0x80, 0x80, 0xb8, 0x00, 0x08, 0x06, 0x0f, 0x0f, 0x07, 0x07, 0x03, 0x03, 0x01, 0x01, 0xb7, 0x00,
+  0x08, 0x01, 0x01, 0x03, 0x03, 0x07, 0x07, 0x0f, 0x0f, 0x06, 0xff, 0x00, 0xff, 0x00, 0x9a, 0x00,
+  0x00, 0xaa, 0x00, 0xff, 0x00, 0xff, 0x00, 0x98, 0x00, 0x0c, 0x18, 0x3c, 0x3c, 0x78, 0x78, 0xf0,
+  0xf0, 0xe0, 0xe0, 0xc0, 0xc0, 0x80, 0x80, 0xb3, 0x00, 0x0c, 0x80, 0x80, 0xc0, 0xc0, 0xe0, 0xe0,
+  0xf0, 0xf0, 0x78, 0x78, 0x3c, 0x3c, 0x18, 0xb8, 0x00, 0x14, 0x01, 0x01, 0x03, 0x03, 0x07, 0x07,
+  0x0f, 0x0f, 0x1e, 0x1e, 0x3c, 0x3c, 0x78, 0x78, 0xf0, 0xf0, 0xe0, 0xe0, 0xc0, 0xc0, 0x80, 0x95,
+  0x00, 0x14, 0x80, 0xc0, 0xc0, 0xe0, 0xe0, 0xf0, 0xf0, 0x78, 0x78, 0x3c, 0x3c, 0x1e, 0x1e, 0x0f,
+  0x0f, 0x07, 0x07, 0x03, 0x03, 0x01, 0x01, 0xbf, 0x00, 0x14, 0x80, 0x80, 0xc0, 0xc0, 0xe0, 0xe0,
+  0xf0, 0xf0, 0x78, 0x78, 0x3c, 0x3c, 0x1e, 0x1e, 0x0f, 0x0f, 0x07, 0x07, 0x03, 0x03, 0x01, 0x95,
+  0x00, 0x14, 0x01, 0x03, 0x03, 0x07, 0x07, 0x0f, 0x0f, 0x1e, 0x1e, 0x3c, 0x3c, 0x78, 0x78, 0xf0,
+  0xf0, 0xe0, 0xe0, 0xc0, 0xc0, 0x80, 0x80, 0xb8, 0x00, 0x0c, 0x18, 0x3c, 0x3c, 0x1e, 0x1e, 0x0f,
+  0x0f, 0x07, 0x07, 0x03, 0x03, 0x01, 0x01, 0xb3, 0x00, 0x0c, 0x01, 0x01, 0x03, 0x03, 0x07, 0x07,
+  0x0f, 0x0f, 0x1e, 0x1e, 0x3c, 0x3c, 0x18, 0xff, 0x00, 0xff, 0x00, 0x98, 0x00, 0x00, 0xba, 0x00,
+  0xff, 0x00, 0xff, 0x00, 0x96, 0x00, 0x10, 0x06, 0x0f, 0x0f, 0x1e, 0x1e, 0x3c, 0x3c, 0x78, 0x78,
+  0xf0, 0xf0, 0xe0, 0xe0, 0xc0, 0xc0, 0x80, 0x80, 0xaf, 0x00, 0x10, 0x80, 0x80, 0xc0, 0xc0, 0xe0,
+  0xe0, 0xf0, 0xf0, 0x78, 0x78, 0x3c, 0x3c, 0x1e, 0x1e, 0x0f, 0x0f, 0x06, 0xb8, 0x00, 0x14, 0x01,
+  0x01, 0x03, 0x03, 0x07, 0x07, 0x0f, 0x0f, 0x1e, 0x1e, 0x3c, 0x3c, 0x78, 0x78, 0xf0, 0xf0, 0xe0,
+  0xe0, 0xc0, 0xc0, 0x80, 0x91, 0x00, 0x14, 0x80, 0xc0, 0xc0, 0xe0, 0xe0, 0xf0, 0xf0, 0x78, 0x78,
+  0x3c, 0x3c, 0x1e, 0x1e, 0x0f, 0x0f, 0x07, 0x07, 0x03, 0x03, 0x01, 0x01, 0xc3, 0x00, 0x14, 0x80,
+  0x80, 0xc0, 0xc0, 0xe0, 0xe0, 0xf0, 0xf0, 0x78, 0x78, 0x3c, 0x3c, 0x1e, 0x1e, 0x0f, 0x0f, 0x07,
+  0x07, 0x03, 0x03, 0x01, 0x91, 0x00, 0x14, 0x01, 0x03, 0x03, 0x07, 0x07, 0x0f, 0x0f, 0x1e, 0x1e,
+  0x3c, 0x3c, 0x78, 0x78, 0xf0, 0xf0, 0xe0, 0xe0, 0xc0, 0xc0, 0x80, 0x80, 0xb8, 0x00, 0x10, 0x60,
+  0xf0, 0xf0, 0x78, 0x78, 0x3c, 0x3c, 0x1e, 0x1e, 0x0f, 0x0f, 0x07, 0x07, 0x03, 0x03, 0x01, 0x01,
+  0xaf, 0x00, 0x10, 0x01, 0x01, 0x03, 0x03, 0x07, 0x07, 0x0f, 0x0f, 0x1e, 0x1e, 0x3c, 0x3c, 0x78,
+  0x78, 0xf0, 0xf0, 0x60, 0xff, 0x00, 0xff, 0x00, 0x96, 0x00, 0x00, 0xa8, 0x00, 0xff, 0x00, 0x9a,
+  0x00, 0x07, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xfc, 0xfc, 0x83, 0xfe, 0x87, 0xff, 0x83, 0xfe,
+  0x07, 0xfc, 0xfc, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0x91, 0x00, 0x07, 0x80, 0xc0, 0xe0, 0xf0,
+  0xf0, 0xf8, 0xfc, 0xfc, 0x83, 0xfe, 0x87, 0xff, 0x83, 0xfe, 0x07, 0xfc, 0xfc, 0xf8, 0xf0, 0xf0,
+  0xe0, 0xc0, 0x80, 0xaa, 0x00, 0x02, 0xf0, 0xfc, 0xfe, 0x9f, 0xff, 0x02, 0xfe, 0xfc, 0xf0, 0x8b,
+  0x00, 0x02, 0xf0, 0xfc, 0xfe, 0x9f, 0xff, 0x02, 0xfe, 0xfc, 0xf0, 0xa6, 0x00, 0xa7, 0xff, 0x89,
+  0x00, 0xa7, 0xff, 0xa6, 0x00, 0x02, 0x0f, 0x3f, 0x7f, 0x9f, 0xff, 0x02, 0x7f, 0x3f, 0x0f, 0x8b,
+  0x00, 0x02, 0x0f, 0x3f, 0x7f, 0x9f, 0xff, 0x02, 0x7f, 0x3f, 0x0f, 0xaa, 0x00, 0x07, 0x01, 0x03,
+  0x07, 0x0f, 0x0f, 0x1f, 0x3f, 0x3f, 0x83, 0x7f, 0x87, 0xff, 0x83, 0x7f, 0x07, 0x3f, 0x3f, 0x1f,
+  0x0f, 0x0f, 0x07, 0x03, 0x01, 0x91, 0x00, 0x07, 0x01, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x3f, 0x3f,
+  0x83, 0x7f, 0x87, 0xff, 0x83, 0x7f, 0x07, 0x3f, 0x3f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0xff,
+  0x00, 0xff, 0x00, 0x92, 0x00, 0x00, 0xa8, 0x00, 0xff, 0x00, 0x92, 0x00, 0x07, 0x80, 0xc0, 0xe0,
+  0xf0, 0xf0, 0xf8, 0xfc, 0xfc, 0x83, 0xfe, 0x87, 0xff, 0x83, 0xfe, 0x07, 0xfc, 0xfc, 0xf8, 0xf0,
+  0xf0, 0xe0, 0xc0, 0x80, 0x91, 0x00, 0x07, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xfc, 0xfc, 0x83,
+  0xfe, 0x87, 0xff, 0x83, 0xfe, 0x07, 0xfc, 0xfc, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0xaa, 0x00,
+  0x02, 0xf0, 0xfc, 0xfe, 0x9f, 0xff, 0x02, 0xfe, 0xfc, 0xf0, 0x8b, 0x00, 0x02, 0xf0, 0xfc, 0xfe,
+  0x9f, 0xff, 0x02, 0xfe, 0xfc, 0xf0, 0xa6, 0x00, 0xa7, 0xff, 0x89, 0x00, 0xa7, 0xff, 0xa6, 0x00,
+  0x02, 0x0f, 0x3f, 0x7f, 0x9f, 0xff, 0x02, 0x7f, 0x3f, 0x0f, 0x8b, 0x00, 0x02, 0x0f, 0x3f, 0x7f,
+  0x9f, 0xff, 0x02, 0x7f, 0x3f, 0x0f, 0xaa, 0x00, 0x07, 0x01, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x3f,
+  0x3f, 0x83, 0x7f, 0x87, 0xff, 0x83, 0x7f, 0x07, 0x3f, 0x3f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01,
+  0x91, 0x00, 0x07, 0x01, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x3f, 0x3f, 0x83, 0x7f, 0x87, 0xff, 0x83,
+  0x7f, 0x07, 0x3f, 0x3f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0xff, 0x00, 0xff, 0x00, 0x9a, 0x00,
+  0x00, 0xa8, 0x00, 0xff, 0x00, 0x96, 0x00, 0x07, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xfc, 0xfc,
+  0x83, 0xfe, 0x87, 0xff, 0x83, 0xfe, 0x07, 0xfc, 0xfc, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0x91,
+  0x00, 0x07, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xfc, 0xfc, 0x83, 0xfe, 0x87, 0xff, 0x83, 0xfe,
+  0x07, 0xfc, 0xfc, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0xaa, 0x00, 0x02, 0xf0, 0xfc, 0xfe, 0x9f,
+  0xff, 0x02, 0xfe, 0xfc, 0xf0, 0x8b, 0x00, 0x02, 0xf0, 0xfc, 0xfe, 0x9f, 0xff, 0x02, 0xfe, 0xfc,
+  0xf0, 0xa6, 0x00, 0xa7, 0xff, 0x89, 0x00, 0xa7, 0xff, 0xa6, 0x00, 0x02, 0x0f, 0x3f, 0x7f, 0x9f,
+  0xff, 0x02, 0x7f, 0x3f, 0x0f, 0x8b, 0x00, 0x02, 0x0f, 0x3f, 0x7f, 0x9f, 0xff, 0x02, 0x7f, 0x3f,
+  0x0f, 0xaa, 0x00, 0x07, 0x01, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x3f, 0x3f, 0x83, 0x7f, 0x87, 0xff,
+  0x83, 0x7f, 0x07, 0x3f, 0x3f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0x91, 0x00, 0x07, 0x01, 0x03,
+  0x07, 0x0f, 0x0f, 0x1f, 0x3f, 0x3f, 0x83, 0x7f, 0x87, 0xff, 0x83, 0x7f, 0x07, 0x3f, 0x3f, 0x1f,
+  0x0f, 0x0f, 0x07, 0x03, 0x01, 0xff, 0x00, 0xff, 0x00, 0x96, 0x00, 0x00, 0x9e, 0x00, 0xff, 0x00,
+  0x98, 0x00, 0x05, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0x82, 0xfc, 0x89, 0xfe, 0x82, 0xfc, 0x05,
+  0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0x95, 0x00, 0x05, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0x82,
+  0xfc, 0x89, 0xfe, 0x82, 0xfc, 0x05, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0xad, 0x00, 0x03, 0x80,
+  0xf0, 0xfc, 0xfe, 0x9b, 0xff, 0x03, 0xfe, 0xfc, 0xf0, 0x80, 0x8d, 0x00, 0x03, 0x80, 0xf0, 0xfc,
+  0xfe, 0x9b, 0xff, 0x03, 0xfe, 0xfc, 0xf0, 0x80, 0xa9, 0x00, 0xa3, 0xff, 0x8d, 0x00, 0xa3, 0xff,
+  0xa9, 0x00, 0x01, 0x07, 0x3f, 0x9f, 0xff, 0x01, 0x3f, 0x07, 0x8d, 0x00, 0x01, 0x07, 0x3f, 0x9f,
+  0xff, 0x01, 0x3f, 0x07, 0xac, 0x00, 0x05, 0x03, 0x07, 0x0f, 0x1f, 0x3f, 0x7f, 0x91, 0xff, 0x05,
+  0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0x93, 0x00, 0x05, 0x03, 0x07, 0x0f, 0x1f, 0x3f, 0x7f, 0x91,
+  0xff, 0x05, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0xb7, 0x00, 0x82, 0x01, 0x87, 0x03, 0x82, 0x01,
+  0xa3, 0x00, 0x82, 0x01, 0x87, 0x03, 0x82, 0x01, 0xff, 0x00, 0x9f, 0x00, 0x00, 0xb6, 0x00, 0xff,
+  0x00, 0x9a, 0x00, 0x06, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xf8, 0x82, 0xfc, 0x83, 0xfe, 0x82,
+  0xfc, 0x06, 0xf8, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0x99, 0x00, 0x06, 0x80, 0xc0, 0xe0, 0xf0,
+  0xf0, 0xf8, 0xf8, 0x82, 0xfc, 0x83, 0xfe, 0x82, 0xfc, 0x06, 0xf8, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0,
+  0x80, 0xb1, 0x00, 0x03, 0x80, 0xf0, 0xfc, 0xfe, 0x97, 0xff, 0x03, 0xfe, 0xfc, 0xf0, 0x80, 0x91,
+  0x00, 0x03, 0x80, 0xf0, 0xfc, 0xfe, 0x97, 0xff, 0x03, 0xfe, 0xfc, 0xf0, 0x80, 0xac, 0x00, 0x00,
+  0xf0, 0x9f, 0xff, 0x00, 0xf0, 0x8f, 0x00, 0x00, 0xf0, 0x9f, 0xff, 0x00, 0xf0, 0xab, 0x00, 0x01,
+  0x03, 0x7f, 0x9d, 0xff, 0x01, 0x7f, 0x03, 0x8f, 0x00, 0x01, 0x03, 0x7f, 0x9d, 0xff, 0x01, 0x7f,
+  0x03, 0xad, 0x00, 0x04, 0x01, 0x07, 0x1f, 0x3f, 0x7f, 0x93, 0xff, 0x04, 0x7f, 0x3f, 0x1f, 0x07,
+  0x01, 0x93, 0x00, 0x04, 0x01, 0x07, 0x1f, 0x3f, 0x7f, 0x93, 0xff, 0x04, 0x7f, 0x3f, 0x1f, 0x07,
+  0x01, 0xb5, 0x00, 0x04, 0x01, 0x03, 0x03, 0x07, 0x07, 0x87, 0x0f, 0x04, 0x07, 0x07, 0x03, 0x03,
+  0x01, 0x9f, 0x00, 0x04, 0x01, 0x03, 0x03, 0x07, 0x07, 0x87, 0x0f, 0x04, 0x07, 0x07, 0x03, 0x03,
+  0x01, 0xff, 0x00, 0x9d, 0x00, 0x00, 0xa6, 0x00, 0xff, 0x00, 0x9c, 0x00, 0x06, 0x80, 0xc0, 0xe0,
+  0xf0, 0xf0, 0xf8, 0xf8, 0x85, 0xfc, 0x06, 0xf8, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0x9d, 0x00,
+  0x06, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xf8, 0x85, 0xfc, 0x06, 0xf8, 0xf8, 0xf0, 0xf0, 0xe0,
+  0xc0, 0x80, 0xb5, 0x00, 0x02, 0xc0, 0xf0, 0xfc, 0x95, 0xff, 0x02, 0xfc, 0xf0, 0xc0, 0x95, 0x00,
+  0x02, 0xc0, 0xf0, 0xfc, 0x95, 0xff, 0x02, 0xfc, 0xf0, 0xc0, 0xb0, 0x00, 0x00, 0xfc, 0x9b, 0xff,
+  0x00, 0xfc, 0x93, 0x00, 0x00, 0xfc, 0x9b, 0xff, 0x00, 0xfc, 0xaf, 0x00, 0x00, 0x3f, 0x9b, 0xff,
+  0x00, 0x3f, 0x93, 0x00, 0x00, 0x3f, 0x9b, 0xff, 0x00, 0x3f, 0xb0, 0x00, 0x02, 0x03, 0x0f, 0x3f,
+  0x95, 0xff, 0x02, 0x3f, 0x0f, 0x03, 0x95, 0x00, 0x02, 0x03, 0x0f, 0x3f, 0x95, 0xff, 0x02, 0x3f,
+  0x0f, 0x03, 0xb5, 0x00, 0x06, 0x01, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x1f, 0x85, 0x3f, 0x06, 0x1f,
+  0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0x9d, 0x00, 0x06, 0x01, 0x03, 0x07, 0x0f, 0x0f, 0x1f, 0x1f,
+  0x85, 0x3f, 0x06, 0x1f, 0x1f, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0xff, 0x00, 0x9c, 0x00,
+};
+
+constexpr uint8_t EYE_CLIP_EAT_DATA[] = {
+  0x45, 0x43, 0x01, 0x00, 0x80, 0x40, 0x0c, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00, 0x72, 0x00, 0xff,
+  0x00, 0xff, 0x00, 0xff, 0x00, 0x97, 0x00, 0x0b, 0x80, 0xe0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfc, 0xfe,
+  0x7e, 0x7e, 0x3f, 0x3f, 0x85, 0x1f, 0x0b, 0x3f, 0x3f, 0x7e, 0x7e, 0xfe, 0xfc, 0xfc, 0xf8, 0xf0,
+  0xe0, 0xe0, 0x80, 0x93, 0x00, 0x0b, 0x80, 0xe0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfc, 0xfe, 0x7e, 0x7e,
+  0x3f, 0x3f, 0x85, 0x1f, 0x0b, 0x3f, 0x3f, 0x7e, 0x7e, 0xfe, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0xe0,
+  0x80, 0xad, 0x00, 0x00, 0x78, 0x84, 0x7f, 0x02, 0x0f, 0x03, 0x01, 0x8f, 0x00, 0x02, 0x01, 0x03,
+  0x0f, 0x84, 0x7f, 0x00, 0x78, 0x8f, 0x00, 0x00, 0x78, 0x84, 0x7f, 0x02, 0x0f, 0x03, 0x01, 0x8f,
+  0x00, 0x02, 0x01, 0x03, 0x0f, 0x84, 0x7f, 0x00, 0x78, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x95,
+  0x00, 0x00, 0x8f, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x9a, 0x00, 0x03, 0x80, 0xc0, 0xe0,
+  0xe0, 0x82, 0xf0, 0x89, 0xf8, 0x82, 0xf0, 0x03, 0xe0, 0xe0, 0xc0, 0x80, 0x99, 0x00, 0x03, 0x80,
+  0xc0, 0xe0, 0xe0, 0x82, 0xf0, 0x89, 0xf8, 0x82, 0xf0, 0x03, 0xe0, 0xe0, 0xc0, 0x80, 0xb0, 0x00,
+  0x02, 0xc0, 0xf8, 0xfc, 0x82, 0xff, 0x07, 0x7f, 0x1f, 0x0f, 0x07, 0x03, 0x03, 0x01, 0x01, 0x85,
+  0x00, 0x07, 0x01, 0x01, 0x03, 0x03, 0x07, 0x0f, 0x1f, 0x7f, 0x82, 0xff, 0x02, 0xfc, 0xf8, 0xc0,
+  0x8f, 0x00, 0x02, 0xc0, 0xf8, 0xfc, 0x82, 0xff, 0x07, 0x7f, 0x1f, 0x0f, 0x07, 0x03, 0x03, 0x01,
+  0x01, 0x85, 0x00, 0x07, 0x01, 0x01, 0x03, 0x03, 0x07, 0x0f, 0x1f, 0x7f, 0x82, 0xff, 0x02, 0xfc,
+  0xf8, 0xc0, 0xab, 0x00, 0x85, 0x03, 0x95, 0x00, 0x85, 0x03, 0x8f, 0x00, 0x85, 0x03, 0x95, 0x00,
+  0x85, 0x03, 0xd1, 0x00, 0x01, 0x30, 0x30, 0x87, 0x00, 0x01, 0x0c, 0x0c, 0xf9, 0x00, 0x01, 0x03,
+  0x03, 0xbb, 0x00, 0x01, 0x23, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0xff, 0x00, 0xbb, 0x00, 0x02, 0x30, 0x28, 0x18, 0x83, 0x00, 0x05, 0x80, 0x80, 0x00, 0x0c, 0x0a,
+  0x06, 0xf8, 0x00, 0x02, 0x03, 0x02, 0x01, 0xba, 0x00, 0x00, 0x72, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0xff, 0x00, 0x97, 0x00, 0x0b, 0x80, 0xe0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfc, 0xfe, 0x7e, 0x7e, 0x3f,
+  0x3f, 0x85, 0x1f, 0x0b, 0x3f, 0x3f, 0x7e, 0x7e, 0xfe, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0xe0, 0x80,
+  0x93, 0x00, 0x0b, 0x80, 0xe0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfc, 0xfe, 0x7e, 0x7e, 0x3f, 0x3f, 0x85,
+  0x1f, 0x0b, 0x3f, 0x3f, 0x7e, 0x7e, 0xfe, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0xe0, 0x80, 0xad, 0x00,
+  0x00, 0x78, 0x84, 0x7f, 0x02, 0x0f, 0x03, 0x01, 0x8f, 0x00, 0x02, 0x01, 0x03, 0x0f, 0x84, 0x7f,
+  0x00, 0x78, 0x8f, 0x00, 0x00, 0x78, 0x84, 0x7f, 0x02, 0x0f, 0x03, 0x01, 0x8f, 0x00, 0x02, 0x01,
+  0x03, 0x0f, 0x84, 0x7f, 0x00, 0x78, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x95, 0x00, 0x00, 0x80,
+  0x00, 0xff, 0x00, 0xff, 0x00, 0x9c, 0x00, 0x01, 0x80, 0x80, 0x82, 0xc0, 0x89, 0xe0, 0x82, 0xc0,
+  0x01, 0x80, 0x80, 0x9d, 0x00, 0x01, 0x80, 0x80, 0x82, 0xc0, 0x89, 0xe0, 0x82, 0xc0, 0x01, 0x80,
+  0x80, 0xb3, 0x00, 0x0c, 0xe0, 0xf0, 0xfc, 0xfc, 0xfe, 0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x0f, 0x07,
+  0x07, 0x85, 0x03, 0x0c, 0x07, 0x07, 0x0f, 0x0f, 0x1f, 0x3f, 0x7f, 0xff, 0xfe, 0xfc, 0xfc, 0xf0,
+  0xe0, 0x91, 0x00, 0x0c, 0xe0, 0xf0, 0xfc, 0xfc, 0xfe, 0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x0f, 0x07,
+  0x07, 0x85, 0x03, 0x0c, 0x07, 0x07, 0x0f, 0x0f, 0x1f, 0x3f, 0x7f, 0xff, 0xfe, 0xfc, 0xfc, 0xf0,
+  0xe0, 0xac, 0x00, 0x85, 0x0f, 0x00, 0x01, 0x93, 0x00, 0x00, 0x01, 0x85, 0x0f, 0x8f, 0x00, 0x85,
+  0x0f, 0x00, 0x01, 0x93, 0x00, 0x00, 0x01, 0x85, 0x0f, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x95,
+  0x00, 0x01, 0x10, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0xff, 0x00, 0xff, 0x00, 0x00, 0x72, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x97, 0x00, 0x0b,
+  0x80, 0xe0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfc, 0xfe, 0x7e, 0x7e, 0x3f, 0x3f, 0x85, 0x1f, 0x0b, 0x3f,
+  0x3f, 0x7e, 0x7e, 0xfe, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0xe0, 0x80, 0x93, 0x00, 0x0b, 0x80, 0xe0,
+  0xe0, 0xf0, 0xf8, 0xfc, 0xfc, 0xfe, 0x7e, 0x7e, 0x3f, 0x3f, 0x85, 0x1f, 0x0b, 0x3f, 0x3f, 0x7e,
+  0x7e, 0xfe, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0xe0, 0x80, 0xad, 0x00, 0x00, 0x78, 0x84, 0x7f, 0x02,
+  0x0f, 0x03, 0x01, 0x8f, 0x00, 0x02, 0x01, 0x03, 0x0f, 0x84, 0x7f, 0x00, 0x78, 0x8f, 0x00, 0x00,
+  0x78, 0x84, 0x7f, 0x02, 0x0f, 0x03, 0x01, 0x8f, 0x00, 0x02, 0x01, 0x03, 0x0f, 0x84, 0x7f, 0x00,
+  0x78, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x95, 0x00, 0x00, 0x8f, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0xff, 0x00, 0x9a, 0x00, 0x03, 0x80, 0xc0, 0xe0, 0xe0, 0x82, 0xf0, 0x89, 0xf8, 0x82, 0xf0, 0x03,
+  0xe0, 0xe0, 0xc0, 0x80, 0x99, 0x00, 0x03, 0x80, 0xc0, 0xe0, 0xe0, 0x82, 0xf0, 0x89, 0xf8, 0x82,
+  0xf0, 0x03, 0xe0, 0xe0, 0xc0, 0x80, 0xb0, 0x00, 0x02, 0xc0, 0xf8, 0xfc, 0x82, 0xff, 0x07, 0x7f,
+  0x1f, 0x0f, 0x07, 0x03, 0x03, 0x01, 0x01, 0x85, 0x00, 0x07, 0x01, 0x01, 0x03, 0x03, 0x07, 0x0f,
+  0x1f, 0x7f, 0x82, 0xff, 0x02, 0xfc, 0xf8, 0xc0, 0x8f, 0x00, 0x02, 0xc0, 0xf8, 0xfc, 0x82, 0xff,
+  0x07, 0x7f, 0x1f, 0x0f, 0x07, 0x03, 0x03, 0x01, 0x01, 0x85, 0x00, 0x07, 0x01, 0x01, 0x03, 0x03,
+  0x07, 0x0f, 0x1f, 0x7f, 0x82, 0xff, 0x02, 0xfc, 0xf8, 0xc0, 0xab, 0x00, 0x85, 0x03, 0x95, 0x00,
+  0x85, 0x03, 0x8f, 0x00, 0x85, 0x03, 0x95, 0x00, 0x85, 0x03, 0xd1, 0x00, 0x01, 0x30, 0x30, 0x87,
+  0x00, 0x01, 0x0c, 0x0c, 0xf9, 0x00, 0x01, 0x03, 0x03, 0xbb, 0x00, 0x00, 0x93, 0x00, 0xff, 0x00,
+  0xff, 0x00, 0xff, 0x00, 0x9a, 0x00, 0x03, 0x80, 0xc0, 0xe0, 0xe0, 0x82, 0xf0, 0x89, 0xf8, 0x82,
+  0xf0, 0x03, 0xe0, 0xe0, 0xc0, 0x80, 0x99, 0x00, 0x03, 0x80, 0xc0, 0xe0, 0xe0, 0x82, 0xf0, 0x89,
+  0xf8, 0x82, 0xf0, 0x03, 0xe0, 0xe0, 0xc0, 0x80, 0xb0, 0x00, 0x02, 0xc0, 0xf8, 0xfc, 0x82, 0xff,
+  0x07, 0x7f, 0x1f, 0x0f, 0x07, 0x03, 0x03, 0x01, 0x01, 0x85, 0x00, 0x07, 0x01, 0x01, 0x03, 0x03,
+  0x07, 0x0f, 0x1f, 0x7f, 0x82, 0xff, 0x02, 0xfc, 0xf8, 0xc0, 0x8f, 0x00, 0x02, 0xc0, 0xf8, 0xfc,
+  0x82, 0xff, 0x07, 0x7f, 0x1f, 0x0f, 0x07, 0x03, 0x03, 0x01, 0x01, 0x85, 0x00, 0x07, 0x01, 0x01,
+  0x03, 0x03, 0x07, 0x0f, 0x1f, 0x7f, 0x82, 0xff, 0x02, 0xfc, 0xf8, 0xc0, 0xab, 0x00, 0x85, 0x03,
+  0x95, 0x00, 0x85, 0x03, 0x8f, 0x00, 0x85, 0x03, 0x95, 0x00, 0x85, 0x03, 0xd2, 0x00, 0x01, 0x18,
+  0x18, 0x83, 0x00, 0x05, 0x80, 0x80, 0x00, 0x00, 0x06, 0x06, 0xf9, 0x00, 0x01, 0x01, 0x01, 0xba,
+  0x00, 0x00, 0x72, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x97, 0x00, 0x0b, 0x80, 0xe0, 0xe0,
+  0xf0, 0xf8, 0xfc, 0xfc, 0xfe, 0x7e, 0x7e, 0x3f, 0x3f, 0x85, 0x1f, 0x0b, 0x3f, 0x3f, 0x7e, 0x7e,
+  0xfe, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0xe0, 0x80, 0x93, 0x00, 0x0b, 0x80, 0xe0, 0xe0, 0xf0, 0xf8,
+  0xfc, 0xfc, 0xfe, 0x7e, 0x7e, 0x3f, 0x3f, 0x85, 0x1f, 0x0b, 0x3f, 0x3f, 0x7e, 0x7e, 0xfe, 0xfc,
+  0xfc, 0xf8, 0xf0, 0xe0, 0xe0, 0x80, 0xad, 0x00, 0x00, 0x78, 0x84, 0x7f, 0x02, 0x0f, 0x03, 0x01,
+  0x8f, 0x00, 0x02, 0x01, 0x03, 0x0f, 0x84, 0x7f, 0x00, 0x78, 0x8f, 0x00, 0x00, 0x78, 0x84, 0x7f,
+  0x02, 0x0f, 0x03, 0x01, 0x8f, 0x00, 0x02, 0x01, 0x03, 0x0f, 0x84, 0x7f, 0x00, 0x78, 0xff, 0x00,
+  0xff, 0x00, 0xff, 0x00, 0x95, 0x00, 0x00, 0x80, 0x00, 0xff, 0x00, 0xff, 0x00, 0x9c, 0x00, 0x01,
+  0x80, 0x80, 0x82, 0xc0, 0x89, 0xe0, 0x82, 0xc0, 0x01, 0x80, 0x80, 0x9d, 0x00, 0x01, 0x80, 0x80,
+  0x82, 0xc0, 0x89, 0xe0, 0x82, 0xc0, 0x01, 0x80, 0x80, 0xb3, 0x00, 0x0c, 0xe0, 0xf0, 0xfc, 0xfc,
+  0xfe, 0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x0f, 0x07, 0x07, 0x85, 0x03, 0x0c, 0x07, 0x07, 0x0f, 0x0f,
+  0x1f, 0x3f, 0x7f, 0xff, 0xfe, 0xfc, 0xfc, 0xf0, 0xe0, 0x91, 0x00, 0x0c, 0xe0, 0xf0, 0xfc, 0xfc,
+  0xfe, 0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x0f, 0x07, 0x07, 0x85, 0x03, 0x0c, 0x07, 0x07, 0x0f, 0x0f,
+  0x1f, 0x3f, 0x7f, 0xff, 0xfe, 0xfc, 0xfc, 0xf0, 0xe0, 0xac, 0x00, 0x85, 0x0f, 0x00, 0x01, 0x93,
+  0x00, 0x00, 0x01, 0x85, 0x0f, 0x8f, 0x00, 0x85, 0x0f, 0x00, 0x01, 0x93, 0x00, 0x00, 0x01, 0x85,
+  0x0f, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x95, 0x00, 0x01, 0x10, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+};
+
+constexpr EyeClip EYE_CLIPS[] = {
+  {"yawn", EYE_CLIP_YAWN_DATA, sizeof(EYE_CLIP_YAWN_DATA)},
+  {"sneeze", EYE_CLIP_SNEEZE_DATA, sizeof(EYE_CLIP_SNEEZE_DATA)},
+  {"eat", EYE_CLIP_EAT_DATA, sizeof(EYE_CLIP_EAT_DATA)},
+};
+constexpr int EYE_CLIP_COUNT = sizeof(EYE_CLIPS) / sizeof(EYE_CLIPS[0]);
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <U8g2lib.h>
+
+// The display a sketch is built for, picked at compile time: controller,
+// resolution and bus. Each supported combination maps to its U8g2 class
+// and bus clock, and everything the engine draws is laid out from the
+// resolution here, so nothing is looked up while drawing:
+//
+//   typedef EyeDisplay<EYE_SH1107, 128, 128, EYE_SPI> Display;  // or EyeSh1107Spi
+//   Display::Panel u8g2(U8G2_R0, /* cs=*/ 5, /* dc=*/ 16, /* reset=*/ 17);
+//   EyeEngine<Features, Display> eyes(u8g2, clock);
+//
+// An unsupported combination doesn't compile. I2C panels take (rotation,
+// reset[, clock, data]), SPI ones (rotation, cs, dc[, reset]), as in U8g2.
+// EyePaged<Display> is the same panel drawn a page at a time; one panel
+// per eye is src/eye_dual.h.
+
+enum EyeController {
+  EYE_SSD1306,
+  EYE_SH1106,   // 132-column RAM, U8g2 centres the 128 visible columns
+  EYE_SH1107
+};
+
+enum EyeBus {
+  EYE_I2C,
+  EYE_I2C_2ND,  // the ESP32's second I2C controller (Wire1)
+  EYE_SPI
+};
+
+template <EyeController Controller, int Width, int Height, EyeBus Bus>
+struct EyeDisplay;
+
+// What every panel has in common; busHz is U8g2's default clock for the
+// controller on that bus
+template <EyeController Controller, int Width, int Height, EyeBus Bus, uint32_t BusHz>
+struct EyeDisplayTraits {
+  static constexpr int panels = 1;
+  static constexpr bool paged = false;
+  static constexpr int bufferBytes = Width * Height / 8;
+  static constexpr EyeController controller = Controller;
+  static constexpr EyeBus bus = Bus;
+  static constexpr int width = Width;
+  static constexpr int height = Height;
+  static constexpr uint32_t busHz = BusHz;
+
+  // Time to send a whole frame at busHz: a page at a time, each with a
+  // few bytes of addressing, and I2C's ack bit on every byte. Only a
+  // guide; the real figure is in the I2C scheduler's /bus report.
+  static constexpr uint32_t pageBytes = Width + 8;
+  static constexpr uint32_t frameMicros =
+      (uint32_t)((uint64_t)(Height / 8) * pageBytes * (Bus == EYE_SPI ? 8 : 9) * 1000000 / BusHz);
+};
+
+template <>
+struct EyeDisplay<EYE_SSD1306, 128, 64, EYE_I2C> : EyeDisplayTraits<EYE_SSD1306, 128, 64, EYE_I2C, 400000> {
+  typedef U8G2_SSD1306_128X64_NONAME_F_HW_I2C Panel;
+  typedef U8G2_SSD1306_128X64_NONAME_1_HW_I2C PagePanel;
+};
+
+template <>
+struct EyeDisplay<EYE_SSD1306, 128, 64, EYE_SPI> : EyeDisplayTraits<EYE_SSD1306, 128, 64, EYE_SPI, 8000000> {
+  typedef U8G2_SSD1306_128X64_NONAME_F_4W_HW_SPI Panel;
+  typedef U8G2_SSD1306_128X64_NONAME_1_4W_HW_SPI PagePanel;
+};
+
+template <>
+struct EyeDisplay<EYE_SSD1306, 128, 64, EYE_I2C_2ND> : EyeDisplayTraits<EYE_SSD1306, 128, 64, EYE_I2C_2ND, 400000> {
+  typedef U8G2_SSD1306_128X64_NONAME_F_2ND_HW_I2C Panel;
+  typedef U8G2_SSD1306_128X64_NONAME_1_2ND_HW_I2C PagePanel;
+};
+
+template <>
+struct EyeDisplay<EYE_SH1106, 128, 64, EYE_I2C> : EyeDisplayTraits<EYE_SH1106, 128, 64, EYE_I2C, 400000> {
+  typedef U8G2_SH1106_128X64_NONAME_F_HW_I2C Panel;
+  typedef U8G2_SH1106_128X64_NONAME_1_HW_I2C PagePanel;
+};
+
+template <>
+struct EyeDisplay<EYE_SH1106, 128, 64, EYE_SPI> : EyeDisplayTraits<EYE_SH1106, 128, 64, EYE_SPI, 4000000> {
+  typedef U8G2_SH1106_128X64_NONAME_F_4W_HW_SPI Panel;
+  typedef U8G2_SH1106_128X64_NONAME_1_4W_HW_SPI PagePanel;
+};
+
+template <>
+struct EyeDisplay<EYE_SH1106, 128, 64, EYE_I2C_2ND> : EyeDisplayTraits<EYE_SH1106, 128, 64, EYE_I2C_2ND, 400000> {
+  typedef U8G2_SH1106_128X64_NONAME_F_2ND_HW_I2C Panel;
+  typedef U8G2_SH1106_128X64_NONAME_1_2ND_HW_I2C PagePanel;
+};
+
+template <>
+struct EyeDisplay<EYE_SH1107, 128, 128, EYE_I2C> : EyeDisplayTraits<EYE_SH1107, 128, 128, EYE_I2C, 400000> {
+  typedef U8G2_SH1107_128X128_F_HW_I2C Panel;
+  typedef U8G2_SH1107_128X128_1_HW_I2C PagePanel;
+};
+
+template <>
+struct EyeDisplay<EYE_SH1107, 128, 128, EYE_SPI> : EyeDisplayTraits<EYE_SH1107, 128, 128, EYE_SPI, 4000000> {
+  typedef U8G2_SH1107_128X128_F_4W_HW_SPI Panel;
+  typedef U8G2_SH1107_128X128_1_4W_HW_SPI PagePanel;
+};
+
+typedef EyeDisplay<EYE_SSD1306, 128, 64, EYE_I2C> EyeSsd1306I2c;
+typedef EyeDisplay<EYE_SSD1306, 128, 64, EYE_I2C_2ND> EyeSsd1306I2c2;
+typedef EyeDisplay<EYE_SSD1306, 128, 64, EYE_SPI> EyeSsd1306Spi;
+typedef EyeDisplay<EYE_SH1106, 128, 64, EYE_I2C> EyeSh1106I2c;
+typedef EyeDisplay<EYE_SH1106, 128, 64, EYE_I2C_2ND> EyeSh1106I2c2;
+typedef EyeDisplay<EYE_SH1106, 128, 64, EYE_SPI> EyeSh1106Spi;
+typedef EyeDisplay<EYE_SH1107, 128, 128, EYE_I2C> EyeSh1107I2c;
+typedef EyeDisplay<EYE_SH1107, 128, 128, EYE_SPI> EyeSh1107Spi;
+
+// The same panel with U8g2's page buffer (the _1_ classes): one page of
+// RAM instead of the whole frame, for builds short of it. The engine
+// describes each frame as a display list (src/eye_scene.h) and rasterizes
+// every page against the primitives that reach into it. Full-screen
+// bitmaps (artwork, clips) need the whole buffer, so they aren't
+// available, and Features::flush isn't called: the page loop sends.
+template <typename Full>
+struct EyePaged : Full {
+  static constexpr bool paged = true;
+  static constexpr int bufferBytes = Full::width;
+  typedef typename Full::PagePanel Panel;
+};
+
+// The face is designed on 128x64: the eye sizes in src/pet_behavior.h, the
+// look offsets and the star positions. A panel shows a window of it (all
+// of it, unless each eye has its own panel) scaled by the largest factor
+// that fits and centred; for the whole face on 128x64 it all folds away
+// and the frames are exactly the designed ones.
+const int EYE_FACE_WIDTH = 128;
+const int EYE_FACE_HEIGHT = 64;
+
+template <typename Display, int Left = 0, int Top = 0, int Width = EYE_FACE_WIDTH, int Height = EYE_FACE_HEIGHT>
+struct EyeGeometry {
+  static constexpr float scale = (float)Display::width / Width < (float)Display::height / Height
+                                     ? (float)Display::width / Width
+                                     : (float)Display::height / Height;
+  static constexpr float originX = (Display::width - Width * scale) / 2;
+  static constexpr float originY = (Display::height - Height * scale) / 2;
+
+  // Face coordinates and lengths to panel pixels
+  static constexpr float x(float faceX) { return originX + (faceX - Left) * scale; }
+  static constexpr float y(float faceY) { return originY + (faceY - Top) * scale; }
+  static constexpr float size(float faceSize) { return faceSize * scale; }
+  static constexpr bool shows(int faceX, int faceY) {
+    return faceX >= Left && faceX < Left + Width && faceY >= Top && faceY < Top + Height;
+  }
+};
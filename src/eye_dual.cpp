@@ -0,0 +1,116 @@
+#include "eye_dual.h"
+
+#include <Arduino.h>
+
+EyeDualPanel::EyeDualPanel(U8G2& left, U8G2& right)
+    : _left(left), _right(right), _flush(nullptr), _rightDoneUs(0), _lastSkewUs(0), _worstSkewUs(0) {
+#ifdef ARDUINO
+  _task = nullptr;
+  _done = nullptr;
+#else
+  _pending = false;
+  _rightSent = false;
+  _quit = false;
+#endif
+}
+
+void EyeDualPanel::flushRight() {
+  _flush(_right);
+  _rightDoneUs = micros();
+}
+
+void EyeDualPanel::flush(Flush flush) {
+  _flush = flush;
+#ifdef ARDUINO
+  if (!_task) {
+    flush(_left);
+    flush(_right);
+    return;
+  }
+  xTaskNotifyGive(_task);
+  flush(_left);
+  uint32_t leftDoneUs = micros();
+  xSemaphoreTake(_done, portMAX_DELAY);
+#else
+  if (!_thread.joinable()) {
+    flush(_left);
+    flush(_right);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> hold(_lock);
+    _pending = true;
+    _rightSent = false;
+  }
+  _wake.notify_all();
+  flush(_left);
+  uint32_t leftDoneUs = micros();
+  {
+    std::unique_lock<std::mutex> hold(_lock);
+    _wake.wait(hold, [this] { return _rightSent; });
+  }
+#endif
+  _lastSkewUs = leftDoneUs > _rightDoneUs ? leftDoneUs - _rightDoneUs : _rightDoneUs - leftDoneUs;
+  if (_lastSkewUs > _worstSkewUs) {
+    _worstSkewUs = _lastSkewUs;
+  }
+}
+
+#ifdef ARDUINO
+EyeDualPanel::~EyeDualPanel() {}
+
+void EyeDualPanel::helperTask(void* self) {
+  EyeDualPanel* panels = (EyeDualPanel*)self;
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    panels->flushRight();
+    xSemaphoreGive(panels->_done);
+  }
+}
+
+void EyeDualPanel::begin() {
+  _left.begin();
+  _right.begin();
+  if (_task) {
+    return;
+  }
+  _done = xSemaphoreCreateBinary();
+  // On the protocol core, clear of loop(); the task mostly waits on the
+  // I2C interrupt, so WiFi hardly notices it. Above the log drain.
+  xTaskCreatePinnedToCore(helperTask, "eye", 3072, this, 2, &_task, 0);
+}
+#else
+EyeDualPanel::~EyeDualPanel() {
+  if (_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> hold(_lock);
+      _quit = true;
+    }
+    _wake.notify_all();
+    _thread.join();
+  }
+}
+
+void EyeDualPanel::begin() {
+  _left.begin();
+  _right.begin();
+  if (_thread.joinable()) {
+    return;
+  }
+  _thread = std::thread([this] {
+    std::unique_lock<std::mutex> hold(_lock);
+    while (true) {
+      _wake.wait(hold, [this] { return _pending || _quit; });
+      if (_quit) {
+        return;
+      }
+      _pending = false;
+      hold.unlock();
+      flushRight();
+      hold.lock();
+      _rightSent = true;
+      _wake.notify_all();
+    }
+  });
+}
+#endif
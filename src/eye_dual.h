@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <U8g2lib.h>
+
+#include "eye_display.h"
+
+#ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// One panel per eye, for costumes where the eyes sit apart. Each panel
+// shows its eye centred on a window of the face half as wide (stars go to
+// whichever panel their half of the face is on), and the two are sent at
+// once, each on its own bus: the right one from a helper task on the
+// other core while loop() sends the left. flush() returns only when both
+// are out, so the eyes never show different frames and a frame costs one
+// panel's bus time, as with a single display.
+//
+//   typedef EyeDualDisplay<EyeSsd1306I2c, EyeSsd1306I2c2> Display;
+//   EyeSsd1306I2c::Panel leftEye(U8G2_R0);      // Wire
+//   EyeSsd1306I2c2::Panel rightEye(U8G2_R0);    // Wire1
+//   Display::Panel panels(leftEye, rightEye);
+//   EyeEngine<Features, Display> eyes(panels, clock);
+//   ...
+//   Wire1.begin(SDA1, SCL1);
+//   panels.begin();                             // instead of u8g2.begin()
+//
+// The artwork and clips are whole-face images, so they need one panel.
+
+class EyeDualPanel {
+public:
+  typedef void (*Flush)(U8G2& panel);
+
+  EyeDualPanel(U8G2& left, U8G2& right);
+  ~EyeDualPanel();
+
+  // Start both panels and the helper task
+  void begin();
+
+  U8G2& left() { return _left; }
+  U8G2& right() { return _right; }
+
+  // Send both buffers with flush, in parallel; returns once both are sent
+  void flush(Flush flush);
+
+  // How far apart the two panels finished the last frame, and the worst
+  // so far
+  uint32_t lastSkewUs() const { return _lastSkewUs; }
+  uint32_t worstSkewUs() const { return _worstSkewUs; }
+
+private:
+  void flushRight();
+
+  U8G2& _left;
+  U8G2& _right;
+  Flush _flush;
+  uint32_t _rightDoneUs;
+  uint32_t _lastSkewUs;
+  uint32_t _worstSkewUs;
+
+#ifdef ARDUINO
+  static void helperTask(void* self);
+  TaskHandle_t _task;
+  SemaphoreHandle_t _done;
+#else
+  std::thread _thread;
+  std::mutex _lock;
+  std::condition_variable _wake;
+  bool _pending;
+  bool _rightSent;
+  bool _quit;
+#endif
+};
+
+// Two panels of the same size as one display for EyeEngine. Each needs its
+// own bus, or the flushes would just queue up behind each other.
+template <typename Left, typename Right>
+struct EyeDualDisplay {
+  static_assert(Left::width == Right::width && Left::height == Right::height, "both eyes need the same panel size");
+  static_assert(Left::bus != Right::bus, "each eye needs its own bus to be sent in parallel");
+  static_assert(!Left::paged && !Right::paged, "the eyes are sent together from full buffers");
+
+  static constexpr int panels = 2;
+  static constexpr bool paged = false;
+  static constexpr int bufferBytes = Left::bufferBytes + Right::bufferBytes;
+  static constexpr int width = Left::width;
+  static constexpr int height = Left::height;
+  static constexpr uint32_t frameMicros =
+      Left::frameMicros > Right::frameMicros ? Left::frameMicros : Right::frameMicros;
+
+  typedef EyeDualPanel Panel;
+};
+
+typedef EyeDualDisplay<EyeSsd1306I2c, EyeSsd1306I2c2> EyeSsd1306Pair;
+typedef EyeDualDisplay<EyeSh1106I2c, EyeSh1106I2c2> EyeSh1106Pair;
+
+// The panel showing view 0 (left eye, or the whole face) or 1 (right eye)
+inline U8G2& eyePanel(U8G2& display, int) { return display; }
+inline U8G2& eyePanel(EyeDualPanel& panels, int view) { return view ? panels.right() : panels.left(); }
+
+inline void eyeFlush(U8G2& display, EyeDualPanel::Flush flush) { flush(display); }
+inline void eyeFlush(EyeDualPanel& panels, EyeDualPanel::Flush flush) { panels.flush(flush); }
@@ -0,0 +1,98 @@
+#include "eye_effects.h"
+
+// round(32767 * sin(2 pi i / 256)), and once more for interpolating past
+// the last entry
+static const int16_t SINE[257] = {
+       0,    804,   1608,   2410,   3212,   4011,   4808,   5602,   6393,   7179,   7962,   8739,
+    9512,  10278,  11039,  11793,  12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+   18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,  23170,  23731,  24279,  24811,
+   25329,  25832,  26319,  26790,  27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+   30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,  32137,  32285,  32412,  32521,
+   32609,  32678,  32728,  32757,  32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+   32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,  30273,  29956,  29621,  29268,
+   28898,  28510,  28105,  27683,  27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+   23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,  18204,  17530,  16846,  16151,
+   15446,  14732,  14010,  13279,  12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+    6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,      0,   -804,  -1608,  -2410,
+   -3212,  -4011,  -4808,  -5602,  -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+  -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159,
+  -20787, -21403, -22005, -22594, -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+  -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956, -30273, -30571, -30852, -31113,
+  -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+  -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580,
+  -31356, -31113, -30852, -30571, -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+  -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731, -23170, -22594, -22005, -21403,
+  -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+  -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,  -6393,  -5602,  -4808,  -4011,
+   -3212,  -2410,  -1608,   -804,      0,
+};
+
+// The noise lattice: the top bytes of xorshift32 from 0x9e3779b9, as
+// -127..127
+static const int8_t NOISE[256] = {
+   -47,   96,   -5, -127,  102,  121,   58,  124,   40,   53, -102,  121,  -19,  -57, -116,  -61,
+  -114,  -10, -114,  117,    4,   37,   -7, -126,   51,  -79,   81,  -48,  121,  123,   44,    3,
+    61,  104,  125,  -56, -100,  -43,   52,   19, -101,  -26,  -98,   -5,   70,  101,  107,  126,
+    -3,   83,   30,  -35, -108,  -55,   65,   -5,  112,  -22, -108,   23,  -22,   31,   19,   58,
+   -73,   57,    9,   50,  -51,   56,   51,  112,    5,  -24,  111,  -87,   42,   42,   -2,   51,
+     8,  -52,  -13,  -34,   50,  115,  -65,  -39,  -73,   20,   24,   33,  -66,  -25,  -12, -120,
+  -127,   78,   24,  -33, -109,  -34,  -88,   58,  -91,   82,  -98,  127,   71,   -1,   76,   -1,
+  -101,  -90,   42,  -40,   49, -111,  104,   24,   20, -114,   69,   32,  104, -116,   85,   62,
+   -68,   52,  119,    2,   -5,   43,  -41,  -80,  -80,  -33,  104, -112,  118,   19,  -62,   37,
+     7, -117,  -93,   -6,   46,   -3,   73,  -75,  -48,   24,    6,   93,   52,   -9,   11,   15,
+   -46, -115, -114,   -4, -112,   31,  -15,   55,    5,   47,   71,  -66,   95, -100,   56,  -55,
+   -94,  105,   68,   25,  -34,  -20, -103,  114,    5,   41,   14,   56,  122,  -27,  -80,  121,
+   123,  -32,  -66,   -3,  -67,   23,  -67, -100,  -65,   76,   62, -125,  -10,   50,   42, -112,
+    82,  -61,   20,  -96,   51,   72,   98,  126,  -63,   30,    6,  -69,   -9,  111,   96,   95,
+   -68,  -83,   84,  -74,   14,  104,   60,  -61,  -15,  -78, -113,  -16,  -42,   70,  -45,  107,
+   -72,   96,  -48,   88,  -20, -104,  -45, -109,   46, -101,   23,   53,   18,  -13, -122,  111,
+
+};
+
+const uint32_t TWINKLE_RATE = 4557078;       // a turn every 2 pi * 150 ms
+const uint32_t TWINKLE_STAGGER = 341782638;  // half a radian between stars
+const uint32_t BREATH_RATE = eyePhaseRate(EYE_BREATH_MS);
+const uint32_t JITTER_RATE = 44;             // 65536 per lattice step: about 1.5 s
+
+int eyeSine(uint32_t phase) {
+  int index = phase >> 24;
+  int fraction = (phase >> 8) & 0xffff;
+  int a = SINE[index];
+  int b = SINE[index + 1];
+  return a + (((b - a) * fraction) >> 16);
+}
+
+int eyeNoise(uint32_t position) {
+  uint8_t cell = position >> 16;
+  int32_t a = NOISE[cell] * 258;
+  int32_t b = NOISE[(uint8_t)(cell + 1)] * 258;
+  // Smoothstep, 3t^2 - 2t^3, in 1/32768, so it's flat at the lattice
+  // points and the wander has no corners
+  uint32_t t = (position & 0xffff) >> 1;
+  uint32_t ease = (((t * t) >> 15) * (3 * 32768 - 2 * t)) >> 15;
+  return a + (((b - a) * (int32_t)ease) >> 15);
+}
+
+int eyeTwinkle(uint32_t now, int index, int amplitude) {
+  // Truncated like the (int) of the float version it replaced
+  return amplitude * eyeSine(now * TWINKLE_RATE + index * TWINKLE_STAGGER) / EYE_EFFECT_ONE;
+}
+
+const EyeStar EYE_STARS[EYE_STAR_COUNT] = {
+  {105, 15, 3}, // top right, small
+  {20, 50, 6},  // bottom left, a little bigger
+};
+
+int eyeStarSize(uint32_t now, int index) {
+  int size = EYE_STARS[index].size + eyeTwinkle(now, index, 2);
+  return size < 1 ? 1 : size;
+}
+
+int eyeBreath(uint32_t now, int amplitude) {
+  int swing = amplitude * eyeSine(now * BREATH_RATE);
+  return (swing + (swing < 0 ? -EYE_EFFECT_ONE / 2 : EYE_EFFECT_ONE / 2)) / EYE_EFFECT_ONE;
+}
+
+int32_t eyeJitter(uint32_t now, uint32_t stream, int32_t amplitude) {
+  return amplitude * eyeNoise(now * JITTER_RATE + stream) / EYE_EFFECT_ONE;
+}
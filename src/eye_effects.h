@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+
+// The face's decorative motion: the stars' twinkle, a slow breath, small
+// random wander. All from two 256-entry tables in flash, a sine and the
+// lattice of a value noise, in integer arithmetic, so none of it costs a
+// libm call (sin() alone is a few microseconds on the ESP32's soft float).
+//
+// Phases are 32-bit fixed point, a full turn being 2^32, so they wrap for
+// free. An effect's phase is the clock times its rate (turns per ms) plus
+// an offset, with no state of its own: the same at any frame rate, and the
+// same when a trace is replayed (src/pet_behavior.h hashes star sizes).
+
+const int EYE_EFFECT_ONE = 32767;  // full swing of eyeSine() and eyeNoise()
+
+const uint32_t EYE_BREATH_MS = 4000;  // one breath
+
+// Phase advance per millisecond for a period
+constexpr uint32_t eyePhaseRate(uint32_t periodMs) { return (uint32_t)(4294967296ull / periodMs); }
+
+// Phase of an angle in radians
+inline uint32_t eyeAnglePhase(float radians) { return (uint32_t)(int64_t)(radians * 683565275.6f); }
+
+// Sine of a phase, -EYE_EFFECT_ONE..EYE_EFFECT_ONE, interpolated between
+// table entries (within 1/8000 of sin())
+int eyeSine(uint32_t phase);
+inline int eyeCosine(uint32_t phase) { return eyeSine(phase + 0x40000000u); }
+
+// Smooth value noise, -EYE_EFFECT_ONE..EYE_EFFECT_ONE: random values at
+// every multiple of 65536, eased between; repeats after 256 of them
+int eyeNoise(uint32_t position);
+
+// A star's twinkle: size offset in whole pixels, -amplitude..amplitude,
+// each star a little behind the one before
+int eyeTwinkle(uint32_t now, int index, int amplitude);
+
+// The stars out with happy eyes, in face pixels; always the same two
+struct EyeStar {
+  int x, y, size;
+};
+
+const int EYE_STAR_COUNT = 2;
+extern const EyeStar EYE_STARS[EYE_STAR_COUNT];
+
+// Size of a star with its twinkle, +/- 2 pixels and never below 1
+int eyeStarSize(uint32_t now, int index);
+
+// Breathing: a slow swell over EYE_BREATH_MS, whole pixels,
+// -amplitude..amplitude
+int eyeBreath(uint32_t now, int amplitude);
+
+// Random wander, -amplitude..amplitude in amplitude's units, drifting to a
+// new value every second and a half or so. Different streams wander
+// independently. amplitude up to 65535.
+int32_t eyeJitter(uint32_t now, uint32_t stream, int32_t amplitude);
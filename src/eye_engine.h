@@ -0,0 +1,384 @@
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+#include "event_trace.h"
+#include "eye_bitmap.h"
+#include "eye_clip.h"
+#include "eye_display.h"
+#include "eye_dual.h"
+#include "eye_effects.h"
+#include "eye_gaze.h"
+#include "eye_render.h"
+#include "eye_scene.h"
+#include "pet_behavior.h"
+#include "pet_clock.h"
+#include "pet_needs.h"
+
+// The eye engine every sketch is built on: behaviour (src/pet_behavior.h),
+// animation and rendering, plus the optional parts, chosen at compile
+// time. A sketch describes itself with a struct derived from EyeFeatures
+// that overrides the flags and hooks it needs, and names its panel with an
+// EyeDisplay (src/eye_display.h; the SSD1306 on I2C by default), or two of
+// them with one per eye (src/eye_dual.h):
+//
+//   struct Features : EyeFeatures {
+//     static constexpr bool readingLight = true;
+//   };
+//   EyeSh1106Spi::Panel u8g2(U8G2_R0, 5, 16, 17);
+//   EyeEngine<Features, EyeSh1106Spi> eyes(u8g2, clock);
+//
+// A disabled feature costs next to nothing: its state lives in an empty
+// base class (no RAM), and its code sits behind a constant-false branch
+// that the compiler drops, so nothing from the module behind it is linked
+// in. The exception is the reading light, which is part of PetBehavior's
+// state (snapshots, commands): a bool and a few branches in every build.
+// tools/size_report.py --host measures it per sketch. The network flags
+// (web, ota, ble) aren't used by the engine; sketches and src/eye_web.h
+// test them the same way.
+
+struct EyeFeatures {
+  static constexpr bool readingLight = false; // full-screen white on request
+  static constexpr bool hunger = false;       // PetNeeds drive the face; feeding
+  static constexpr bool stars = false;        // twinkling stars with happy eyes
+  static constexpr bool artwork = false;      // bitmaps for expressions at rest
+  static constexpr bool clips = false;        // animations over the face
+  static constexpr bool gaze = false;         // eyes follow a point, drift at rest
+  static constexpr bool breathing = false;    // eyes swell and settle, slowly
+  static constexpr bool trace = false;        // 12 KB EventTrace ring for /trace
+  static constexpr bool web = false;          // HTTP control routes
+  static constexpr bool ota = false;          // ArduinoOTA
+  static constexpr bool ble = false;          // BLE control service
+
+  static const int eyeSpacing = 16;           // between the eyes, face pixels
+
+  // Clock the needs run on, in seconds
+  static uint32_t needsTime() { return millis() / 1000; }
+  // Send the finished frame (to each panel, with one per eye)
+  static void flush(U8G2& display) { display.sendBuffer(); }
+  // Artwork for an expression at rest (src/eye_artwork.h), nullptr to draw
+  // it; blinks and transitions are always drawn
+  static const EyeBitmap* artworkFor(EyeState) { return nullptr; }
+  // Clip to play when the pet comes to rest on an expression, nullptr for
+  // none
+  static const EyeClip* clipOnEnter(EyeState) { return nullptr; }
+};
+
+class MillisClock : public PetClock {
+public:
+  uint32_t now() override { return millis(); }
+};
+
+// Optional state, empty when the feature is off
+template <bool Enabled>
+struct EyeNeedsPart {
+  EyeNeedsPart() : needs(PET_NEED_CURVES) {}
+  bool mood(uint32_t now, EyeState& state) const { return needs.mood(now, state); }
+  PetNeeds needs;
+};
+
+template <>
+struct EyeNeedsPart<false> {
+  bool mood(uint32_t, EyeState&) const { return false; }
+};
+
+template <bool Enabled>
+struct EyeTracePart {
+  EventTrace* tracePointer() { return &trace; }
+  EventTrace trace;
+};
+
+template <>
+struct EyeTracePart<false> {
+  EventTrace* tracePointer() { return nullptr; }
+};
+
+template <bool Enabled>
+struct EyeClipPart {
+  EyeClipPart() : settled(STATE_COUNT) {}
+  bool clipStart(const EyeClip& clip, U8G2& display, uint32_t now) {
+    memorySource = MemoryClipSource(clip);
+    return player.start(memorySource, display, now);
+  }
+  bool clipStart(ClipSource& source, U8G2& display, uint32_t now) { return player.start(source, display, now); }
+  bool clipPlaying() const { return player.playing(); }
+  bool clipRender(U8G2& display, uint32_t now) { return player.render(display, now); }
+  void clipInvalidate() { player.invalidate(); }
+  void clipStop() { player.stop(); }
+  // True once each time the pet comes to rest on a new expression
+  bool settledOn(EyeState state) {
+    bool changed = state != settled;
+    settled = state;
+    return changed;
+  }
+
+  ClipPlayer player;
+  MemoryClipSource memorySource;
+  EyeState settled;
+};
+
+template <>
+struct EyeClipPart<false> {
+  bool clipStart(const EyeClip&, U8G2&, uint32_t) { return false; }
+  bool clipPlaying() const { return false; }
+  bool clipRender(U8G2&, uint32_t) { return false; }
+  void clipInvalidate() {}
+  void clipStop() {}
+  bool settledOn(EyeState) { return false; }
+};
+
+template <bool Enabled>
+struct EyeGazePart {
+  void gazeBegin(uint64_t seed, uint32_t now) { gaze.begin(seed, now); }
+  void gazeUpdate(uint32_t now) { gaze.update(now); }
+  bool gazeFollowing() const { return gaze.following(); }
+  int gazeX() const { return gaze.x(); }
+  int gazeY() const { return gaze.y(); }
+
+  EyeGaze gaze;
+};
+
+template <>
+struct EyeGazePart<false> {
+  void gazeBegin(uint64_t, uint32_t) {}
+  void gazeUpdate(uint32_t) {}
+  bool gazeFollowing() const { return false; }
+  int gazeX() const { return 0; }
+  int gazeY() const { return 0; }
+};
+
+template <typename Features, typename Display = EyeSsd1306I2c>
+class EyeEngine : private EyeNeedsPart<Features::hunger>,
+                  private EyeTracePart<Features::trace>,
+                  private EyeClipPart<Features::clips>,
+                  private EyeGazePart<Features::gaze> {
+  typedef EyeNeedsPart<Features::hunger> NeedsPart;
+  typedef EyeTracePart<Features::trace> TracePart;
+  typedef EyeClipPart<Features::clips> ClipPart;
+  typedef EyeGazePart<Features::gaze> GazePart;
+
+  // Resting eye centres on the face
+  static constexpr int LEFT_X = EYE_FACE_WIDTH / 2 - Features::eyeSpacing / 2 - PET_EYE_WIDTH / 2;
+  static constexpr int RIGHT_X = EYE_FACE_WIDTH / 2 + Features::eyeSpacing / 2 + PET_EYE_WIDTH / 2;
+  static constexpr int EYE_Y = EYE_FACE_HEIGHT / 2;
+  static constexpr int BREATH_PIXELS = 2;  // eye height either way
+
+  // What panel View (0, or 1 with one panel per eye) shows: the whole face,
+  // or a window half as wide around its eye
+  template <int View>
+  struct PanelView {
+    static constexpr bool whole = Display::panels == 1;
+    static constexpr bool left = whole || View == 0;
+    static constexpr bool right = whole || View == 1;
+    static constexpr int centre = View == 0 ? LEFT_X : RIGHT_X;
+    typedef EyeGeometry<Display, whole ? 0 : centre - EYE_FACE_WIDTH / 4, 0, whole ? EYE_FACE_WIDTH : EYE_FACE_WIDTH / 2,
+                        EYE_FACE_HEIGHT>
+        Geometry;
+  };
+
+  static_assert((Display::panels == 1 && !Display::paged) || (!Features::artwork && !Features::clips),
+                "the artwork and clips are whole-face images, for one full-buffer panel");
+
+public:
+  typedef typename Display::Panel Panel;
+
+  EyeEngine(Panel& display, PetClock& clock) : _display(display), _pet(clock), _shownKey(-1), _pagesDrawn(0) {
+    _pet.setTrace(TracePart::tracePointer());
+  }
+
+  // Neutral eyes, first blink soon. Call after display.begin().
+  void begin(uint64_t seed) {
+    _pet.begin(seed);
+    GazePart::gazeBegin(~seed, _pet.now());
+  }
+
+  // Step the behaviour and draw the face if it changed, or the next frame
+  // of a clip while one plays. A steady expression (or the reading light)
+  // looks the same every frame, so it's only sent once. Returns true if a
+  // frame went out.
+  bool frame() {
+    EyeState needMood = STATE_NEUTRAL;
+    bool needy = NeedsPart::mood(Features::needsTime(), needMood);
+    _pet.update(needy, needMood);
+    GazePart::gazeUpdate(_pet.now());
+
+    // Coming to rest on an expression may start its clip. The behaviour
+    // carries on underneath; the face comes back when the clip ends.
+    if (Features::clips && !_pet.transitioning() && ClipPart::settledOn(_pet.currentState())) {
+      const EyeClip* clip = Features::clipOnEnter(_pet.currentState());
+      if (clip) {
+        ClipPart::clipStart(*clip, eyePanel(_display, 0), _pet.now());
+      }
+    }
+    if (ClipPart::clipPlaying()) {
+      if (_pet.readingLight()) {
+        ClipPart::clipStop();
+      } else {
+        uint32_t start = micros();
+        if (ClipPart::clipRender(eyePanel(_display, 0), _pet.now())) {
+          eyeFlush(_display, &Features::flush);
+          recordFrame(start);
+          _shownKey = -1;
+          return true;
+        }
+        if (ClipPart::clipPlaying()) {
+          return false;
+        }
+      }
+    }
+
+    int key = _pet.frameKey();
+    if ((Features::gaze || Features::breathing) && key >= 0 && !showsArtwork()) {
+      // The same expression looks the same with the eyes in the same place
+      // and the same breath
+      key = key * 4096 + (GazePart::gazeX() + 32) * 64 + GazePart::gazeY() + 32;
+      key = key * 8 + breath() + BREATH_PIXELS;
+    }
+    if (key >= 0 && key == _shownKey) {
+      return false;
+    }
+    uint32_t start = micros();
+    draw();
+    recordFrame(start);
+    _shownKey = key;
+    return true;
+  }
+
+  // Play a clip over the face from its first frame; the face comes back
+  // when it ends. Returns false if it isn't a clip for this display.
+  bool play(const EyeClip& clip) {
+    static_assert(Features::clips, "play() needs Features::clips");
+    return ClipPart::clipStart(clip, eyePanel(_display, 0), _pet.now());
+  }
+
+  bool play(ClipSource& source) {
+    static_assert(Features::clips, "play() needs Features::clips");
+    return ClipPart::clipStart(source, eyePanel(_display, 0), _pet.now());
+  }
+
+  bool playing() const { return ClipPart::clipPlaying(); }
+
+  // Render the current face and send it
+  void draw() {
+    ClipPart::clipInvalidate();
+    drawPanel<0>();
+    if (Display::panels > 1) {
+      drawPanel<1>();
+    }
+    if (!Display::paged) {
+      eyeFlush(_display, &Features::flush);
+    }
+  }
+
+  // Something else was drawn over the face; send the next frame regardless
+  void invalidate() {
+    _shownKey = -1;
+    ClipPart::clipInvalidate();
+  }
+
+  PetBehavior& pet() { return _pet; }
+
+  // Of the last frame on a page-buffer panel, the pages that had anything
+  // on them (the rest were only cleared and sent)
+  int pagesDrawn() const { return _pagesDrawn; }
+
+  PetNeeds& needs() {
+    static_assert(Features::hunger, "needs() needs Features::hunger");
+    return NeedsPart::needs;
+  }
+
+  EventTrace& trace() {
+    static_assert(Features::trace, "trace() needs Features::trace");
+    return TracePart::trace;
+  }
+
+  EyeGaze& gaze() {
+    static_assert(Features::gaze, "gaze() needs Features::gaze");
+    return GazePart::gaze;
+  }
+
+private:
+  void recordFrame(uint32_t start) {
+    if (Features::trace) {
+      uint32_t us = micros() - start;
+      TracePart::tracePointer()->record(_pet.now(), TRACE_FRAME, 0, us > 0xffff ? 0xffff : us, _pet.frameHash());
+    }
+  }
+
+  // The frame as a display list; a full buffer takes it all at once, a
+  // page buffer a page at a time, sending as it goes
+  template <int View>
+  void drawPanel() {
+    typedef typename PanelView<View>::Geometry Geometry;
+    U8G2& panel = eyePanel(_display, View);
+    if (!Display::paged) {
+      panel.clearBuffer();
+    }
+    panel.setDrawColor(1);
+
+    EyeScene scene;
+    if (Features::readingLight && _pet.readingLight()) {
+      scene.box(0, 0, Display::width, Display::height);
+    } else {
+      if (!drawArtwork(panel)) {
+        float openness = _pet.openness();
+        int swell = breath();
+        if (PanelView<View>::left) {
+          const EyeShape& left = _pet.leftEye();
+          scene.ellipse(Geometry::x(LEFT_X + left.offsetX + GazePart::gazeX()),
+                        Geometry::y(EYE_Y + left.offsetY + GazePart::gazeY()),
+                        Geometry::size(left.width), Geometry::size(left.height * openness + swell), left.angle);
+        }
+        if (PanelView<View>::right) {
+          const EyeShape& right = _pet.rightEye();
+          scene.ellipse(Geometry::x(RIGHT_X + right.offsetX + GazePart::gazeX()),
+                        Geometry::y(EYE_Y + right.offsetY + GazePart::gazeY()),
+                        Geometry::size(right.width), Geometry::size(right.height * openness + swell), right.angle);
+        }
+      }
+
+      if (Features::stars && _pet.showsStars()) {
+        for (int i = 0; i < EYE_STAR_COUNT; i++) {
+          const EyeStar& star = EYE_STARS[i];
+          if (Geometry::shows(star.x, star.y)) {
+            scene.star(Geometry::x(star.x), Geometry::y(star.y), Geometry::size(eyeStarSize(_pet.now(), i)));
+          }
+        }
+      }
+    }
+
+    if (Display::paged) {
+      _pagesDrawn = scene.drawPages(panel);
+    } else {
+      scene.draw(panel);
+    }
+  }
+
+  // Eye height on top of the shape, whole face pixels
+  int breath() const { return Features::breathing ? eyeBreath(_pet.now(), BREATH_PIXELS) : 0; }
+
+  // The artwork is the expression at rest looking ahead; while the eyes
+  // follow a point they're drawn
+  bool showsArtwork() const {
+    return Features::artwork && !_pet.transitioning() && !_pet.blinking() && !GazePart::gazeFollowing() &&
+           Features::artworkFor(_pet.currentState());
+  }
+
+  bool drawArtwork(U8G2& panel) {
+    if (!showsArtwork()) {
+      return false;
+    }
+    const EyeBitmap* art = Features::artworkFor(_pet.currentState());
+    if (eyeBlitBitmap(panel, *art)) {
+      return true;
+    }
+    panel.clearBuffer();
+    return false;
+  }
+
+  Panel& _display;
+  PetBehavior _pet;
+  int _shownKey;       // frame key on screen, -1 if none
+  int _pagesDrawn;     // pages with anything on them, last paged frame
+};
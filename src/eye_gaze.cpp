@@ -0,0 +1,112 @@
+#include "eye_gaze.h"
+
+#include <stdlib.h>
+
+#include "eye_effects.h"
+
+const uint32_t TICK_MS = 4;
+const uint32_t MAX_TICKS = 64;       // longer gaps (a stalled loop) jump to the target
+
+// The spring, in per-tick terms: acceleration = k * error - c * velocity,
+// with k = (omega * tick)^2 and c = 2 * omega * tick for critical damping,
+// both in 1/65536. At 35 rad/s it's within a pixel of a new target after
+// about 150 ms, like an expression transition.
+constexpr float OMEGA = 35;
+constexpr int32_t SPRING = (int32_t)(OMEGA * OMEGA * TICK_MS * TICK_MS / 1e6f * 65536 + 0.5f);
+constexpr int32_t DAMPING = (int32_t)(2 * OMEGA * TICK_MS / 1e3f * 65536 + 0.5f);
+
+const int32_t SETTLED = 8;           // 1/32 pixel and 1/32 pixel per tick
+const int DRIFT_X = 2;               // idle drift, face pixels either way
+const int DRIFT_Y = 1;
+const long MIN_SACCADE_MS = 500;
+const long MAX_SACCADE_MS = 2000;
+
+static bool reached(uint32_t now, uint32_t when) { return (int32_t)(now - when) >= 0; }
+
+EyeGaze::EyeGaze()
+    : _x{0, 0, 0}, _y{0, 0, 0}, _lookX(0), _lookY(0), _driftX(0), _driftY(0), _streamX(0), _streamY(0),
+      _following(false), _last(0), _nextSaccade(0) {}
+
+void EyeGaze::begin(uint64_t seed, uint32_t now) {
+  _random.seed64(seed);
+  _x = Axis{0, 0, 0};
+  _y = Axis{0, 0, 0};
+  _lookX = 0;
+  _lookY = 0;
+  _driftX = 0;
+  _driftY = 0;
+  _streamX = _random.next();
+  _streamY = _random.next();
+  _following = false;
+  _last = now;
+  _nextSaccade = now + _random.range(MIN_SACCADE_MS, MAX_SACCADE_MS);
+}
+
+void EyeGaze::lookAt(int faceX, int faceY) {
+  // The middle of the face is straight ahead; its edges as far as the eyes
+  // turn
+  const int32_t maxX = EYE_GAZE_MAX_X * PIXEL;
+  const int32_t maxY = EYE_GAZE_MAX_Y * PIXEL;
+  int32_t x = (int32_t)(faceX - 64) * maxX / 64;
+  int32_t y = (int32_t)(faceY - 32) * maxY / 32;
+  _lookX = x < -maxX ? -maxX : (x > maxX ? maxX : x);
+  _lookY = y < -maxY ? -maxY : (y > maxY ? maxY : y);
+  _driftX = 0;
+  _driftY = 0;
+  _following = true;
+  aim();
+}
+
+void EyeGaze::release() {
+  _lookX = 0;
+  _lookY = 0;
+  _following = false;
+  aim();
+}
+
+void EyeGaze::aim() {
+  _x.target = _lookX + _driftX;
+  _y.target = _lookY + _driftY;
+}
+
+void EyeGaze::step(Axis& axis) {
+  axis.velocity += (SPRING * (axis.target - axis.position) - DAMPING * axis.velocity) >> 16;
+  axis.position += axis.velocity;
+}
+
+// Integer steps can leave it creeping a fraction of a pixel short, so
+// close enough is there
+void EyeGaze::settle(Axis& axis) {
+  if (abs(axis.target - axis.position) < SETTLED && abs(axis.velocity) < SETTLED) {
+    axis.position = axis.target;
+    axis.velocity = 0;
+  }
+}
+
+void EyeGaze::update(uint32_t now) {
+  if (!_following) {
+    _driftX = eyeJitter(now, _streamX, DRIFT_X * PIXEL);
+    _driftY = eyeJitter(now, _streamY, DRIFT_Y * PIXEL);
+    aim();
+  }
+  if (reached(now, _nextSaccade)) {
+    _x.position += _random.range(-1, 2) * PIXEL;
+    _y.position += _random.range(-1, 2) * PIXEL;
+    _nextSaccade = now + _random.range(MIN_SACCADE_MS, MAX_SACCADE_MS);
+  }
+
+  uint32_t ticks = (now - _last) / TICK_MS;
+  if (ticks > MAX_TICKS) {
+    _x = Axis{_x.target, 0, _x.target};
+    _y = Axis{_y.target, 0, _y.target};
+    _last = now;
+    return;
+  }
+  for (uint32_t i = 0; i < ticks; i++) {
+    step(_x);
+    step(_y);
+  }
+  _last += ticks * TICK_MS;
+  settle(_x);
+  settle(_y);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "pet_random.h"
+
+// Where the eyes look, as an offset added to both eyes on top of the
+// expression: a point on the face to follow (from /look), or the middle,
+// with the small random movements of eyes that aren't looking at anything
+// in particular. The offset chases its target on a critically damped
+// spring (fast, no overshoot), so a new target is reached in about the
+// time of an expression transition and a target that moves is followed
+// smoothly. Looking ahead, the target wanders a pixel or two on smooth
+// value noise (src/eye_effects.h), and every so often the eyes make a
+// micro-saccade: a one-pixel jump the spring pulls back.
+//
+// All in integer fixed point on a fixed 4 ms tick, so it costs the same
+// on the ESP32 as on the host for any frame rate, and runs the same for
+// the same seed and times.
+
+const int EYE_GAZE_MAX_X = 20;  // furthest the eyes turn, face pixels
+const int EYE_GAZE_MAX_Y = 12;
+
+class EyeGaze {
+public:
+  EyeGaze();
+
+  // Centred, at rest; the same seed gives the same drift and saccades
+  void begin(uint64_t seed, uint32_t now);
+
+  // Follow a point on the face (0..127, 0..63), as far as the eyes turn
+  void lookAt(int faceX, int faceY);
+  // Back to the middle, drifting
+  void release();
+  bool following() const { return _following; }
+
+  // Advance to now (ms); call once per frame
+  void update(uint32_t now);
+
+  // Offset of both eyes, whole face pixels
+  int x() const { return (_x.position + HALF) >> FRACTION; }
+  int y() const { return (_y.position + HALF) >> FRACTION; }
+
+private:
+  static const int FRACTION = 8;  // positions in 1/256 pixel
+  static const int32_t PIXEL = 1 << FRACTION;
+  static const int32_t HALF = PIXEL / 2;
+
+  struct Axis {
+    int32_t position;  // 1/256 pixel
+    int32_t velocity;  // 1/256 pixel per tick
+    int32_t target;
+  };
+
+  static void step(Axis& axis);
+  static void settle(Axis& axis);
+  void aim();
+
+  PetRandom _random;
+  Axis _x, _y;
+  int32_t _lookX, _lookY;    // followed point, or the middle; 1/256 pixel
+  int32_t _driftX, _driftY;  // idle drift around it
+  uint32_t _streamX, _streamY; // where in the noise each axis drifts
+  bool _following;
+  uint32_t _last;            // time the last tick ran to
+  uint32_t _nextSaccade;
+};
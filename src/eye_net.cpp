@@ -0,0 +1,98 @@
+#include "eye_net.h"
+
+#include <ArduinoOTA.h>
+#include <ESPmDNS.h>
+#include <WiFi.h>
+
+#include "eye_render.h"
+#include "log.h"
+
+static U8G2* otaDisplay = nullptr;
+static volatile bool* otaFlag = nullptr;
+static unsigned long lastWiFiCheck = 0;
+
+bool eyeConnectWiFi(U8G2& display, const char* ssid, const char* password, const char* hostname) {
+  eyeStatusScreen(display, "Connecting to", ssid);
+  delay(4000);
+
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(ssid, password);
+
+  // Wait for connection (with timeout)
+  unsigned long startTime = millis();
+  while (WiFi.status() != WL_CONNECTED && millis() - startTime < 20000) {
+    delay(500);
+  }
+
+  bool connected = WiFi.status() == WL_CONNECTED;
+  if (connected) {
+    LOGI(LOG_NET, "Connected to %s, IP address %s", ssid, WiFi.localIP().toString().c_str());
+    if (!MDNS.begin(hostname)) {
+      LOGE(LOG_NET, "Error setting up MDNS responder!");
+    } else {
+      MDNS.addService("http", "tcp", 80);
+    }
+    eyeStatusScreen(display, "Connected", WiFi.localIP().toString());
+    delay(3000);  // Show IP for 3 seconds
+  } else {
+    LOGE(LOG_NET, "WiFi connection failed!");
+    eyeStatusScreen(display, "Failed", "to connect", "Will retry...");
+    delay(2000);
+  }
+  eyeStatusScreen(display, "Hi", "I am Blinky");
+  delay(3500);
+  return connected;
+}
+
+void eyeKeepWiFi(unsigned long now, unsigned long intervalMs) {
+  if (WiFi.status() != WL_CONNECTED && now - lastWiFiCheck > intervalMs) {
+    LOGW(LOG_NET, "WiFi disconnected, attempting to reconnect...");
+    WiFi.reconnect();
+    lastWiFiCheck = now;
+  }
+}
+
+void eyeBeginOta(U8G2& display, const char* hostname, volatile bool* inProgress) {
+  otaDisplay = &display;
+  otaFlag = inProgress;
+  ArduinoOTA.setHostname(hostname);
+
+  ArduinoOTA.onStart([]() {
+    LOGI(LOG_OTA, "Start updating %s", ArduinoOTA.getCommand() == U_FLASH ? "sketch" : "filesystem");
+    *otaFlag = true;
+    eyeStatusScreen(*otaDisplay, "Update", "Starting...");
+  });
+
+  ArduinoOTA.onEnd([]() {
+    LOGI(LOG_OTA, "OTA update complete!");
+    logFlush();
+    eyeStatusScreen(*otaDisplay, "Update", "complete.", "Restarting.");
+    delay(1000);
+  });
+
+  ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
+    eyeProgressScreen(*otaDisplay, progress / (total / 100));
+  });
+
+  ArduinoOTA.onError([](ota_error_t error) {
+    const char* message = "Failed";
+    if (error == OTA_AUTH_ERROR) {
+      message = "Auth Failed";
+    } else if (error == OTA_BEGIN_ERROR) {
+      message = "Begin Failed";
+    } else if (error == OTA_CONNECT_ERROR) {
+      message = "Connect Failed";
+    } else if (error == OTA_RECEIVE_ERROR) {
+      message = "Receive Failed";
+    } else if (error == OTA_END_ERROR) {
+      message = "End Failed";
+    }
+    LOGE(LOG_OTA, "Error[%u]: %s", error, message);
+    eyeStatusScreen(*otaDisplay, "OTA Error", message);
+    delay(2000);
+    *otaFlag = false;
+  });
+
+  ArduinoOTA.begin();
+  LOGI(LOG_OTA, "OTA ready");
+}
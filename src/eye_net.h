@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+// WiFi and ArduinoOTA bring-up for the sketches built on the eye engine
+// (src/eye_engine.h), with the usual boot and update screens. Hungry.cpp
+// has its own, with night-mode and NTP handling on top.
+
+// Connect as a station, showing progress on the display. Blocks for up to
+// 20 s; starts mDNS (http on port 80) when connected. Returns true if
+// connected.
+bool eyeConnectWiFi(U8G2& display, const char* ssid, const char* password, const char* hostname);
+
+// Retry the connection every intervalMs while it's down; call from loop()
+void eyeKeepWiFi(unsigned long now, unsigned long intervalMs = 2000);
+
+// ArduinoOTA with a progress bar. *inProgress is true while an update is
+// being received; the sketch should stop drawing the eyes meanwhile.
+void eyeBeginOta(U8G2& display, const char* hostname, volatile bool* inProgress);
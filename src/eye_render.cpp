@@ -0,0 +1,92 @@
+#include "eye_render.h"
+
+#include <limits.h>
+
+#include "eye_effects.h"
+
+void eyeFillEllipse(U8G2& display, int x0, int y0, int width, int height, float angle) {
+  eyeFillEllipseRows(display, x0, y0, width, height, angle, INT_MIN, INT_MAX);
+}
+
+void eyeFillEllipseRows(U8G2& display, int x0, int y0, int width, int height, float angle, int top, int bottom) {
+  int a = width / 2;
+  int b = height / 2;
+
+  // One scanline per row: x = a * sqrt(1 - (y/b)^2). Upright, scanline y
+  // is row y0 + y, so only the rows asked for are worked out.
+  int first = -b;
+  int last = b;
+  if (angle == 0 && top > y0 - b) {
+    first = top - y0;
+  }
+  if (angle == 0 && bottom < y0 + b) {
+    last = bottom - y0;
+  }
+  uint32_t phase = eyeAnglePhase(angle);
+  float sinA = (float)eyeSine(phase) / EYE_EFFECT_ONE;
+  float cosA = (float)eyeCosine(phase) / EYE_EFFECT_ONE;
+  for (int y = first; y <= last; y++) {
+    float relY = (b > 1) ? (float)y / b : 0;
+    int halfWidth = a * sqrt(1.0 - relY * relY);
+
+    if (halfWidth > 0) {
+      if (angle == 0) {
+        display.drawHLine(x0 - halfWidth, y0 + y, halfWidth * 2);
+      } else {
+        int x1 = x0 + (-halfWidth * cosA - y * sinA);
+        int y1 = y0 + (-halfWidth * sinA + y * cosA);
+        int x2 = x0 + (halfWidth * cosA - y * sinA);
+        int y2 = y0 + (halfWidth * sinA + y * cosA);
+        if (max(y1, y2) >= top && min(y1, y2) <= bottom) {
+          display.drawLine(x1, y1, x2, y2);
+        }
+      }
+    }
+  }
+}
+
+void eyeDrawStar(U8G2& display, int x, int y, int size) {
+  display.setDrawColor(1);
+  display.drawTriangle(x, y - size, x + size, y, x, y + size);
+  display.drawTriangle(x, y - size, x - size, y, x, y + size);
+}
+
+void eyeStatusScreen(U8G2& display, const String& line1, const String& line2, const String& line3) {
+  int screenWidth = display.getDisplayWidth();
+  int top = (display.getDisplayHeight() - 64) / 2;  // laid out for 64 rows
+  display.setFont(u8g2_font_9x15_tf);
+
+  // Once with a full buffer, a page at a time with a page buffer
+  display.firstPage();
+  do {
+    int width = display.getStrWidth(line1.c_str());
+    display.drawStr((screenWidth - width) / 2, top + 15, line1.c_str());
+
+    if (line2.length() > 0) {
+      width = display.getStrWidth(line2.c_str());
+      display.drawStr((screenWidth - width) / 2, top + 35, line2.c_str());
+    }
+
+    if (line3.length() > 0) {
+      width = display.getStrWidth(line3.c_str());
+      display.drawStr((screenWidth - width) / 2, top + 55, line3.c_str());
+    }
+  } while (display.nextPage());
+}
+
+void eyeProgressScreen(U8G2& display, unsigned int percentComplete) {
+  int screenWidth = display.getDisplayWidth();
+  String percentStr = String(percentComplete) + "%";
+  display.setFont(u8g2_font_9x15_tf);
+
+  display.firstPage();
+  do {
+    display.drawStr(0, 15, "Updating");
+
+    // Progress bar
+    display.drawFrame(0, 25, screenWidth, 10);
+    display.drawBox(0, 25, (percentComplete * screenWidth) / 100, 10);
+
+    display.drawStr(52, 50, percentStr.c_str());
+  } while (display.nextPage());
+}
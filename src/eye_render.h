@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+// Drawing primitives shared by every sketch built on the eye engine
+// (src/eye_engine.h): the eyes themselves, the happy stars and the status
+// and progress screens shown while booting or updating. They draw into the
+// U8g2 buffer only and sending it is up to the caller, except for the
+// screens, which send themselves.
+
+// Filled ellipse, rotated by angle (radians) around its centre
+void eyeFillEllipse(U8G2& display, int x0, int y0, int width, int height, float angle);
+
+// The same, only the parts on rows top..bottom: the same pixels there, and
+// nothing drawn for the rest (for page mode)
+void eyeFillEllipseRows(U8G2& display, int x0, int y0, int width, int height, float angle, int top, int bottom);
+
+// Four-sided star (a diamond)
+void eyeDrawStar(U8G2& display, int x, int y, int size);
+
+// Up to three centred lines of text; sends them (a page at a time on a
+// page-buffer panel)
+void eyeStatusScreen(U8G2& display, const String& line1, const String& line2 = "", const String& line3 = "");
+
+// "Updating" with a progress bar; sends it
+void eyeProgressScreen(U8G2& display, unsigned int percentComplete);
@@ -0,0 +1,76 @@
+#include "eye_scene.h"
+
+#include <limits.h>
+
+#include "eye_render.h"
+
+bool EyeScene::add(const EyeSceneItem& item) {
+  if (_count == EYE_SCENE_MAX) {
+    return false;
+  }
+  _items[_count++] = item;
+  return true;
+}
+
+bool EyeScene::ellipse(int x, int y, int width, int height, float angle) {
+  // Upright, it spans its height; turned, no more than its longer axis
+  // (plus a row for rounding) either way
+  int reach = height / 2;
+  if (angle != 0) {
+    reach = (width > height ? width : height) / 2 + 1;
+  }
+  EyeSceneItem item = {EYE_SCENE_ELLIPSE, (int16_t)x, (int16_t)y, (int16_t)width, (int16_t)height, angle,
+                       (int16_t)(y - reach), (int16_t)(y + reach)};
+  return add(item);
+}
+
+bool EyeScene::star(int x, int y, int size) {
+  EyeSceneItem item = {EYE_SCENE_STAR, (int16_t)x, (int16_t)y, (int16_t)size, 0, 0,
+                       (int16_t)(y - size), (int16_t)(y + size)};
+  return add(item);
+}
+
+bool EyeScene::box(int x, int y, int width, int height) {
+  EyeSceneItem item = {EYE_SCENE_BOX, (int16_t)x, (int16_t)y, (int16_t)width, (int16_t)height, 0,
+                       (int16_t)y, (int16_t)(y + height - 1)};
+  return add(item);
+}
+
+void EyeScene::drawItem(U8G2& display, const EyeSceneItem& item, int top, int bottom) const {
+  switch (item.kind) {
+    case EYE_SCENE_ELLIPSE:
+      eyeFillEllipseRows(display, item.x, item.y, item.width, item.height, item.angle, top, bottom);
+      break;
+    case EYE_SCENE_STAR:
+      eyeDrawStar(display, item.x, item.y, item.width);
+      break;
+    case EYE_SCENE_BOX:
+      display.drawBox(item.x, item.y, item.width, item.height);
+      break;
+  }
+}
+
+void EyeScene::draw(U8G2& display) const {
+  for (int i = 0; i < _count; i++) {
+    drawItem(display, _items[i], INT_MIN, INT_MAX);
+  }
+}
+
+int EyeScene::drawPages(U8G2& display) const {
+  int drawn = 0;
+  display.firstPage();
+  do {
+    int top = display.getBufferCurrTileRow() * 8;
+    int bottom = top + display.getBufferTileHeight() * 8 - 1;
+    bool any = false;
+    for (int i = 0; i < _count; i++) {
+      const EyeSceneItem& item = _items[i];
+      if (item.bottom >= top && item.top <= bottom) {
+        drawItem(display, item, top, bottom);
+        any = true;
+      }
+    }
+    drawn += any;
+  } while (display.nextPage());
+  return drawn;
+}
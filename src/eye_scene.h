@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <U8g2lib.h>
+
+#include "eye_effects.h"
+
+// A frame as a short display list: the eyes, the stars, or the reading
+// light's box, each with the rows it can touch. Drawn into a full buffer
+// it's the same calls the engine always made. With U8g2's page buffer
+// (src/eye_display.h, EyePaged) each page is rasterized against only the
+// items that reach into it, and upright ellipses only work out their rows
+// on the page, so a blank page costs a clear and a send and nothing else.
+
+enum EyeSceneKind {
+  EYE_SCENE_ELLIPSE,
+  EYE_SCENE_STAR,
+  EYE_SCENE_BOX
+};
+
+struct EyeSceneItem {
+  uint8_t kind;           // EyeSceneKind
+  int16_t x, y;           // ellipse, star: centre; box: top left corner
+  int16_t width, height;  // star: size in width
+  float angle;            // ellipse, radians
+  int16_t top, bottom;    // rows it can touch
+};
+
+// Two eyes and the stars, or the box
+const int EYE_SCENE_MAX = 2 + EYE_STAR_COUNT;
+
+class EyeScene {
+public:
+  EyeScene() : _count(0) {}
+
+  // Each returns false (and drops the item) when the list is full
+  bool ellipse(int x, int y, int width, int height, float angle);
+  bool star(int x, int y, int size);
+  bool box(int x, int y, int width, int height);
+
+  int size() const { return _count; }
+
+  // Everything, into the display's full buffer; sending is up to the
+  // caller
+  void draw(U8G2& display) const;
+
+  // The whole frame a page at a time between firstPage() and nextPage(),
+  // which sends each page. Returns how many pages had anything on them.
+  int drawPages(U8G2& display) const;
+
+private:
+  bool add(const EyeSceneItem& item);
+  void drawItem(U8G2& display, const EyeSceneItem& item, int top, int bottom) const;
+
+  EyeSceneItem _items[EYE_SCENE_MAX];
+  int _count;
+};
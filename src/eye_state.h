@@ -0,0 +1,18 @@
+#pragma once
+
+// Eye expressions the sketch can animate. Shared with the behaviour code
+// under src/ so it can pick moods without knowing about the display.
+enum EyeState {
+  STATE_NEUTRAL,        // Normal, centered eyes
+  STATE_ANGRY,          // Angled eyes, looking aggressive
+  STATE_SURPRISED,      // Wide, round eyes
+  STATE_SAD,            // Droopy, downward eyes
+  STATE_SUSPICIOUS,     // Narrow, squinting eyes
+  STATE_LEFT,           // Looking left
+  STATE_RIGHT,          // Looking right
+  STATE_UP,             // Looking up
+  STATE_DOWN,           // Looking down
+  STATE_SLEEPY,         // Half-closed eyes
+  STATE_HAPPY,          // happy state
+  STATE_COUNT           // Used to count the number of states
+};
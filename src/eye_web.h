@@ -0,0 +1,81 @@
+#pragma once
+
+#include <WebServer.h>
+
+#include "eye_engine.h"
+
+// The HTTP control routes of the sketches built on the eye engine:
+//   /emotion?state=N   show expression N
+//   /manual            toggle manual mode (leaving it goes back to neutral)
+//   /readinglight      toggle the reading light, if Features::readingLight
+//   /look?x=X&y=Y      follow the point X,Y of the face (0..127, 0..63), if
+//                      Features::gaze; /look alone looks ahead again
+// The sketch serves its own page on / and calls server.begin().
+// Hungry.cpp has its own, richer set of routes, sharing /look.
+
+// /look, only compiled in with Features::gaze. onRequest, if given, runs
+// first on every request (Hungry.cpp keeps the CPU up with it).
+template <bool Enabled>
+struct EyeLookRoute {
+  template <typename Engine>
+  static void add(WebServer&, Engine&, void (*)() = nullptr) {}
+};
+
+template <>
+struct EyeLookRoute<true> {
+  template <typename Engine>
+  static void add(WebServer& server, Engine& eyes, void (*onRequest)() = nullptr) {
+    server.on("/look", HTTP_GET, [&server, &eyes, onRequest]() {
+      if (onRequest) {
+        onRequest();
+      }
+      if (!server.hasArg("x") && !server.hasArg("y")) {
+        eyes.gaze().release();
+        server.send(200, "text/plain", "Looking ahead");
+        return;
+      }
+      if (!server.hasArg("x") || !server.hasArg("y")) {
+        server.send(400, "text/plain", "Missing x or y parameter");
+        return;
+      }
+      int x = server.arg("x").toInt();
+      int y = server.arg("y").toInt();
+      eyes.gaze().lookAt(x, y);
+      server.send(200, "text/plain", "Looking at " + String(x) + "," + String(y));
+    });
+  }
+};
+
+template <typename Features, typename Display>
+void eyeWebRoutes(WebServer& server, EyeEngine<Features, Display>& eyes) {
+  static_assert(Features::web, "eyeWebRoutes() needs Features::web");
+
+  server.on("/emotion", HTTP_GET, [&server, &eyes]() {
+    if (!server.hasArg("state")) {
+      server.send(400, "text/plain", "Missing state parameter");
+      return;
+    }
+    int state = server.arg("state").toInt();
+    if (!eyes.pet().setEmotion(state)) {
+      server.send(400, "text/plain", "Invalid state value");
+      return;
+    }
+    server.send(200, "text/plain", "Emotion set to " + String(state));
+  });
+
+  server.on("/manual", HTTP_GET, [&server, &eyes]() {
+    bool on = !eyes.pet().manualMode();
+    eyes.pet().setManualMode(on);
+    server.send(200, "text/plain", on ? "Manual mode ON" : "Manual mode OFF");
+  });
+
+  if (Features::readingLight) {
+    server.on("/readinglight", HTTP_GET, [&server, &eyes]() {
+      bool on = !eyes.pet().readingLight();
+      eyes.pet().setReadingLight(on);
+      server.send(200, "text/plain", on ? "Reading light ON" : "Reading light OFF");
+    });
+  }
+
+  EyeLookRoute<Features::gaze>::add(server, eyes);
+}
@@ -0,0 +1,109 @@
+#include "i2c_bus.h"
+
+I2cBusScheduler::I2cBusScheduler() : _jobCount(0), _windowStartUs(0), _windowBusyUs(0), _lastFlushUs(0) {
+  _stats.utilizationPermille = 0;
+  _stats.worstPageUs = 0;
+  _stats.worstFlushUs = 0;
+}
+
+int I2cBusScheduler::addJob(const char* name, I2cJobFunction function, unsigned long periodMs, uint8_t priority) {
+  if (_jobCount >= I2C_MAX_JOBS) {
+    return -1;
+  }
+  Job& job = _jobs[_jobCount];
+  job.stats.name = name;
+  job.stats.priority = priority;
+  job.stats.runs = 0;
+  job.stats.worstLatencyUs = 0;
+  job.stats.worstRunUs = 0;
+  job.function = function;
+  job.periodUs = periodMs * 1000;
+  job.nextDueUs = micros() + job.periodUs;
+  return _jobCount++;
+}
+
+void I2cBusScheduler::addBusyTime(uint32_t us) {
+  _windowBusyUs += us;
+  uint32_t now = micros();
+  uint32_t window = now - _windowStartUs;
+  if (window >= I2C_STATS_WINDOW_MS * 1000) {
+    _stats.utilizationPermille = (uint32_t)((uint64_t)_windowBusyUs * 1000 / window);
+    _windowBusyUs = 0;
+    _windowStartUs = now;
+  }
+}
+
+void I2cBusScheduler::runDueJobs() {
+  // Pick the most urgent due job each time round; jobs are few, so a
+  // linear scan beats keeping a sorted queue.
+  while (true) {
+    uint32_t now = micros();
+    Job* next = nullptr;
+    for (int i = 0; i < _jobCount; i++) {
+      Job& job = _jobs[i];
+      if ((int32_t)(now - job.nextDueUs) >= 0 &&
+          (next == nullptr || job.stats.priority > next->stats.priority)) {
+        next = &job;
+      }
+    }
+    if (next == nullptr) {
+      return;
+    }
+
+    uint32_t latency = now - next->nextDueUs;
+    next->function(millis());
+    uint32_t ran = micros() - now;
+
+    next->stats.runs++;
+    if (latency > next->stats.worstLatencyUs) next->stats.worstLatencyUs = latency;
+    if (ran > next->stats.worstRunUs) next->stats.worstRunUs = ran;
+    addBusyTime(ran);
+
+    // Keep the original cadence; skip missed periods instead of bursting
+    next->nextDueUs += next->periodUs;
+    if ((int32_t)(micros() - next->nextDueUs) >= 0) {
+      next->nextDueUs = micros() + next->periodUs;
+    }
+  }
+}
+
+void I2cBusScheduler::service() {
+  runDueJobs();
+  addBusyTime(0); // roll the utilization window even when idle
+}
+
+void I2cBusScheduler::flushDisplay(U8G2& display) {
+  uint32_t flushStart = micros();
+  uint8_t tileWidth = display.getBufferTileWidth();
+  uint8_t pages = display.getBufferTileHeight();
+
+  for (uint8_t page = 0; page < pages; page++) {
+    runDueJobs();
+    uint32_t start = micros();
+    display.updateDisplayArea(0, page, tileWidth, 1);
+    uint32_t took = micros() - start;
+    if (took > _stats.worstPageUs) _stats.worstPageUs = took;
+    addBusyTime(took);
+  }
+
+  uint32_t flush = micros() - flushStart;
+  if (flush > _stats.worstFlushUs) _stats.worstFlushUs = flush;
+  _lastFlushUs = flush;
+}
+
+I2cJobStats I2cBusScheduler::jobStats(int index) const {
+  return _jobs[index].stats;
+}
+
+String I2cBusScheduler::report() const {
+  String text = "bus utilization: " + String(_stats.utilizationPermille / 10.0, 1) + "%\n";
+  text += "display page: worst " + String(_stats.worstPageUs) + " us, frame: worst " +
+          String(_stats.worstFlushUs) + " us\n";
+  for (int i = 0; i < _jobCount; i++) {
+    const I2cJobStats& job = _jobs[i].stats;
+    text += String(job.name) + " (prio " + String(job.priority) + "): " + String(job.runs) +
+            " runs, worst latency " + String(job.worstLatencyUs) + " us, worst bus time " +
+            String(job.worstRunUs) + " us\n";
+  }
+  return text;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+// Shares the hardware I2C bus between the OLED and sensors.
+//
+// A full-frame sendBuffer() keeps the bus busy for ~25 ms at 400 kHz. The
+// scheduler instead flushes the display one 8-row page at a time and, in
+// between pages, runs any sensor job that has come due, highest priority
+// first. A sensor read therefore waits at most one page transfer (~3 ms)
+// rather than a whole frame. Everything runs on the loop() task, so no
+// locking is needed and transactions never overlap.
+
+typedef void (*I2cJobFunction)(unsigned long currentTime);
+
+const int I2C_MAX_JOBS = 4;
+const unsigned long I2C_STATS_WINDOW_MS = 5000;
+
+struct I2cJobStats {
+  const char* name;
+  uint8_t priority;
+  uint32_t runs;
+  uint32_t worstLatencyUs; // due -> started, worst case
+  uint32_t worstRunUs;     // time the job held the bus, worst case
+};
+
+struct I2cBusStats {
+  uint32_t utilizationPermille; // bus busy time over the last window
+  uint32_t worstPageUs;         // longest single display page transfer
+  uint32_t worstFlushUs;        // whole frame, including interleaved jobs
+};
+
+class I2cBusScheduler {
+public:
+  I2cBusScheduler();
+
+  // Register a periodic job. Higher priority runs first when several are due.
+  int addJob(const char* name, I2cJobFunction function, unsigned long periodMs, uint8_t priority);
+
+  // Run whatever is due. Call once per loop().
+  void service();
+
+  // Replacement for u8g2.sendBuffer() that yields to due jobs between pages
+  void flushDisplay(U8G2& display);
+
+  int jobCount() const { return _jobCount; }
+  I2cJobStats jobStats(int index) const;
+  I2cBusStats stats() const { return _stats; }
+  // Bus time of the most recent flushDisplay(), sensor jobs included
+  uint32_t lastFlushUs() const { return _lastFlushUs; }
+  String report() const;
+
+private:
+  struct Job {
+    I2cJobStats stats;
+    I2cJobFunction function;
+    uint32_t periodUs;
+    uint32_t nextDueUs;
+  };
+
+  void runDueJobs();
+  void addBusyTime(uint32_t us);
+
+  Job _jobs[I2C_MAX_JOBS];
+  int _jobCount;
+
+  I2cBusStats _stats;
+  uint32_t _windowStartUs;
+  uint32_t _windowBusyUs;
+  uint32_t _lastFlushUs;
+};
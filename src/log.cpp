@@ -0,0 +1,242 @@
+#include "log.h"
+
+#include <atomic>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+static_assert((LOG_SLOTS & (LOG_SLOTS - 1)) == 0, "LOG_SLOTS must be a power of two");
+
+// Bounded multi-producer queue (Vyukov): a slot's sequence number says
+// whether it is free for the producer at that position or holds a message
+// for the consumer.
+struct LogSlot {
+  std::atomic<uint32_t> sequence;
+  uint32_t time;
+  uint8_t module;
+  uint8_t level;
+  char text[LOG_LINE_MAX];
+};
+
+static LogSlot slots[LOG_SLOTS];
+static std::atomic<uint32_t> head(0);
+static uint32_t tail = 0; // consumer side, guarded by drainLock
+static std::atomic<uint32_t> dropped(0);
+static uint32_t droppedReported = 0;
+static std::atomic<bool> slotsReady(false);
+static std::atomic<uint8_t> levels[LOG_MODULE_COUNT];
+
+static SemaphoreHandle_t drainLock = nullptr;
+static SemaphoreHandle_t tailLock = nullptr;
+static char tailText[LOG_TAIL_SIZE];
+static size_t tailEnd = 0;   // next write position in tailText
+static bool tailWrapped = false;
+
+static const char* const MODULE_NAMES[LOG_MODULE_COUNT] = {
+  "sys", "pet", "net", "ota", "ble", "steps", "power"
+};
+static const char* const LEVEL_NAMES[] = {"debug", "info", "warn", "error", "off"};
+static const char LEVEL_LETTERS[] = "DIWE";
+
+// Slots need their sequence numbers before the first message, which may
+// come from a static constructor, so set them up on first use.
+static void initSlots() {
+  static std::atomic<bool> initializing(false);
+  if (slotsReady.load(std::memory_order_acquire)) {
+    return;
+  }
+  if (!initializing.exchange(true)) {
+    for (size_t i = 0; i < LOG_SLOTS; i++) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+      levels[i].store(LOG_INFO, std::memory_order_relaxed);
+    }
+    slotsReady.store(true, std::memory_order_release);
+  } else {
+    while (!slotsReady.load(std::memory_order_acquire)) {
+    }
+  }
+}
+
+void logWrite(LogModule module, LogLevel level, const char* format, ...) {
+  initSlots();
+  if (level < levels[module].load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  uint32_t position = head.load(std::memory_order_relaxed);
+  LogSlot* slot;
+  while (true) {
+    slot = &slots[position & (LOG_SLOTS - 1)];
+    int32_t diff = (int32_t)(slot->sequence.load(std::memory_order_acquire) - position);
+    if (diff == 0) {
+      if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      dropped.fetch_add(1, std::memory_order_relaxed); // full: never wait for the UART
+      return;
+    } else {
+      position = head.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->time = millis();
+  slot->module = module;
+  slot->level = level;
+  va_list args;
+  va_start(args, format);
+  vsnprintf(slot->text, LOG_LINE_MAX, format, args);
+  va_end(args);
+  slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+static void appendTail(const char* text, size_t len) {
+  if (tailLock) {
+    xSemaphoreTake(tailLock, portMAX_DELAY);
+  }
+  for (size_t i = 0; i < len; i++) {
+    tailText[tailEnd++] = text[i];
+    if (tailEnd == LOG_TAIL_SIZE) {
+      tailEnd = 0;
+      tailWrapped = true;
+    }
+  }
+  if (tailLock) {
+    xSemaphoreGive(tailLock);
+  }
+}
+
+static void emit(uint32_t time, char letter, const char* module, const char* text) {
+  char line[LOG_LINE_MAX + 32];
+  int len = snprintf(line, sizeof(line), "[%6lu.%03lu] %c %s: %s\n", (unsigned long)(time / 1000),
+                     (unsigned long)(time % 1000), letter, module, text);
+  if (len >= (int)sizeof(line)) {
+    len = sizeof(line) - 1;
+    line[len - 1] = '\n';
+  }
+  Serial.write((const uint8_t*)line, len);
+  appendTail(line, len);
+}
+
+static void drain() {
+  if (drainLock) {
+    xSemaphoreTake(drainLock, portMAX_DELAY);
+  }
+  initSlots();
+  while (true) {
+    LogSlot& slot = slots[tail & (LOG_SLOTS - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+      break;
+    }
+    emit(slot.time, LEVEL_LETTERS[slot.level], MODULE_NAMES[slot.module], slot.text);
+    slot.sequence.store(tail + LOG_SLOTS, std::memory_order_release);
+    tail++;
+  }
+
+  uint32_t lost = dropped.load(std::memory_order_relaxed);
+  if (lost != droppedReported) {
+    char text[48];
+    snprintf(text, sizeof(text), "%lu messages dropped (%lu total)",
+             (unsigned long)(lost - droppedReported), (unsigned long)lost);
+    emit(millis(), 'W', "log", text);
+    droppedReported = lost;
+  }
+  if (drainLock) {
+    xSemaphoreGive(drainLock);
+  }
+}
+
+static void drainTask(void*) {
+  while (true) {
+    drain();
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_MS));
+  }
+}
+
+void logBegin() {
+  if (drainLock) {
+    return;
+  }
+  initSlots();
+  drainLock = xSemaphoreCreateMutex();
+  tailLock = xSemaphoreCreateMutex();
+  // Below the WiFi and BT tasks on the protocol core, clear of loop()
+  xTaskCreatePinnedToCore(drainTask, "log", 3072, nullptr, 1, nullptr, 0);
+}
+
+void logSetLevel(LogModule module, LogLevel level) {
+  initSlots();
+  levels[module].store(level, std::memory_order_relaxed);
+}
+
+LogLevel logLevel(LogModule module) {
+  initSlots();
+  return (LogLevel)levels[module].load(std::memory_order_relaxed);
+}
+
+uint32_t logDropped() {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+void logFlush() {
+  drain();
+  Serial.flush();
+}
+
+String logTail() {
+  String text;
+  if (tailLock) {
+    xSemaphoreTake(tailLock, portMAX_DELAY);
+  }
+  text.reserve(LOG_TAIL_SIZE);
+  if (tailWrapped) {
+    // Skip the partial line the write position cut through
+    size_t start = tailEnd;
+    while (start < LOG_TAIL_SIZE && tailText[start] != '\n') {
+      start++;
+    }
+    for (size_t i = start + 1; i < LOG_TAIL_SIZE; i++) {
+      text += tailText[i];
+    }
+  }
+  for (size_t i = 0; i < tailEnd; i++) {
+    text += tailText[i];
+  }
+  if (tailLock) {
+    xSemaphoreGive(tailLock);
+  }
+  return text;
+}
+
+const char* logModuleName(LogModule module) {
+  return module < LOG_MODULE_COUNT ? MODULE_NAMES[module] : "?";
+}
+
+const char* logLevelName(LogLevel level) {
+  return level <= LOG_OFF ? LEVEL_NAMES[level] : "?";
+}
+
+bool logParseModule(const char* name, LogModule& module) {
+  for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+    if (strcmp(name, MODULE_NAMES[i]) == 0) {
+      module = (LogModule)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool logParseLevel(const char* name, LogLevel& level) {
+  for (int i = 0; i <= LOG_OFF; i++) {
+    if (strcmp(name, LEVEL_NAMES[i]) == 0) {
+      level = (LogLevel)i;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Non-blocking logger. Callers format into a fixed ring of slots in RAM and
+// return straight away; a low-priority task drains the ring to Serial and
+// into a text tail served on /log. A slot is claimed with a single
+// compare-and-swap, so the loop task, the BLE stack and the web server can
+// all log at once without locks. When the ring is full the message is
+// dropped and counted rather than waiting for the UART.
+//
+//   LOGI(LOG_PET, "Steps today: %u", steps);
+//
+// Each module has its own minimum level (LOG_INFO by default); messages
+// below it cost one load and a compare.
+
+enum LogLevel {
+  LOG_DEBUG,
+  LOG_INFO,
+  LOG_WARN,
+  LOG_ERROR,
+  LOG_OFF
+};
+
+enum LogModule {
+  LOG_SYS,    // boot, storage
+  LOG_PET,    // behaviour, needs, feeding
+  LOG_NET,    // WiFi, web server
+  LOG_OTA,
+  LOG_BLE,
+  LOG_STEPS,
+  LOG_POWER,  // night mode, frame pacing
+  LOG_MODULE_COUNT
+};
+
+const size_t LOG_SLOTS = 64;          // power of two
+const size_t LOG_LINE_MAX = 96;       // longer messages are truncated
+const size_t LOG_TAIL_SIZE = 4096;    // most recent output kept for /log
+const uint32_t LOG_DRAIN_MS = 20;
+
+// Start the drain task. Messages logged before this wait in the ring.
+void logBegin();
+
+void logWrite(LogModule module, LogLevel level, const char* format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+void logSetLevel(LogModule module, LogLevel level);
+LogLevel logLevel(LogModule module);
+uint32_t logDropped();
+
+// Drain everything queued so far from the calling task and wait for the
+// UART - for just before a restart or deep sleep.
+void logFlush();
+
+// Recent output, oldest first
+String logTail();
+
+const char* logModuleName(LogModule module);
+const char* logLevelName(LogLevel level);
+bool logParseModule(const char* name, LogModule& module);
+bool logParseLevel(const char* name, LogLevel& level);
+
+#define LOGD(module, ...) logWrite(module, LOG_DEBUG, __VA_ARGS__)
+#define LOGI(module, ...) logWrite(module, LOG_INFO, __VA_ARGS__)
+#define LOGW(module, ...) logWrite(module, LOG_WARN, __VA_ARGS__)
+#define LOGE(module, ...) logWrite(module, LOG_ERROR, __VA_ARGS__)
@@ -0,0 +1,86 @@
+#include "night_mode.h"
+#include "log.h"
+
+#include <esp_sleep.h>
+#include <sys/time.h>
+
+static const uint32_t SNAPSHOT_MAGIC = 0x4E495431; // "NIT1"
+
+// RTC slow memory: zeroed on power-on, kept across deep sleep
+RTC_DATA_ATTR static uint32_t rtcMagic;
+RTC_DATA_ATTR static PetSnapshot rtcSnapshot;
+RTC_DATA_ATTR static time_t rtcSleepStart;
+RTC_DATA_ATTR static uint64_t rtcAwakeMs;
+RTC_DATA_ATTR static uint64_t rtcAsleepMs;
+
+NightWake nightWakeCause() {
+  switch (esp_sleep_get_wakeup_cause()) {
+    case ESP_SLEEP_WAKEUP_TIMER: return NIGHT_WAKE_TIMER;
+    case ESP_SLEEP_WAKEUP_EXT0: return NIGHT_WAKE_BUTTON;
+    default: return NIGHT_WAKE_NONE;
+  }
+}
+
+bool nightRestore(PetSnapshot& snapshot, uint32_t& sleptSeconds) {
+  if (nightWakeCause() == NIGHT_WAKE_NONE || rtcMagic != SNAPSHOT_MAGIC) {
+    return false;
+  }
+  rtcMagic = 0; // a later reset must not resume from a stale snapshot
+  snapshot = rtcSnapshot;
+
+  time_t now = time(nullptr);
+  sleptSeconds = now > rtcSleepStart ? (uint32_t)(now - rtcSleepStart) : 0;
+  rtcAsleepMs += (uint64_t)sleptSeconds * 1000;
+  return true;
+}
+
+static int secondOfDay(const struct tm& local) {
+  return local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+}
+
+bool nightTime(const struct tm& local) {
+  int hour = local.tm_hour;
+  if (NIGHT_START_HOUR > NIGHT_END_HOUR) {
+    return hour >= NIGHT_START_HOUR || hour < NIGHT_END_HOUR;
+  }
+  return hour >= NIGHT_START_HOUR && hour < NIGHT_END_HOUR;
+}
+
+uint32_t nightSecondsUntilMorning(const struct tm& local) {
+  int seconds = NIGHT_END_HOUR * 3600 - secondOfDay(local);
+  if (seconds <= 0) {
+    seconds += 24 * 3600;
+  }
+  return seconds;
+}
+
+void nightSleep(const PetSnapshot& snapshot, uint32_t seconds) {
+  rtcSnapshot = snapshot;
+  rtcMagic = SNAPSHOT_MAGIC;
+  rtcSleepStart = time(nullptr);
+  rtcAwakeMs += millis();
+
+  LOGI(LOG_POWER, "Night mode: sleeping for %u s", seconds);
+  logFlush();
+
+  esp_sleep_enable_timer_wakeup((uint64_t)seconds * 1000000ULL);
+  esp_sleep_enable_ext0_wakeup(NIGHT_WAKE_PIN, 0);
+  esp_deep_sleep_start();
+}
+
+String nightReport() {
+  uint64_t awake = rtcAwakeMs + millis();
+  uint64_t total = awake + rtcAsleepMs;
+  float awakeShare = total ? (float)awake / total : 1.0f;
+  float measured = awakeShare * NIGHT_AWAKE_MA + (1 - awakeShare) * NIGHT_ASLEEP_MA;
+
+  float nightHours = (NIGHT_END_HOUR - NIGHT_START_HOUR + 24) % 24;
+  float scheduled = ((24 - nightHours) * NIGHT_AWAKE_MA + nightHours * NIGHT_ASLEEP_MA) / 24;
+
+  String text = "awake " + String((uint32_t)(awake / 1000)) + " s, asleep " +
+                String((uint32_t)(rtcAsleepMs / 1000)) + " s since power-on\n";
+  text += "average current: " + String(measured, 1) + " mA measured, " + String(scheduled, 1) +
+          " mA for a " + String(nightHours, 0) + " h night, " + String(NIGHT_AWAKE_MA, 0) +
+          " mA always on\n";
+  return text;
+}
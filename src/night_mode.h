@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/gpio.h>
+#include <time.h>
+
+#include "pet_needs.h"
+
+// Night mode: the pet deep-sleeps through the night (or a long idle spell)
+// with the OLED and accelerometer powered down, and carries on with exactly
+// the same expression when it wakes.
+//
+// What the pet looked like and its need anchors are kept in RTC slow memory,
+// which survives deep sleep, so the wake path can draw the first frame
+// straight away - before Preferences, WiFi or BLE are touched. The system
+// clock keeps running through deep sleep, so the needs simply evaluate
+// across the gap.
+//
+// Wake sources: the RTC timer (morning, or the end of a daytime nap) and
+// the BOOT button. A button press at night only lets you peek at the pet;
+// the network stays off and it goes back to sleep shortly after.
+
+const int NIGHT_START_HOUR = 23;               // local time
+const int NIGHT_END_HOUR = 7;
+const unsigned long NIGHT_SETTLE_MS = 120000;  // quiet time at night before sleeping
+const unsigned long NIGHT_IDLE_MS = 1800000;   // daytime inactivity before a nap
+const unsigned long NIGHT_PEEK_MS = 20000;     // awake after a button press at night
+const uint32_t NIGHT_NAP_S = 3600;
+const uint32_t NIGHT_RESTED_S = 4 * 3600;      // a sleep this long refills energy
+const gpio_num_t NIGHT_WAKE_PIN = GPIO_NUM_0;  // BOOT button, active low
+
+// Rough supply current per state, for the 24 h estimate. Awake: 240 MHz
+// CPU, WiFi modem sleep, BLE advertising and a mostly dark OLED. Asleep:
+// ESP32 deep sleep with RTC timer and ext0 wake, SSD1306 display-off and
+// LIS3DH power-down; board regulators and USB bridges come on top.
+const float NIGHT_AWAKE_MA = 100.0f;
+const float NIGHT_ASLEEP_MA = 0.03f;
+
+enum NightWake {
+  NIGHT_WAKE_NONE,   // power-on or reset, not a night-mode wake
+  NIGHT_WAKE_TIMER,
+  NIGHT_WAKE_BUTTON
+};
+
+// Everything needed to pick up where the pet left off
+struct PetSnapshot {
+  uint8_t eyeState;
+  bool needMood;      // eyeState was chosen by the needs, not by hand
+  bool manualMode;
+  bool readingLight;
+  NeedAnchor needs[NEED_COUNT];
+  uint32_t steps;
+  uint32_t stepDay;
+};
+
+NightWake nightWakeCause();
+
+// Fetch the snapshot taken before the last night-mode sleep. Only succeeds
+// once per sleep, and only after a timer or button wake.
+bool nightRestore(PetSnapshot& snapshot, uint32_t& sleptSeconds);
+
+bool nightTime(const struct tm& local);
+uint32_t nightSecondsUntilMorning(const struct tm& local);
+
+// Store the snapshot in RTC memory and deep-sleep for the given time or
+// until the button is pressed. Peripherals must already be powered down.
+[[noreturn]] void nightSleep(const PetSnapshot& snapshot, uint32_t seconds);
+
+// Measured awake/asleep split since power-on and the average current it
+// implies, next to the estimate for a plain scheduled night.
+String nightReport();
@@ -0,0 +1,258 @@
+#include "ota_decode.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+#include <rom/miniz.h> // tinfl lives in ROM, so inflate costs no flash
+
+#ifdef ARDUINO
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#endif
+
+static uint32_t readLE32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// The zlib header's first byte (CMF): deflate, with a window that fits
+// ours. tinfl would otherwise reach back past the start of the window and
+// quietly produce the wrong bytes.
+static bool windowFits(uint8_t cmf) {
+  int method = cmf & 0x0f;
+  int windowBits = (cmf >> 4) + 8;
+  return method == 8 && windowBits <= OTA_WINDOW_BITS;
+}
+
+OtaDecoder::OtaDecoder(OtaStream& out, OtaBaseImage* base)
+  : _out(out), _base(base), _encoding(OTA_ENCODING_RAW), _status(OTA_STREAM_IDLE), _received(0),
+    _inflator(nullptr), _window(nullptr), _windowPos(0), _inflateDone(false),
+    _headerLen(0), _opHeaderLen(0), _op(0), _opOffset(0), _opRemaining(0), _targetSize(0),
+    _baseSize(0) {
+}
+
+OtaDecoder::~OtaDecoder() {
+  release();
+}
+
+bool OtaDecoder::parseEncoding(const char* name, OtaEncoding& encoding) {
+  if (name == nullptr || name[0] == '\0' || strcmp(name, "raw") == 0) {
+    encoding = OTA_ENCODING_RAW;
+  } else if (strcmp(name, "zlib") == 0) {
+    encoding = OTA_ENCODING_ZLIB;
+  } else if (strcmp(name, "delta") == 0) {
+    encoding = OTA_ENCODING_DELTA;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void OtaDecoder::release() {
+  free(_inflator);
+  free(_window);
+  _inflator = nullptr;
+  _window = nullptr;
+}
+
+OtaStreamStatus OtaDecoder::fail(OtaStreamStatus status) {
+  _out.abort();
+  release();
+  _status = status;
+  return status;
+}
+
+OtaStreamStatus OtaDecoder::lastStatus() const {
+  return _status != OTA_STREAM_OK ? _status : _out.lastStatus();
+}
+
+OtaStreamStatus OtaDecoder::begin(OtaEncoding encoding, size_t imageSize, const char* expectedDigestHex) {
+  release();
+  _encoding = encoding;
+  _status = OTA_STREAM_OK;
+  _received = 0;
+  _windowPos = 0;
+  _inflateDone = false;
+  _headerLen = 0;
+  _opHeaderLen = 0;
+  _op = 0;
+  _opRemaining = 0;
+  _targetSize = 0;
+
+  if (encoding == OTA_ENCODING_DELTA && _base == nullptr) {
+    return fail(OTA_STREAM_BEGIN_FAILED);
+  }
+  if (encoding != OTA_ENCODING_RAW) {
+    _inflator = malloc(sizeof(tinfl_decompressor));
+    _window = (uint8_t*)malloc(OTA_WINDOW_SIZE);
+    if (_inflator == nullptr || _window == nullptr) {
+      return fail(OTA_STREAM_BEGIN_FAILED);
+    }
+    tinfl_init((tinfl_decompressor*)_inflator);
+  }
+  return _out.begin(imageSize, expectedDigestHex);
+}
+
+OtaStreamStatus OtaDecoder::write(const uint8_t* data, size_t len) {
+  if (!_out.active()) {
+    return lastStatus();
+  }
+  if (_encoding == OTA_ENCODING_RAW) {
+    _received += len;
+    return _out.write(data, len);
+  }
+  if (_received == 0 && len > 0 && !windowFits(data[0])) {
+    return fail(OTA_STREAM_DECODE_FAILED);
+  }
+  _received += len;
+  return inflate(data, len);
+}
+
+OtaStreamStatus OtaDecoder::end() {
+  if (!_out.active()) {
+    release();
+    return lastStatus();
+  }
+  if (_encoding != OTA_ENCODING_RAW && !_inflateDone) {
+    return fail(OTA_STREAM_DECODE_FAILED); // truncated stream
+  }
+  if (_encoding == OTA_ENCODING_DELTA && (_headerLen < sizeof(_header) || _opHeaderLen != 0 || _opRemaining != 0 ||
+                                          _out.written() != _targetSize)) {
+    return fail(OTA_STREAM_DECODE_FAILED);
+  }
+  release();
+  return _out.end();
+}
+
+void OtaDecoder::abort() {
+  fail(OTA_STREAM_IDLE);
+}
+
+// Inflate into a circular window; every byte produced is handed on as soon
+// as it is available, so at most one window of output is ever held.
+OtaStreamStatus OtaDecoder::inflate(const uint8_t* data, size_t len) {
+  tinfl_decompressor* inflator = (tinfl_decompressor*)_inflator;
+
+  while (!_inflateDone) {
+    size_t inBytes = len;
+    size_t outBytes = OTA_WINDOW_SIZE - _windowPos;
+    tinfl_status status = tinfl_decompress(
+      inflator, data, &inBytes, _window, _window + _windowPos, &outBytes,
+      TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_HAS_MORE_INPUT);
+    data += inBytes;
+    len -= inBytes;
+
+    if (status < TINFL_STATUS_DONE) {
+      return fail(OTA_STREAM_DECODE_FAILED);
+    }
+    if (outBytes > 0) {
+      OtaStreamStatus result = decoded(_window + _windowPos, outBytes);
+      if (result != OTA_STREAM_OK) {
+        return result;
+      }
+      _windowPos = (_windowPos + outBytes) & (OTA_WINDOW_SIZE - 1);
+    }
+    if (status == TINFL_STATUS_DONE) {
+      _inflateDone = true;
+    } else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && len == 0) {
+      break;
+    }
+  }
+  return OTA_STREAM_OK;
+}
+
+OtaStreamStatus OtaDecoder::decoded(const uint8_t* data, size_t len) {
+  if (_encoding == OTA_ENCODING_DELTA) {
+    return patch(data, len);
+  }
+  return _out.write(data, len);
+}
+
+OtaStreamStatus OtaDecoder::patch(const uint8_t* data, size_t len) {
+  while (len > 0) {
+    // Patch header
+    if (_headerLen < sizeof(_header)) {
+      size_t take = std::min(len, sizeof(_header) - _headerLen);
+      memcpy(_header + _headerLen, data, take);
+      _headerLen += take;
+      data += take;
+      len -= take;
+      if (_headerLen == sizeof(_header)) {
+        if (memcmp(_header, "WPD1", 4) != 0) {
+          return fail(OTA_STREAM_DECODE_FAILED);
+        }
+        _targetSize = readLE32(_header + 4);
+        _baseSize = readLE32(_header + 8);
+        if ((_out.expectedSize() > 0 && _targetSize != _out.expectedSize()) || _baseSize > _base->size()) {
+          return fail(OTA_STREAM_DECODE_FAILED);
+        }
+      }
+      continue;
+    }
+
+    // Next op header
+    if (_opRemaining == 0) {
+      size_t take = std::min(len, sizeof(_opHeader) - _opHeaderLen);
+      memcpy(_opHeader + _opHeaderLen, data, take);
+      _opHeaderLen += take;
+      data += take;
+      len -= take;
+      if (_opHeaderLen < sizeof(_opHeader)) {
+        continue;
+      }
+      _opHeaderLen = 0;
+      _op = _opHeader[0];
+      _opOffset = readLE32(_opHeader + 1);
+      _opRemaining = readLE32(_opHeader + 5);
+      if ((_op != OTA_DELTA_DIFF && _op != OTA_DELTA_DATA) ||
+          (_op == OTA_DELTA_DIFF && (uint64_t)_opOffset + _opRemaining > _baseSize)) {
+        return fail(OTA_STREAM_DECODE_FAILED);
+      }
+      continue;
+    }
+
+    size_t take = std::min(len, (size_t)_opRemaining);
+    if (_op == OTA_DELTA_DATA) {
+      OtaStreamStatus result = patchOutput(data, take);
+      if (result != OTA_STREAM_OK) {
+        return result;
+      }
+    } else {
+      // Add the diff bytes onto the base image in small slices
+      uint8_t slice[128];
+      take = std::min(take, sizeof(slice));
+      if (!_base->read(_opOffset, slice, take)) {
+        return fail(OTA_STREAM_DECODE_FAILED);
+      }
+      for (size_t i = 0; i < take; i++) {
+        slice[i] += data[i];
+      }
+      OtaStreamStatus result = patchOutput(slice, take);
+      if (result != OTA_STREAM_OK) {
+        return result;
+      }
+      _opOffset += take;
+    }
+    data += take;
+    len -= take;
+    _opRemaining -= take;
+  }
+  return OTA_STREAM_OK;
+}
+
+// Patched image bytes, no further than the size the patch promised
+OtaStreamStatus OtaDecoder::patchOutput(const uint8_t* data, size_t len) {
+  if (len > _targetSize - _out.written()) {
+    return fail(OTA_STREAM_DECODE_FAILED);
+  }
+  return _out.write(data, len);
+}
+
+#ifdef ARDUINO
+size_t RunningPartitionImage::size() {
+  return esp_ota_get_running_partition()->size;
+}
+
+bool RunningPartitionImage::read(size_t offset, uint8_t* out, size_t len) {
+  return esp_partition_read(esp_ota_get_running_partition(), offset, out, len) == ESP_OK;
+}
+#endif
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ota_stream.h"
+
+// Decodes compressed or delta-encoded firmware uploads on the fly and feeds
+// the reconstructed image into an OtaStream, so the SHA-256 check always
+// covers the final image no matter how it travelled over the wire.
+//
+//   raw   - image bytes as-is
+//   zlib  - image compressed with zlib, window limited to OTA_WINDOW_BITS
+//   delta - zlib-compressed patch against the running firmware
+//           (produced by tools/ota_delta.py)
+//
+// Delta patch layout (little endian), after decompression:
+//   "WPD1" u32 targetSize u32 baseSize
+//   (the ops must produce exactly targetSize bytes, which must agree with
+//   the image size the uploader gave, if it gave one)
+//   then ops, each a 9 byte header  u8 op, u32 a, u32 b:
+//     OTA_DELTA_DIFF  a = base offset, b = length, followed by b bytes that
+//                     are added (mod 256) to the base bytes at that offset
+//     OTA_DELTA_DATA  b = length, followed by b literal bytes
+
+enum OtaEncoding {
+  OTA_ENCODING_RAW,
+  OTA_ENCODING_ZLIB,
+  OTA_ENCODING_DELTA
+};
+
+// 4 KB inflate window - the host compresses with the same limit, and the
+// window size in the zlib header (CINFO, in the first byte) is checked
+// against it before any of the stream is inflated.
+const int OTA_WINDOW_BITS = 12;
+const size_t OTA_WINDOW_SIZE = 1 << OTA_WINDOW_BITS;
+
+const uint8_t OTA_DELTA_DIFF = 1;
+const uint8_t OTA_DELTA_DATA = 2;
+
+// Read-only view of the firmware a delta is applied against.
+class OtaBaseImage {
+public:
+  virtual ~OtaBaseImage() {}
+  virtual size_t size() = 0;
+  virtual bool read(size_t offset, uint8_t* out, size_t len) = 0;
+};
+
+class OtaDecoder {
+public:
+  OtaDecoder(OtaStream& out, OtaBaseImage* base);
+  ~OtaDecoder();
+
+  OtaStreamStatus begin(OtaEncoding encoding, size_t imageSize, const char* expectedDigestHex);
+  OtaStreamStatus write(const uint8_t* data, size_t len);
+  OtaStreamStatus end();
+  void abort();
+
+  size_t received() const { return _received; } // bytes on the wire
+  size_t written() const { return _out.written(); } // decoded image bytes
+  OtaStreamStatus lastStatus() const;
+
+  static bool parseEncoding(const char* name, OtaEncoding& encoding);
+
+private:
+  OtaStreamStatus fail(OtaStreamStatus status);
+  OtaStreamStatus inflate(const uint8_t* data, size_t len);
+  OtaStreamStatus decoded(const uint8_t* data, size_t len);
+  OtaStreamStatus patch(const uint8_t* data, size_t len);
+  OtaStreamStatus patchOutput(const uint8_t* data, size_t len);
+  void release();
+
+  OtaStream& _out;
+  OtaBaseImage* _base;
+  OtaEncoding _encoding;
+  OtaStreamStatus _status;
+  size_t _received;
+
+  // zlib state
+  void* _inflator; // tinfl_decompressor
+  uint8_t* _window;
+  size_t _windowPos;
+  bool _inflateDone;
+
+  // delta state
+  uint8_t _header[12];
+  size_t _headerLen;
+  uint8_t _opHeader[9];
+  size_t _opHeaderLen;
+  uint8_t _op;
+  uint32_t _opOffset;
+  uint32_t _opRemaining;
+  uint32_t _targetSize;
+  uint32_t _baseSize;
+};
+
+#ifdef ARDUINO
+// OtaBaseImage over the currently running app partition.
+class RunningPartitionImage : public OtaBaseImage {
+public:
+  size_t size() override;
+  bool read(size_t offset, uint8_t* out, size_t len) override;
+};
+#endif
@@ -0,0 +1,64 @@
+#include "ota_http.h"
+
+OtaHttpUpload::OtaHttpUpload(OtaDecoder& decoder, IdleCallback onIdle)
+  : _decoder(decoder), _onIdle(onIdle), _rejected(OTA_STREAM_OK), _size(0), _startTime(0),
+    _started(false), _inProgress(false) {
+}
+
+void OtaHttpUpload::start(const char* encoding, size_t size, const char* expectedDigestHex, unsigned long now) {
+  _size = size;
+  _startTime = now;
+  _started = true;
+  _inProgress = true;
+  _rejected = OTA_STREAM_OK;
+
+  OtaEncoding parsed;
+  if (!OtaDecoder::parseEncoding(encoding, parsed)) {
+    _decoder.abort();
+    _rejected = OTA_STREAM_BAD_ENCODING;
+    return;
+  }
+  _decoder.begin(parsed, size, expectedDigestHex);
+}
+
+bool OtaHttpUpload::write(const uint8_t* data, size_t len) {
+  if (_rejected != OTA_STREAM_OK) {
+    return false;
+  }
+  size_t before = _decoder.written();
+  _decoder.write(data, len);
+  return _decoder.written() != before;
+}
+
+void OtaHttpUpload::end() {
+  if (_rejected == OTA_STREAM_OK) {
+    _decoder.end();
+  }
+}
+
+void OtaHttpUpload::abort() {
+  _decoder.abort();
+  stop();
+}
+
+void OtaHttpUpload::stop() {
+  _started = false;
+  _rejected = OTA_STREAM_OK;
+  _size = 0;
+  if (_inProgress) {
+    _inProgress = false;
+    if (_onIdle) {
+      _onIdle();
+    }
+  }
+}
+
+OtaStreamStatus OtaHttpUpload::status() const {
+  if (!_started) {
+    return OTA_STREAM_IDLE;
+  }
+  if (_rejected != OTA_STREAM_OK) {
+    return _rejected;
+  }
+  return _decoder.lastStatus();
+}
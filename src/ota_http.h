@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ota_decode.h"
+
+// The /update route's side of a firmware upload, across the web server's
+// callbacks: start, data, end or the client going away, then the done
+// handler that answers the request. Holds the screen from start until the
+// upload is answered or abandoned, and calls onIdle when it lets go, so
+// the sketch can redraw the face.
+//
+// A request whose encoding isn't known is rejected at the start and its
+// data ignored; the done handler reports that rather than the outcome of
+// an earlier upload, and a done without a start reports no update.
+
+class OtaHttpUpload {
+public:
+  typedef void (*IdleCallback)();
+
+  OtaHttpUpload(OtaDecoder& decoder, IdleCallback onIdle = nullptr);
+
+  void start(const char* encoding, size_t size, const char* expectedDigestHex, unsigned long now);
+  // Returns true if the image grew
+  bool write(const uint8_t* data, size_t len);
+  void end();
+  // The client disconnected mid-upload: nothing more will come, not even
+  // the done handler
+  void abort();
+  // After the done handler has answered a failed upload
+  void stop();
+
+  // OTA_STREAM_OK once an upload has decoded and verified, OTA_STREAM_IDLE
+  // if none was started since the last stop()
+  OtaStreamStatus status() const;
+
+  bool inProgress() const { return _inProgress; }
+  size_t size() const { return _size; }            // announced, 0 if unknown
+  size_t received() const { return _decoder.received(); }
+  size_t written() const { return _decoder.written(); }
+  unsigned long startTime() const { return _startTime; }
+
+private:
+  OtaDecoder& _decoder;
+  IdleCallback _onIdle;
+  OtaStreamStatus _rejected; // OTA_STREAM_OK unless start() refused it
+  size_t _size;
+  unsigned long _startTime;
+  bool _started;
+  bool _inProgress;
+};
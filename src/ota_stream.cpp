@@ -0,0 +1,198 @@
+#include "ota_stream.h"
+
+#include <string.h>
+#include <mbedtls/sha256.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <Update.h>
+#include <esp_ota_ops.h>
+#include "log.h"
+#endif
+
+static int hexNibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+OtaStream::OtaStream(OtaSink& sink)
+  : _sink(sink), _sha(new mbedtls_sha256_context), _size(0), _written(0),
+    _active(false), _status(OTA_STREAM_IDLE) {
+  memset(_expected, 0, sizeof(_expected));
+}
+
+OtaStream::~OtaStream() {
+  if (_active) {
+    abort();
+  }
+  delete static_cast<mbedtls_sha256_context*>(_sha);
+}
+
+bool OtaStream::parseDigest(const char* hex, uint8_t out[OTA_DIGEST_LEN]) {
+  if (hex == nullptr || strlen(hex) != OTA_DIGEST_LEN * 2) {
+    return false;
+  }
+  for (size_t i = 0; i < OTA_DIGEST_LEN; i++) {
+    int hi = hexNibble(hex[i * 2]);
+    int lo = hexNibble(hex[i * 2 + 1]);
+    if (hi < 0 || lo < 0) {
+      return false;
+    }
+    out[i] = (uint8_t)((hi << 4) | lo);
+  }
+  return true;
+}
+
+OtaStreamStatus OtaStream::fail(OtaStreamStatus status) {
+  if (_active) {
+    _sink.abort();
+    mbedtls_sha256_free(static_cast<mbedtls_sha256_context*>(_sha));
+    _active = false;
+  }
+  _status = status;
+  return status;
+}
+
+OtaStreamStatus OtaStream::begin(size_t size, const char* expectedDigestHex) {
+  if (_active) {
+    abort();
+  }
+  _size = size;
+  _written = 0;
+
+  if (!parseDigest(expectedDigestHex, _expected)) {
+    return fail(OTA_STREAM_BAD_DIGEST_ARG);
+  }
+  if (!_sink.begin(size)) {
+    return fail(OTA_STREAM_BEGIN_FAILED);
+  }
+
+  mbedtls_sha256_context* sha = static_cast<mbedtls_sha256_context*>(_sha);
+  mbedtls_sha256_init(sha);
+  mbedtls_sha256_starts(sha, 0); // 0 = SHA-256, not SHA-224
+  _active = true;
+  _status = OTA_STREAM_OK;
+  return _status;
+}
+
+OtaStreamStatus OtaStream::write(const uint8_t* data, size_t len) {
+  if (!_active) {
+    return OTA_STREAM_IDLE;
+  }
+  // Hash before writing so the digest covers exactly what reached flash
+  mbedtls_sha256_update(static_cast<mbedtls_sha256_context*>(_sha), data, len);
+  if (_sink.write(data, len) != len) {
+    return fail(OTA_STREAM_WRITE_FAILED);
+  }
+  _written += len;
+  return OTA_STREAM_OK;
+}
+
+OtaStreamStatus OtaStream::end() {
+  if (!_active) {
+    return OTA_STREAM_IDLE;
+  }
+
+  uint8_t digest[OTA_DIGEST_LEN];
+  mbedtls_sha256_context* sha = static_cast<mbedtls_sha256_context*>(_sha);
+  mbedtls_sha256_finish(sha, digest);
+  mbedtls_sha256_free(sha);
+
+  // Constant-time compare so a bad upload can't probe the digest byte by byte
+  uint8_t diff = 0;
+  for (size_t i = 0; i < OTA_DIGEST_LEN; i++) {
+    diff |= digest[i] ^ _expected[i];
+  }
+  if (diff != 0 || (_size > 0 && _written != _size)) {
+    _sink.abort();
+    _active = false;
+    _status = OTA_STREAM_DIGEST_MISMATCH;
+    return _status;
+  }
+
+  _active = false;
+  if (!_sink.commit()) {
+    _status = OTA_STREAM_END_FAILED;
+    return _status;
+  }
+  _status = OTA_STREAM_OK;
+  return _status;
+}
+
+void OtaStream::abort() {
+  fail(OTA_STREAM_IDLE);
+}
+
+const char* OtaStream::statusString(OtaStreamStatus status) {
+  switch (status) {
+    case OTA_STREAM_OK:              return "OK";
+    case OTA_STREAM_IDLE:            return "No update in progress";
+    case OTA_STREAM_BAD_DIGEST_ARG:  return "Missing or malformed sha256";
+    case OTA_STREAM_BEGIN_FAILED:    return "Begin Failed";
+    case OTA_STREAM_WRITE_FAILED:    return "Write Failed";
+    case OTA_STREAM_DIGEST_MISMATCH: return "Digest mismatch";
+    case OTA_STREAM_END_FAILED:      return "End Failed";
+    case OTA_STREAM_DECODE_FAILED:   return "Decode Failed";
+    case OTA_STREAM_BAD_ENCODING:    return "Unknown encoding";
+  }
+  return "Unknown";
+}
+
+#ifdef ARDUINO
+bool UpdatePartitionSink::begin(size_t size) {
+  return Update.begin(size > 0 ? size : UPDATE_SIZE_UNKNOWN, U_FLASH);
+}
+
+size_t UpdatePartitionSink::write(const uint8_t* data, size_t len) {
+  // Update buffers internally up to one flash sector and erases/writes
+  // sector by sector, so arbitrary HTTP chunk sizes are fine here.
+  return Update.write(const_cast<uint8_t*>(data), len);
+}
+
+bool UpdatePartitionSink::commit() {
+  // evenIfRemaining=true: size may not have been known up front
+  return Update.end(true);
+}
+
+void UpdatePartitionSink::abort() {
+  Update.abort();
+}
+
+// Tell the Arduino core not to mark every boot valid automatically;
+// otaHealthCheck() does it once the new image has proven itself.
+extern "C" bool verifyRollbackLater() {
+  return true;
+}
+
+static bool healthConfirmed = false;
+
+bool otaPendingVerify() {
+  esp_ota_img_states_t state;
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  if (esp_ota_get_state_partition(running, &state) != ESP_OK) {
+    return false;
+  }
+  return state == ESP_OTA_IMG_PENDING_VERIFY;
+}
+
+void otaHealthCheck(unsigned long currentTime, OtaHealthProbe healthy) {
+  if (healthConfirmed || currentTime < OTA_HEALTH_CHECK_MS) {
+    return;
+  }
+  healthConfirmed = true;
+
+  if (!otaPendingVerify()) {
+    return; // Not a fresh OTA boot, or rollback disabled in the bootloader
+  }
+  if (healthy()) {
+    esp_ota_mark_app_valid_cancel_rollback();
+    LOGI(LOG_OTA, "OTA image passed health check, marked valid.");
+  } else {
+    LOGE(LOG_OTA, "OTA image failed health check, rolling back.");
+    logFlush();
+    esp_ota_mark_app_invalid_rollback_and_reboot();
+  }
+}
+#endif
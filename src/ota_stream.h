@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Streams a firmware image into the inactive OTA partition chunk by chunk,
+// hashing it with SHA-256 as it goes. Nothing is buffered beyond the chunk
+// being written, and the boot partition is only switched once the digest
+// matches the one supplied by the uploader.
+
+enum OtaStreamStatus {
+  OTA_STREAM_OK,
+  OTA_STREAM_IDLE,            // write()/end() called before begin()
+  OTA_STREAM_BAD_DIGEST_ARG,  // expected digest missing or not 64 hex chars
+  OTA_STREAM_BEGIN_FAILED,    // no OTA partition or image too large
+  OTA_STREAM_WRITE_FAILED,    // flash write error
+  OTA_STREAM_DIGEST_MISMATCH, // image does not match the expected digest
+  OTA_STREAM_END_FAILED,      // image rejected when switching partitions
+  OTA_STREAM_DECODE_FAILED,   // corrupt compressed or delta payload
+  OTA_STREAM_BAD_ENCODING     // upload encoding not raw, zlib or delta
+};
+
+const size_t OTA_DIGEST_LEN = 32;
+
+// Where the image bytes go. The device uses the Update partition writer;
+// a host stand-in can implement this to exercise the same code path.
+class OtaSink {
+public:
+  virtual ~OtaSink() {}
+  virtual bool begin(size_t size) = 0;
+  virtual size_t write(const uint8_t* data, size_t len) = 0;
+  virtual bool commit() = 0; // make the written image the next boot image
+  virtual void abort() = 0;
+};
+
+class OtaStream {
+public:
+  explicit OtaStream(OtaSink& sink);
+  ~OtaStream();
+
+  // size may be 0 if the uploader did not send it.
+  OtaStreamStatus begin(size_t size, const char* expectedDigestHex);
+  OtaStreamStatus write(const uint8_t* data, size_t len);
+  OtaStreamStatus end();
+  void abort();
+
+  bool active() const { return _active; }
+  size_t written() const { return _written; }
+  size_t expectedSize() const { return _size; }
+  OtaStreamStatus lastStatus() const { return _status; }
+
+  static const char* statusString(OtaStreamStatus status);
+  static bool parseDigest(const char* hex, uint8_t out[OTA_DIGEST_LEN]);
+
+private:
+  OtaStreamStatus fail(OtaStreamStatus status);
+
+  OtaSink& _sink;
+  void* _sha; // mbedtls_sha256_context, kept opaque to keep mbedtls out of the header
+  uint8_t _expected[OTA_DIGEST_LEN];
+  size_t _size;
+  size_t _written;
+  bool _active;
+  OtaStreamStatus _status;
+};
+
+#ifdef ARDUINO
+// OtaSink backed by the Arduino Update class (inactive app partition).
+class UpdatePartitionSink : public OtaSink {
+public:
+  bool begin(size_t size) override;
+  size_t write(const uint8_t* data, size_t len) override;
+  bool commit() override;
+  void abort() override;
+};
+
+// Rollback support. A freshly flashed image boots in "pending verify" state.
+// After OTA_HEALTH_CHECK_MS, otaHealthCheck() asks healthy() once whether the
+// image has done its job, and keeps it or rolls back on the answer. If it
+// crashes or resets before then, the bootloader falls back as well.
+const unsigned long OTA_HEALTH_CHECK_MS = 30000;
+
+typedef bool (*OtaHealthProbe)();
+
+bool otaPendingVerify();
+void otaHealthCheck(unsigned long currentTime, OtaHealthProbe healthy);
+#endif
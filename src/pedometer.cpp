@@ -0,0 +1,102 @@
+#include "pedometer.h"
+
+// Band-pass biquad, centre 2 Hz, Q 0.7 at 50 Hz (RBJ cookbook, constant
+// 0 dB peak gain), normalised by a0 and scaled by 2^14. b1 is 0, b2 = -b0.
+static const int32_t BP_B0 = 2471;
+static const int32_t BP_A1 = -26951;
+static const int32_t BP_A2 = 11441;
+static const int BP_SHIFT = 14;
+
+static const uint32_t MIN_STEP_SAMPLES = PEDOMETER_MIN_STEP_MS * PEDOMETER_SAMPLE_HZ / 1000;
+static const uint32_t MAX_STEP_SAMPLES = PEDOMETER_MAX_STEP_MS * PEDOMETER_SAMPLE_HZ / 1000;
+
+static inline int32_t absValue(int32_t v) {
+  return v < 0 ? -v : v;
+}
+
+// |(x, y, z)| without a square root: max + 11/32 mid + 1/4 min, within
+// about 8% of the true magnitude - plenty once gravity is filtered out.
+static inline int32_t magnitude(const AccelSample& s) {
+  int32_t a = absValue(s.x), b = absValue(s.y), c = absValue(s.z);
+  int32_t t;
+  if (a < b) { t = a; a = b; b = t; }
+  if (b < c) { t = b; b = c; c = t; }
+  if (a < b) { t = a; a = b; b = t; }
+  return a + ((b * 11) >> 5) + (c >> 2);
+}
+
+StepDetector::StepDetector() {
+  reset();
+  _steps = 0;
+}
+
+void StepDetector::reset() {
+  _x1 = _x2 = _y1 = _y2 = 0;
+  _prev = _prevPrev = 0;
+  _peakAverage = PEDOMETER_MIN_PEAK_MG * 2;
+  _armed = true;
+  _sampleIndex = 0;
+  _lastStepSample = 0;
+  _pending = 0;
+}
+
+int StepDetector::push(const AccelSample& sample) {
+  int32_t x = magnitude(sample);
+  int32_t y = (BP_B0 * (x - _x2) - BP_A1 * _y1 - BP_A2 * _y2 + (1 << (BP_SHIFT - 1))) >> BP_SHIFT;
+  _x2 = _x1;
+  _x1 = x;
+  _y2 = _y1;
+  _y1 = y;
+  _sampleIndex++;
+
+  int added = 0;
+  if (y < 0) {
+    _armed = true; // a real stride swings back below zero between peaks
+  }
+
+  // _prev is a local maximum: rose into it and fell out of it
+  int32_t threshold = _peakAverage / 2;
+  if (threshold < PEDOMETER_MIN_PEAK_MG) {
+    threshold = PEDOMETER_MIN_PEAK_MG;
+  }
+  if (_armed && _prev > _prevPrev && _prev >= y && _prev > threshold) {
+    uint32_t gap = _sampleIndex - _lastStepSample;
+    if (_pending == 0 || gap >= MIN_STEP_SAMPLES) {
+      _armed = false;
+      _lastStepSample = _sampleIndex;
+      _peakAverage = (_peakAverage * 3 + _prev) / 4;
+
+      if (gap > MAX_STEP_SAMPLES) {
+        _pending = 0; // rhythm broken, start confirming again
+      }
+      if (_pending < PEDOMETER_CONFIRM_STEPS) {
+        _pending++;
+        if (_pending == PEDOMETER_CONFIRM_STEPS) {
+          added = PEDOMETER_CONFIRM_STEPS;
+        }
+      } else {
+        added = 1;
+      }
+    }
+  }
+
+  _prevPrev = _prev;
+  _prev = y;
+  _steps += added;
+  return added;
+}
+
+int StepDetector::poll(AccelSource& source) {
+  AccelSample batch[32];
+  int added = 0;
+  size_t count;
+  while ((count = source.read(batch, 32)) > 0) {
+    for (size_t i = 0; i < count; i++) {
+      added += push(batch[i]);
+    }
+    if (count < 32) {
+      break;
+    }
+  }
+  return added;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Step detection from 3-axis accelerometer samples, in integer arithmetic
+// only, so it runs the same on the ESP32 and on a PC replaying CSV traces.
+//
+// Per sample: magnitude (alpha-max-beta-min, no sqrt) -> 2 Hz band-pass
+// biquad in Q14 -> peak detector with adaptive threshold. Steps only count
+// once PEDOMETER_CONFIRM_STEPS arrive with a walking rhythm, so waving an
+// arm or tapping the device doesn't add steps.
+
+const int PEDOMETER_SAMPLE_HZ = 50;
+const int PEDOMETER_MIN_STEP_MS = 250;   // faster than ~4 steps/s is noise
+const int PEDOMETER_MAX_STEP_MS = 2000;  // slower than this breaks the rhythm
+const int PEDOMETER_CONFIRM_STEPS = 4;
+const int32_t PEDOMETER_MIN_PEAK_MG = 60; // ignore peaks below this (milli-g)
+
+struct AccelSample {
+  int16_t x, y, z; // milli-g
+};
+
+// Where samples come from - the accelerometer FIFO on the device, a CSV
+// trace on the host.
+class AccelSource {
+public:
+  virtual ~AccelSource() {}
+  // Fill up to max samples, return how many were available
+  virtual size_t read(AccelSample* out, size_t max) = 0;
+};
+
+class StepDetector {
+public:
+  StepDetector();
+  void reset();
+
+  // Feed one sample (at PEDOMETER_SAMPLE_HZ); returns the number of steps
+  // this sample added to the count (0, 1 or PEDOMETER_CONFIRM_STEPS).
+  int push(const AccelSample& sample);
+
+  // Drain a source; returns steps added
+  int poll(AccelSource& source);
+
+  uint32_t steps() const { return _steps; }
+  void setSteps(uint32_t steps) { _steps = steps; }
+
+private:
+  // Biquad state (direct form I), Q14 coefficients, input/output in mg
+  int32_t _x1, _x2, _y1, _y2;
+  int32_t _prev, _prevPrev;   // last two filtered values, for peak picking
+  int32_t _peakAverage;       // running average of accepted peak heights
+  bool _armed;                // signal went below zero since the last peak
+  uint32_t _sampleIndex;
+  uint32_t _lastStepSample;
+  int _pending;               // unconfirmed steps in the current rhythm
+  uint32_t _steps;
+};
@@ -0,0 +1,602 @@
+#include "pet_behavior.h"
+
+#include <math.h>
+
+#include "eye_effects.h"
+
+const int neutralStateProbability = 70;    // 70% chance to return to neutral (increased)
+const int minNeutralDuration = 4000;        // Longer minimum time in neutral (4-8 seconds)
+const int maxNeutralDuration = 8000;        // Longer maximum time in neutral
+const int minEmotionDuration = 1200;        // Minimum time for emotions (1.2-3 seconds)
+const int maxEmotionDuration = 3000;        // Maximum time for emotions
+const int emotionChangeProbability = 30;    // 30% chance for emotion vs 70% for look direction
+const int blinkProbability = 70;            // 70% chance to blink at blink interval
+const int minBlinkInterval = 2000;          // Min time between blinks (2-5 seconds)
+const int maxBlinkInterval = 5000;          // Max time between blinks
+
+// Snapshot flags (TRACE_SNAPSHOT value)
+enum {
+  SNAP_MANUAL = 1 << 0,
+  SNAP_LIGHT = 1 << 1,
+  SNAP_NEED_MOOD = 1 << 2,
+  SNAP_WAS_MANUAL = 1 << 3,
+  SNAP_NEEDY = 1 << 4
+};
+
+// Timers written after a snapshot (TRACE_TIMER arg)
+enum {
+  TIMER_LAST_BLINK,
+  TIMER_BLINK_INTERVAL,
+  TIMER_LAST_STATE_CHANGE,
+  TIMER_STATE_DURATION,
+  TIMER_HAPPY_END,
+  TIMER_COUNT
+};
+
+// Records in a complete snapshot
+const size_t SNAPSHOT_RECORDS = 1 + TIMER_COUNT + PET_RANDOM_WORDS;
+
+PetBehavior::PetBehavior(PetClock& clock)
+    : _clock(clock), _trace(nullptr), _now(0), _inUpdate(false), _current(STATE_NEUTRAL),
+      _target(STATE_NEUTRAL), _transitioning(false), _transitionStart(0), _blinking(false),
+      _blinkState(0), _lastBlink(0), _blinkInterval(0), _lastStateChange(0), _stateDuration(0),
+      _manual(false), _light(false), _moodFromNeeds(false), _needy(false), _needMood(STATE_NEUTRAL),
+      _wasManualBeforeFeed(false), _happyEnd(0), _happyPending(false), _recentIndex(0) {
+  for (int i = 0; i < 3; i++) {
+    _recent[i] = STATE_NEUTRAL;
+  }
+  shapesFor(STATE_NEUTRAL, _left, _right);
+  _leftTarget = _left;
+  _rightTarget = _right;
+}
+
+void PetBehavior::begin(uint64_t seed) {
+  _now = _clock.now();
+  _random.seed64(seed);
+  reset(STATE_NEUTRAL, false, false, false);
+  // Trigger a blink soon after startup
+  _lastBlink = _now - draw(1000, 2000);
+  _blinkInterval = draw(minBlinkInterval, maxBlinkInterval);
+  snapshot();
+}
+
+void PetBehavior::restore(EyeState state, bool manualMode, bool readingLight, bool moodFromNeeds) {
+  _now = _clock.now();
+  reset(state, manualMode, readingLight, moodFromNeeds);
+  snapshot();
+}
+
+void PetBehavior::reset(EyeState state, bool manualMode, bool readingLight, bool moodFromNeeds) {
+  _current = state;
+  _target = state;
+  _transitioning = false;
+  _blinking = false;
+  _blinkState = 0;
+  shapesFor(state, _left, _right);
+  _leftTarget = _left;
+  _rightTarget = _right;
+  _manual = manualMode;
+  _light = readingLight;
+  _moodFromNeeds = moodFromNeeds;
+  _needy = moodFromNeeds;
+  _needMood = state;
+  _happyEnd = 0;
+  _happyPending = false;
+  _lastStateChange = _now;
+  _stateDuration = 0;
+}
+
+void PetBehavior::update(bool needy, EyeState needMood) {
+  _now = _clock.now();
+  uint32_t now = _now;
+  _inUpdate = true;
+  if (!needy) {
+    needMood = STATE_NEUTRAL;
+  }
+
+  if (needy != _needy || (needy && needMood != _needMood)) {
+    _needy = needy;
+    _needMood = needMood;
+    record(TRACE_MOOD, needy, needMood);
+  }
+
+  // Handle return from happy state after feeding
+  if (_happyEnd > 0 && now >= _happyEnd) {
+    if (!_wasManualBeforeFeed) { // Only set to neutral if it was auto mode before feed
+      setState(STATE_NEUTRAL);
+    }
+    _manual = _wasManualBeforeFeed; // Restore original manual mode
+    _happyEnd = 0;
+    record(TRACE_FEED_END, _manual);
+  }
+
+  // Blinking logic - random intervals with probability
+  if (!_blinking && now - _lastBlink > _blinkInterval) {
+    if (draw(0, 100) < blinkProbability) { // 70% chance to blink
+      _blinking = true;
+      _blinkState = 1;
+      _lastBlink = now;
+      record(TRACE_BLINK);
+    } else {
+      // Reset the timer even if it don't blink this time
+      scheduleBlink();
+    }
+  }
+
+  // Process blink animation
+  if (_blinking && now - _lastBlink > PET_BLINK_MS / 4) {
+    _blinkState++;
+    if (_blinkState > 3) {
+      _blinking = false;
+      _blinkState = 0;
+      scheduleBlink();
+    } else {
+      _lastBlink = now;
+    }
+  }
+
+  // Handle transitions between states
+  if (_transitioning) {
+    float progress = (float)(now - _transitionStart) / PET_TRANSITION_MS;
+    if (progress >= 1.0) {
+      // Transition complete: land exactly on the target shape
+      _transitioning = false;
+      _current = _target;
+      _left = _leftTarget;
+      _right = _rightTarget;
+    } else {
+      // Interpolate between states
+      EyeShape* shapes[2] = {&_left, &_right};
+      const EyeShape* targets[2] = {&_leftTarget, &_rightTarget};
+      for (int i = 0; i < 2; i++) {
+        EyeShape& s = *shapes[i];
+        const EyeShape& t = *targets[i];
+        s.width = s.width + (t.width - s.width) * progress;
+        s.height = s.height + (t.height - s.height) * progress;
+        s.offsetX = s.offsetX + (t.offsetX - s.offsetX) * progress;
+        s.offsetY = s.offsetY + (t.offsetY - s.offsetY) * progress;
+        s.angle = s.angle + (t.angle - s.angle) * progress;
+      }
+    }
+  }
+
+  // A feed that arrived mid-transition gets its happy eyes now
+  if (_happyPending && !_transitioning) {
+    _happyPending = false;
+    setState(STATE_HAPPY);
+  }
+
+  // Needs-based eye state override
+  // The most pressing need shows on the face, in manual mode too, unless
+  // it's currently in the temporary STATE_HAPPY after feeding. Happy eyes
+  // that stay on afterwards (manual mode, or picked by a command) don't
+  // hold the needs back.
+  if (_happyEnd == 0) {
+    if (needy) {
+      _moodFromNeeds = true;
+      setState(needMood);
+    } else if (_moodFromNeeds) {
+      _moodFromNeeds = false;
+      // Needs met again - return to neutral unless in manual override
+      if (!_manual) {
+        setState(STATE_NEUTRAL);
+      }
+    }
+  }
+
+  // State change logic with improved randomization
+  if (!_manual && !_transitioning && !_moodFromNeeds) {
+    if (_stateDuration == 0) {
+      _stateDuration = _current == STATE_NEUTRAL ? draw(minNeutralDuration, maxNeutralDuration)
+                                                 : draw(minEmotionDuration, maxEmotionDuration);
+    }
+    if (now - _lastStateChange > _stateDuration) {
+      // Decide next state - increased favor for neutral state
+      if (_current != STATE_NEUTRAL && draw(0, 100) < neutralStateProbability) {
+        // Go back to neutral
+        setState(STATE_NEUTRAL);
+      } else {
+        // Choose a new random state that's not recently used
+        EyeState newState;
+        bool validState = false;
+
+        while (!validState) {
+          if (draw(0, 100) < emotionChangeProbability) {
+            // Pick an emotion state (0-4)
+            newState = (EyeState)draw(0, 5);
+          } else {
+            // Pick a directional state (5-9)
+            newState = (EyeState)(draw(0, 5) + 5);
+          }
+
+          // Don't use the current state or recently used states, and not STATE_HAPPY
+          if (newState != _current && !recentlyUsed(newState) && newState != STATE_HAPPY) {
+            validState = true;
+          }
+        }
+
+        setState(newState);
+        recordUse(newState);
+      }
+
+      _lastStateChange = now;
+      _stateDuration = 0;
+    }
+  }
+
+  if (_trace && _trace->snapshotDue() && !_transitioning && !_blinking) {
+    snapshot();
+  }
+  _inUpdate = false;
+}
+
+bool PetBehavior::setEmotion(int state) {
+  _now = _clock.now();
+  record(TRACE_COMMAND, TRACE_CMD_EMOTION, 0, state);
+  if (state < 0 || state >= STATE_COUNT) {
+    return false;
+  }
+  _happyPending = false; // an explicit expression wins over a pending feed
+  setState((EyeState)state);
+  return true;
+}
+
+void PetBehavior::setReadingLight(bool on) {
+  _now = _clock.now();
+  record(TRACE_COMMAND, TRACE_CMD_READING_LIGHT, 0, on);
+  _light = on;
+}
+
+void PetBehavior::setManualMode(bool on) {
+  _now = _clock.now();
+  record(TRACE_COMMAND, TRACE_CMD_MANUAL, 0, on);
+  _manual = on;
+  if (!_manual) {
+    // Reset to neutral when exiting manual mode
+    setState(STATE_NEUTRAL);
+  }
+}
+
+void PetBehavior::feed() {
+  _now = _clock.now();
+  record(TRACE_COMMAND, TRACE_CMD_FEED);
+
+  // Set happy expression for feeding, as soon as any transition under way
+  // has finished
+  setState(STATE_HAPPY);
+  _happyPending = state() != STATE_HAPPY;
+
+  // Store the current manual mode state
+  _wasManualBeforeFeed = _manual;
+
+  // Temporarily set manual mode to prevent other state changes during feeding
+  _manual = true;
+
+  // Schedule return to previous mode
+  _happyEnd = _now + PET_HAPPY_MS;
+}
+
+float PetBehavior::openness() const {
+  if (!_blinking) {
+    return 1.0;
+  }
+  if (_blinkState == 1) {      // Half-closing
+    return 0.5;
+  } else if (_blinkState == 2) { // Fully closed
+    return 0.1;
+  }
+  return 0.5;                  // Half-opening
+}
+
+int PetBehavior::frameKey() const {
+  // A steady expression (or the reading light) looks the same every frame
+  if (_transitioning || _blinking || _current == STATE_HAPPY) {
+    return -1;
+  }
+  return _light ? STATE_COUNT : _current;
+}
+
+static uint32_t hashInt(uint32_t hash, int32_t value) {
+  // FNV-1a over the four bytes
+  for (int i = 0; i < 4; i++) {
+    hash ^= (uint8_t)(value >> (8 * i));
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// 1/16 pixel is far below what the rasterizer can show, and coarse enough
+// that host and device float rounding agree
+static uint32_t hashFloat(uint32_t hash, float value) {
+  return hashInt(hash, (int32_t)lroundf(value * 16));
+}
+
+uint32_t PetBehavior::frameHash() const {
+  uint32_t hash = 2166136261u;
+  if (_light) {
+    return hashInt(hash, -1);
+  }
+  float open = openness();
+  const EyeShape* shapes[2] = {&_left, &_right};
+  for (int i = 0; i < 2; i++) {
+    hash = hashFloat(hash, shapes[i]->width);
+    hash = hashFloat(hash, shapes[i]->height * open);
+    hash = hashFloat(hash, shapes[i]->offsetX);
+    hash = hashFloat(hash, shapes[i]->offsetY);
+    hash = hashFloat(hash, shapes[i]->angle * 64);
+  }
+  if (showsStars()) {
+    for (int i = 0; i < EYE_STAR_COUNT; i++) {
+      hash = hashInt(hash, EYE_STARS[i].x);
+      hash = hashInt(hash, EYE_STARS[i].y);
+      hash = hashInt(hash, eyeStarSize(_now, i));
+    }
+  }
+  return hash;
+}
+
+size_t PetBehavior::loadSnapshot(const TraceRecord* records, size_t count) {
+  if (count < SNAPSHOT_RECORDS || records[0].type != TRACE_SNAPSHOT) {
+    return 0;
+  }
+  uint32_t timers[TIMER_COUNT];
+  for (int i = 0; i < TIMER_COUNT; i++) {
+    const TraceRecord& timer = records[1 + i];
+    if (timer.type != TRACE_TIMER || timer.arg != i) {
+      return 0;
+    }
+    timers[i] = (uint32_t)timer.data;
+  }
+  const TraceRecord* rng = records + 1 + TIMER_COUNT;
+  for (int i = 0; i < PET_RANDOM_WORDS; i++) {
+    if (rng[i].type != TRACE_RNG || rng[i].arg != i) {
+      return 0;
+    }
+  }
+
+  const TraceRecord& snap = records[0];
+  EyeState state = (EyeState)(snap.arg & ~TRACE_FROM_UPDATE);
+  uint16_t flags = snap.value;
+  _now = snap.time;
+  reset(state, flags & SNAP_MANUAL, flags & SNAP_LIGHT, flags & SNAP_NEED_MOOD);
+
+  _needy = flags & SNAP_NEEDY;
+  _needMood = (EyeState)((flags >> 8) & 0x0f);
+  _wasManualBeforeFeed = flags & SNAP_WAS_MANUAL;
+  for (int i = 0; i < 3; i++) {
+    _recent[i] = (EyeState)((snap.data >> (4 * i)) & 0x0f);
+  }
+  _recentIndex = (snap.data >> 12) & 0x03;
+  _lastBlink = timers[TIMER_LAST_BLINK];
+  _blinkInterval = timers[TIMER_BLINK_INTERVAL];
+  _lastStateChange = timers[TIMER_LAST_STATE_CHANGE];
+  _stateDuration = timers[TIMER_STATE_DURATION];
+  _happyEnd = timers[TIMER_HAPPY_END];
+  for (int i = 0; i < PET_RANDOM_WORDS; i++) {
+    _random.setWord(i, (uint32_t)rng[i].data);
+  }
+  return SNAPSHOT_RECORDS;
+}
+
+// Wait a random interval for the next blink
+void PetBehavior::scheduleBlink() {
+  _lastBlink = _now;
+  _blinkInterval = draw(minBlinkInterval, maxBlinkInterval);
+}
+
+long PetBehavior::draw(long min, long max) {
+  long value = _random.range(min, max);
+  record(TRACE_RANDOM, 0, (uint16_t)(max - min), value);
+  return value;
+}
+
+void PetBehavior::setState(EyeState newState) {
+  if (_transitioning || newState == _current) {
+    return;
+  }
+  record(TRACE_STATE, _current | (_inUpdate ? TRACE_FROM_UPDATE : 0), newState);
+
+  _target = newState;
+  _transitioning = true;
+  _transitionStart = _now;
+  _stateDuration = 0;
+  shapesFor(newState, _leftTarget, _rightTarget);
+}
+
+// Check if a state was recently used
+bool PetBehavior::recentlyUsed(EyeState state) const {
+  for (int i = 0; i < 3; i++) {
+    if (_recent[i] == state) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PetBehavior::recordUse(EyeState state) {
+  _recent[_recentIndex] = state;
+  _recentIndex = (_recentIndex + 1) % 3;
+}
+
+void PetBehavior::record(TraceType type, uint8_t arg, uint16_t value, int32_t data) {
+  if (_trace) {
+    _trace->record(_now, type, arg, value, data);
+  }
+}
+
+// Full state, written only between blinks and transitions so the eye
+// shapes follow from the expression
+void PetBehavior::snapshot() {
+  if (!_trace) {
+    return;
+  }
+  uint16_t flags = (_manual ? SNAP_MANUAL : 0) | (_light ? SNAP_LIGHT : 0) |
+                   (_moodFromNeeds ? SNAP_NEED_MOOD : 0) | (_wasManualBeforeFeed ? SNAP_WAS_MANUAL : 0) |
+                   (_needy ? SNAP_NEEDY : 0) | (_needMood << 8);
+  int32_t recent = _recent[0] | (_recent[1] << 4) | (_recent[2] << 8) | (_recentIndex << 12);
+  record(TRACE_SNAPSHOT, _current | (_inUpdate ? TRACE_FROM_UPDATE : 0), flags, recent);
+  record(TRACE_TIMER, TIMER_LAST_BLINK, 0, _lastBlink);
+  record(TRACE_TIMER, TIMER_BLINK_INTERVAL, 0, _blinkInterval);
+  record(TRACE_TIMER, TIMER_LAST_STATE_CHANGE, 0, _lastStateChange);
+  record(TRACE_TIMER, TIMER_STATE_DURATION, 0, _stateDuration);
+  record(TRACE_TIMER, TIMER_HAPPY_END, 0, _happyEnd);
+  for (int i = 0; i < PET_RANDOM_WORDS; i++) {
+    record(TRACE_RNG, i, 0, _random.word(i));
+  }
+}
+
+void PetBehavior::shapesFor(EyeState state, EyeShape& left, EyeShape& right) {
+  float& leftW = left.width;
+  float& leftH = left.height;
+  float& rightW = right.width;
+  float& rightH = right.height;
+  float& leftX = left.offsetX;
+  float& leftY = left.offsetY;
+  float& rightX = right.offsetX;
+  float& rightY = right.offsetY;
+  float& leftA = left.angle;
+  float& rightA = right.angle;
+  const int eyeBaseWidth = PET_EYE_WIDTH;
+  const int eyeBaseHeight = PET_EYE_HEIGHT;
+
+  // Set default dimensions
+  leftW = eyeBaseWidth;
+  leftH = eyeBaseHeight;
+  rightW = eyeBaseWidth;
+  rightH = eyeBaseHeight;
+  leftX = 0;
+  leftY = 0;
+  rightX = 0;
+  rightY = 0;
+  leftA = 0;
+  rightA = 0;
+
+  // Apply state-specific transformations - more dramatic emotional changes
+  switch (state) {
+    case STATE_ANGRY:
+      // Angry eyes - angled inward and narrowed
+      leftW = eyeBaseWidth * 0.7;
+      leftH = eyeBaseHeight * 0.7;
+      rightW = eyeBaseWidth * 0.7;
+      rightH = eyeBaseHeight * 0.7;
+      leftX = -5;
+      rightX = 5;
+      leftY = -2;
+      rightY = -2;
+      leftA = -0.5;  // Angle in radians (~30 degrees inward)
+      rightA = 0.5;
+      break;
+
+    case STATE_SURPRISED:
+      // Surprised - wide, round eyes
+      leftW = eyeBaseWidth * 1.4;
+      leftH = eyeBaseWidth * 1.4;  // Round shape
+      rightW = eyeBaseWidth * 1.4;
+      rightH = eyeBaseWidth * 1.4;
+      leftY = -5;
+      rightY = -5;
+      break;
+
+    case STATE_SLEEPY:
+      // Sad - droopy eyes
+      leftW = eyeBaseWidth * 0.9;
+      leftH = eyeBaseHeight * 0.7;
+      rightW = eyeBaseWidth * 0.9;
+      rightH = eyeBaseHeight * 0.7;
+      leftY = 8;
+      rightY = 8;
+      leftA = 0.3;  // Outer corners drooping
+      rightA = -0.3;
+      break;
+
+    case STATE_SUSPICIOUS:
+      // Suspicious - one eyebrow raised
+      leftW = eyeBaseWidth * 0.75;
+      leftH = eyeBaseHeight * 0.6;
+      rightW = eyeBaseWidth * 0.9;
+      rightH = eyeBaseHeight * 0.9;
+      leftY = -5;
+      rightY = 3;
+      leftA = 0.2;
+      break;
+
+    case STATE_LEFT:
+      // Looking left - improved positioning
+      // Left eye (smaller)
+      leftW = eyeBaseWidth * 0.5;    // Slightly larger than before (was 0.4)
+      leftH = eyeBaseHeight * 0.7;   // Slightly larger than before (was 0.6)
+      leftX = -10;                   // Keep same position for smaller eye
+
+      // Right eye (bigger)
+      rightW = eyeBaseWidth * 0.8;   // Reduced width (was 1.2)
+      rightH = eyeBaseHeight * 1.1;  // Slightly increased height
+      rightX = -12;                  // Move closer to the smaller eye (was -4)
+      break;
+
+    case STATE_RIGHT:
+      // Looking right - improved positioning
+      // Left eye (bigger)
+      leftW = eyeBaseWidth * 0.8;    // Reduced width (was 1.2)
+      leftH = eyeBaseHeight * 1.1;   // Slightly increased height
+      leftX = 12;                    // Move closer to the smaller eye (was 4)
+
+      // Right eye (smaller)
+      rightW = eyeBaseWidth * 0.5;   // Slightly larger than before (was 0.4)
+      rightH = eyeBaseHeight * 0.7;  // Slightly larger than before (was 0.6)
+      rightX = 10;                   // Keep same position for smaller eye
+      break;
+
+    case STATE_UP:
+      // Looking up - more dramatic
+      leftW = eyeBaseWidth * 0.9;
+      leftH = eyeBaseHeight * 0.65;
+      rightW = eyeBaseWidth * 0.9;
+      rightH = eyeBaseHeight * 0.65;
+      leftY = -12;
+      rightY = -12;
+      break;
+
+    case STATE_DOWN:
+      // Looking down - more dramatic
+      leftW = eyeBaseWidth * 0.9;
+      leftH = eyeBaseHeight * 0.65;
+      rightW = eyeBaseWidth * 0.9;
+      rightH = eyeBaseHeight * 0.65;
+      leftY = 12;
+      rightY = 12;
+      break;
+
+    case STATE_SAD:
+      // Sleepy - half-closed eyes
+      leftW = eyeBaseWidth * 1.0;
+      leftH = eyeBaseHeight * 0.45;
+      rightW = eyeBaseWidth * 1.0;
+      rightH = eyeBaseHeight * 0.45;
+      leftY = 8;
+      rightY = 8;
+      break;
+
+    case STATE_HAPPY:
+      // Happy - aiming for a "crescent moon" or "smiling eye" effect
+      leftW = eyeBaseWidth * 1.3;   // Slightly wider
+      leftH = eyeBaseHeight * 0.3;  // **Significantly flatter to create the "line" effect**
+      rightW = eyeBaseWidth * 1.3;
+      rightH = eyeBaseHeight * 0.3; // **Significantly flatter**
+
+      leftY = -6; // **Move eyes higher up the face to simulate upward curve of a smile**
+      rightY = -6; // **Move eyes higher up**
+
+      leftX = -3; // Slightly shift inwards for a more "squinty" happy look
+      rightX = 3; // Slightly shift inwards
+
+      // Add a slight outward rotation to give an upward curved appearance
+      leftA = -0.05; // Rotate left eye slightly clockwise (outer corner up)
+      rightA = 0.05; // Rotate right eye slightly counter-clockwise (outer corner up)
+      break;
+
+    case STATE_NEUTRAL:
+    default:
+      // Normal state - no changes
+      break;
+  }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eye_state.h"
+#include "event_trace.h"
+#include "pet_clock.h"
+#include "pet_random.h"
+
+// The pet's behaviour state machine: blinking, the random wandering between
+// expressions, transitions between eye shapes, the needs override, manual
+// mode, the reading light and the happy spell after a feed.
+//
+// Nothing in here talks to hardware. Time comes from the PetClock given to
+// the constructor, read once per update or command, and random numbers from
+// a seeded PetRandom, so the same code runs bit for bit the same on the
+// device and in the host tools. Every input and decision goes to an
+// optional EventTrace, which is enough to replay a session from the device
+// (tools/trace_replay.cpp).
+//
+// Random intervals (time to the next blink, how long to hold an
+// expression) are drawn once per decision.
+
+const int PET_EYE_WIDTH = 30;         // neutral eye, pixels
+const int PET_EYE_HEIGHT = 44;
+const uint32_t PET_BLINK_MS = 220;
+const uint32_t PET_TRANSITION_MS = 150;
+const uint32_t PET_HAPPY_MS = 3000;   // happy eyes after a feed
+
+// One eye relative to its resting position. Angle in radians.
+struct EyeShape {
+  float width, height;
+  float offsetX, offsetY;
+  float angle;
+};
+
+class PetBehavior {
+public:
+  explicit PetBehavior(PetClock& clock);
+
+  void setTrace(EventTrace* trace) { _trace = trace; }
+
+  // Fresh boot: neutral eyes, first blink soon. The same seed gives the
+  // same behaviour for the same inputs.
+  void begin(uint64_t seed);
+
+  // Straight back to an expression (night-mode wake, after begin()), no
+  // transition
+  void restore(EyeState state, bool manualMode, bool readingLight, bool moodFromNeeds);
+
+  // Advance to the clock's time; call once per frame. needy/needMood is
+  // what PetNeeds::mood() says the most pressing need wants to show.
+  void update(bool needy, EyeState needMood);
+
+  // Commands (HTTP, BLE)
+  bool setEmotion(int state);
+  void setReadingLight(bool on);
+  void setManualMode(bool on);  // leaving it goes back to neutral
+  void feed();                  // happy eyes, then restore the mode
+
+  // Time of the last update or command; what the getters below describe
+  uint32_t now() const { return _now; }
+
+  // The expression being shown or transitioned to
+  EyeState state() const { return _transitioning ? _target : _current; }
+  EyeState currentState() const { return _current; }
+  bool transitioning() const { return _transitioning; }
+  bool blinking() const { return _blinking; }
+  bool manualMode() const { return _manual; }
+  bool readingLight() const { return _light; }
+  bool moodFromNeeds() const { return _moodFromNeeds; }
+  bool feeding() const { return _happyEnd > 0; }
+  // Needs input last seen by update(); returns needy
+  bool needInput(EyeState& mood) const {
+    mood = _needMood;
+    return _needy;
+  }
+
+  const EyeShape& leftEye() const { return _left; }
+  const EyeShape& rightEye() const { return _right; }
+  // Share of the eye height left open by the blink, 1 when not blinking
+  float openness() const;
+
+  // Happy eyes, not on their way anywhere: the stars (EYE_STARS in
+  // src/eye_effects.h) are out
+  bool showsStars() const { return _current == STATE_HAPPY && _target == STATE_HAPPY; }
+
+  // Frames that look the same share a key, so the sketch can skip sending
+  // them again. -1 while something moves.
+  int frameKey() const;
+
+  // Hash of everything drawEyes() puts on screen
+  uint32_t frameHash() const;
+
+  // Replay: pick up the state from a TRACE_SNAPSHOT record and the
+  // TRACE_TIMER and TRACE_RNG records after it. Returns how many records it used, 0 if
+  // records doesn't start with a complete snapshot.
+  size_t loadSnapshot(const TraceRecord* records, size_t count);
+
+  // Resting eye shapes of an expression
+  static void shapesFor(EyeState state, EyeShape& left, EyeShape& right);
+
+private:
+  void reset(EyeState state, bool manualMode, bool readingLight, bool moodFromNeeds);
+  long draw(long min, long max);
+  void setState(EyeState state);
+  void scheduleBlink();
+  bool recentlyUsed(EyeState state) const;
+  void recordUse(EyeState state);
+  void record(TraceType type, uint8_t arg = 0, uint16_t value = 0, int32_t data = 0);
+  void snapshot();
+
+  PetClock& _clock;
+  PetRandom _random;
+  EventTrace* _trace;
+  uint32_t _now;       // clock at the start of the last update or command
+  bool _inUpdate;
+
+  EyeState _current;
+  EyeState _target;
+  bool _transitioning;
+  uint32_t _transitionStart;
+
+  bool _blinking;
+  uint8_t _blinkState; // 0 = open, 1 = half-closed, 2 = closed, 3 = half-open
+  uint32_t _lastBlink;
+  uint32_t _blinkInterval;
+
+  uint32_t _lastStateChange;
+  uint32_t _stateDuration; // 0 until drawn for the current expression
+
+  bool _manual;
+  bool _light;
+  bool _moodFromNeeds;
+  bool _needy;         // last needs input, to trace changes
+  EyeState _needMood;
+  bool _wasManualBeforeFeed;
+  uint32_t _happyEnd;  // 0 when not feeding
+  bool _happyPending;  // fed mid-transition, happy eyes still to come
+
+  EyeState _recent[3];
+  int _recentIndex;
+
+  EyeShape _left, _right;
+  EyeShape _leftTarget, _rightTarget;
+};
@@ -0,0 +1,186 @@
+#include "pet_ble.h"
+#include "pet_commands.h"
+#include "ble_bulk.h"
+#include "ble_ota.h"
+#include "log.h"
+
+#include <Arduino.h>
+#include <BLEDevice.h>
+#include <BLEServer.h>
+#include <BLEUtils.h>
+#include <BLE2902.h>
+
+#define SERVICE_UUID         "4fafc201-1fb5-459e-8fcc-c5c9c331914b"
+#define COMMAND_CHAR_UUID    "beb5483e-36e1-4688-b7f5-ea07361b26a8"
+#define STATE_CHAR_UUID      "beb5483f-36e1-4688-b7f5-ea07361b26a8"
+
+struct PetBleCommand {
+    uint8_t opcode;
+    uint8_t arg;
+};
+
+// BLE callbacks run on the Bluedroid task; commands are handed to loop()
+// through this queue so pet state is only ever touched from one task.
+static QueueHandle_t commandQueue = nullptr;
+static BLECharacteristic* stateCharacteristic = nullptr;
+static volatile bool clientConnected = false;
+static volatile bool clientSeen = false;
+static volatile bool sendFullState = false;
+static PetStatus lastSent;
+static unsigned long lastNotifyTime = 0;
+
+static size_t encodeState(const PetStatus& status, uint8_t mask, uint8_t* out) {
+    size_t len = 0;
+    out[len++] = mask;
+    if (mask & PET_BLE_FIELD_EYE_STATE) out[len++] = status.eyeState;
+    if (mask & PET_BLE_FIELD_MANUAL) out[len++] = status.manualMode;
+    if (mask & PET_BLE_FIELD_LIGHT) out[len++] = status.readingLight;
+    if (mask & PET_BLE_FIELD_HUNGER) out[len++] = status.hunger;
+    return len;
+}
+
+static uint8_t changedFields(const PetStatus& a, const PetStatus& b) {
+    uint8_t mask = 0;
+    if (a.eyeState != b.eyeState) mask |= PET_BLE_FIELD_EYE_STATE;
+    if (a.manualMode != b.manualMode) mask |= PET_BLE_FIELD_MANUAL;
+    if (a.readingLight != b.readingLight) mask |= PET_BLE_FIELD_LIGHT;
+    if (a.hunger != b.hunger) mask |= PET_BLE_FIELD_HUNGER;
+    return mask;
+}
+
+class PetServerCallbacks : public BLEServerCallbacks {
+    void onConnect(BLEServer* pServer) {
+        clientConnected = true;
+        clientSeen = true;
+        sendFullState = true;
+    }
+
+    void onDisconnect(BLEServer* pServer) {
+        clientConnected = false;
+        BLEDevice::startAdvertising(); // Let the phone reconnect
+    }
+};
+
+class PetCommandCallbacks : public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pCharacteristic) {
+        std::string value = pCharacteristic->getValue();
+
+        if (value.length() > 0) {
+            PetBleCommand command;
+            command.opcode = (uint8_t)value[0];
+            command.arg = value.length() > 1 ? (uint8_t)value[1] : 0;
+            if (xQueueSend(commandQueue, &command, 0) != pdTRUE) {
+                LOGW(LOG_BLE, "BLE command queue full, dropping command");
+            }
+        }
+    }
+};
+
+class PetStateCallbacks : public BLECharacteristicCallbacks {
+    void onRead(BLECharacteristic *pCharacteristic) {
+        uint8_t buf[8];
+        size_t len = encodeState(petStatus(), PET_BLE_FIELD_ALL, buf);
+        pCharacteristic->setValue(buf, len);
+    }
+};
+
+static void runCommand(const PetBleCommand& command) {
+    switch (command.opcode) {
+        case PET_BLE_CMD_EMOTION:
+            if (!petSetEmotion(command.arg)) {
+                LOGW(LOG_BLE, "BLE: invalid state value");
+            }
+            break;
+        case PET_BLE_CMD_MANUAL:
+            petSetManualMode(command.arg != 0);
+            break;
+        case PET_BLE_CMD_FEED:
+            petFeed();
+            break;
+        case PET_BLE_CMD_LIGHT:
+            petSetReadingLight(command.arg != 0);
+            break;
+        default:
+            LOGW(LOG_BLE, "BLE: unknown command %u", command.opcode);
+            break;
+    }
+}
+
+void setupPetBle(const char* deviceName) {
+    LOGI(LOG_BLE, "Starting BLE Server...");
+    commandQueue = xQueueCreate(8, sizeof(PetBleCommand));
+
+    BLEDevice::init(deviceName);
+
+    BLEServer *pServer = BLEDevice::createServer();
+    pServer->setCallbacks(new PetServerCallbacks());
+
+    // Room for the pet characteristics plus the bulk transport
+    BLEService *pService = pServer->createService(BLEUUID(SERVICE_UUID), 30);
+
+    BLECharacteristic *pCommand = pService->createCharacteristic(
+                                      COMMAND_CHAR_UUID,
+                                      BLECharacteristic::PROPERTY_WRITE |
+                                      BLECharacteristic::PROPERTY_WRITE_NR
+                                  );
+    pCommand->setCallbacks(new PetCommandCallbacks());
+
+    stateCharacteristic = pService->createCharacteristic(
+                              STATE_CHAR_UUID,
+                              BLECharacteristic::PROPERTY_READ |
+                              BLECharacteristic::PROPERTY_NOTIFY
+                          );
+    stateCharacteristic->addDescriptor(new BLE2902());
+    stateCharacteristic->setCallbacks(new PetStateCallbacks());
+
+    setupBleBulk(pServer, pService);
+
+    pService->start();
+    setupBleOta(pServer);
+
+    BLEAdvertising *pAdvertising = BLEDevice::getAdvertising();
+    pAdvertising->addServiceUUID(SERVICE_UUID);
+    pAdvertising->setScanResponse(true);
+    pAdvertising->setMinPreferred(0x06);  // Helps with iPhone connection issues
+    pAdvertising->setMinPreferred(0x12);
+    BLEDevice::startAdvertising();
+
+    lastSent = petStatus();
+    LOGI(LOG_BLE, "BLE advertising started.");
+}
+
+bool petBleClientSeen() {
+    return clientSeen;
+}
+
+void petBleLoop(unsigned long currentTime) {
+    if (commandQueue == nullptr) {
+        return;
+    }
+
+    PetBleCommand command;
+    while (xQueueReceive(commandQueue, &command, 0) == pdTRUE) {
+        runCommand(command);
+    }
+
+    bleBulkLoop(currentTime);
+    bleOtaLoop(currentTime);
+
+    if (!clientConnected || currentTime - lastNotifyTime < PET_BLE_NOTIFY_INTERVAL_MS) {
+        return;
+    }
+
+    PetStatus status = petStatus();
+    uint8_t mask = sendFullState ? PET_BLE_FIELD_ALL : changedFields(status, lastSent);
+    if (mask == 0) {
+        return;
+    }
+
+    uint8_t buf[8];
+    size_t len = encodeState(status, mask, buf);
+    stateCharacteristic->setValue(buf, len);
+    stateCharacteristic->notify();
+    lastSent = status;
+    sendFullState = false;
+    lastNotifyTime = currentTime;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+  BLE control service for the pet - the same commands as the HTTP routes,
+  without needing WiFi.
+
+  Service:        4fafc201-1fb5-459e-8fcc-c5c9c331914b
+  Command (WRITE, WRITE_NR): beb5483e-36e1-4688-b7f5-ea07361b26a8
+    [PET_BLE_CMD_EMOTION, state]
+    [PET_BLE_CMD_MANUAL,  0 = auto / 1 = manual]
+    [PET_BLE_CMD_FEED]
+    [PET_BLE_CMD_LIGHT,   0 = off / 1 = on]
+  State (READ, NOTIFY):      beb5483f-36e1-4688-b7f5-ea07361b26a8
+    [mask, fields...] - mask says which fields follow, in bit order, one
+    byte each. Reads and the first notify after connecting carry every
+    field; later notifies carry only what changed.
+*/
+
+const uint8_t PET_BLE_CMD_EMOTION = 1;
+const uint8_t PET_BLE_CMD_MANUAL = 2;
+const uint8_t PET_BLE_CMD_FEED = 3;
+const uint8_t PET_BLE_CMD_LIGHT = 4;
+
+const uint8_t PET_BLE_FIELD_EYE_STATE = 0x01;
+const uint8_t PET_BLE_FIELD_MANUAL = 0x02;
+const uint8_t PET_BLE_FIELD_LIGHT = 0x04;
+const uint8_t PET_BLE_FIELD_HUNGER = 0x08;
+const uint8_t PET_BLE_FIELD_ALL = 0x0F;
+
+// Minimum gap between state notifications
+const unsigned long PET_BLE_NOTIFY_INTERVAL_MS = 50;
+
+void setupPetBle(const char* deviceName);
+
+// True once a client has connected since boot
+bool petBleClientSeen();
+
+// Call from loop(): runs queued commands on the loop task and sends
+// state deltas to a subscribed client.
+void petBleLoop(unsigned long currentTime);
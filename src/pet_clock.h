@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+
+// Where the behaviour code gets the time - millis() on the device, a clock
+// the caller moves by hand on the host. PetBehavior reads it once at the
+// start of every update and command, so everything a step decides shares
+// one timestamp.
+class PetClock {
+public:
+  virtual ~PetClock() {}
+  // Milliseconds; wraps like millis()
+  virtual uint32_t now() = 0;
+};
+
+// Virtual time for the host tools (replay, simulation)
+class ManualClock : public PetClock {
+public:
+  explicit ManualClock(uint32_t start = 0) : _now(start) {}
+  uint32_t now() override { return _now; }
+  void set(uint32_t now) { _now = now; }
+  void advance(uint32_t ms) { _now += ms; }
+
+private:
+  uint32_t _now;
+};
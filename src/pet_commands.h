@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+// Pet control commands shared by every transport (HTTP handlers, BLE).
+// Implemented next to the pet state in the main sketch. The setters must
+// only be called from the loop() task; petStatus() is a plain read.
+
+// Set a specific eye state (0..STATE_COUNT-1). Returns false if out of range.
+bool petSetEmotion(int state);
+
+void petSetReadingLight(bool on);
+
+// Leaving manual mode sends the eyes back to neutral
+void petSetManualMode(bool on);
+
+// Refill hunger, show happy eyes for a few seconds, then restore the mode
+void petFeed();
+
+// Snapshot of everything a remote client may want to mirror
+struct PetStatus {
+  uint8_t eyeState;
+  bool manualMode;
+  bool readingLight;
+  uint8_t hunger; // percent
+};
+
+PetStatus petStatus();
@@ -0,0 +1,106 @@
+#include "pet_needs.h"
+
+#include <math.h>
+
+const NeedCurve PET_NEED_CURVES[NEED_COUNT] = {
+  // hunger: empty after 100 s, sad once it's gone
+  {NEED_CURVE_LINEAR, 0, {0}, {3600.0f}, 1, 1.0f, STATE_SAD},
+  // energy: steady through the day, then tiredness snowballs below 30%
+  {NEED_CURVE_PIECEWISE, 0, {30.0f, 0}, {5.0f, 12.0f}, 2, 20.0f, STATE_SLEEPY},
+  // happiness: fades quickly at first, then lingers
+  {NEED_CURVE_EXPONENTIAL, 8.0f, {0}, {0}, 0, 25.0f, STATE_ANGRY},
+  // cleanliness: two days from clean to filthy
+  {NEED_CURVE_LINEAR, 0, {0}, {2.0f}, 1, 15.0f, STATE_SUSPICIOUS},
+};
+
+static inline float clampLevel(float level) {
+  return level < 0 ? 0 : (level > NEED_FULL ? NEED_FULL : level);
+}
+
+PetNeeds::PetNeeds(const NeedCurve curves[NEED_COUNT]) : _curves(curves) {
+  reset(0);
+}
+
+void PetNeeds::reset(uint32_t now) {
+  for (int i = 0; i < NEED_COUNT; i++) {
+    _anchors[i].level = NEED_FULL;
+    _anchors[i].time = now;
+  }
+}
+
+float PetNeeds::evaluate(const NeedCurve& curve, float level, uint32_t elapsed) {
+  float hours = elapsed / 3600.0f;
+
+  if (curve.type == NEED_CURVE_EXPONENTIAL) {
+    return level * exp2f(-hours / curve.halfLifeHours);
+  }
+
+  // Linear and piecewise: walk the (at most NEED_MAX_SEGMENTS) segments the
+  // level passes through, each in closed form.
+  for (int i = 0; i < curve.segments && hours > 0; i++) {
+    if (level <= curve.breaks[i]) {
+      continue;
+    }
+    float toBreak = (level - curve.breaks[i]) / curve.rates[i];
+    if (hours < toBreak) {
+      return level - curve.rates[i] * hours;
+    }
+    level = curve.breaks[i];
+    hours -= toBreak;
+  }
+  return level;
+}
+
+float PetNeeds::level(PetNeed need, uint32_t now) const {
+  const NeedAnchor& anchor = _anchors[need];
+  // A clock that went backwards counts as no time passed
+  uint32_t elapsed = (int32_t)(now - anchor.time) > 0 ? now - anchor.time : 0;
+  return clampLevel(evaluate(_curves[need], anchor.level, elapsed));
+}
+
+void PetNeeds::set(PetNeed need, float level, uint32_t now) {
+  _anchors[need].level = clampLevel(level);
+  _anchors[need].time = now;
+}
+
+void PetNeeds::add(PetNeed need, float amount, uint32_t now) {
+  set(need, level(need, now) + amount, now);
+}
+
+bool PetNeeds::mood(uint32_t now, EyeState& state) const {
+  float worst = 1.0f;
+  bool found = false;
+  for (int i = 0; i < NEED_COUNT; i++) {
+    const NeedCurve& curve = _curves[i];
+    float relative = level((PetNeed)i, now) / curve.moodBelow;
+    if (relative < worst) {
+      worst = relative;
+      state = curve.mood;
+      found = true;
+    }
+  }
+  return found;
+}
+
+void PetNeeds::restore(const NeedAnchor anchors[NEED_COUNT]) {
+  for (int i = 0; i < NEED_COUNT; i++) {
+    _anchors[i].level = clampLevel(anchors[i].level);
+    _anchors[i].time = anchors[i].time;
+  }
+}
+
+void PetNeeds::shiftTime(int32_t delta) {
+  for (int i = 0; i < NEED_COUNT; i++) {
+    _anchors[i].time += delta;
+  }
+}
+
+const char* PetNeeds::name(PetNeed need) {
+  switch (need) {
+    case NEED_HUNGER: return "hunger";
+    case NEED_ENERGY: return "energy";
+    case NEED_HAPPINESS: return "happiness";
+    case NEED_CLEANLINESS: return "cleanliness";
+    default: return "unknown";
+  }
+}
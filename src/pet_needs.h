@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "eye_state.h"
+
+// The pet's needs - hunger, energy, happiness and cleanliness - each a level
+// from 0 (desperate) to 100 (satisfied) that decays over time.
+//
+// Nothing is stepped per tick. Every need stores the level it was last set
+// to and when (its anchor); the current level is a closed-form function of
+// the time since then. Evaluating it costs the same after a second as after
+// a month switched off, and nothing has to be written to flash until a need
+// is refilled. Each curve only depends on the current level, so re-anchoring
+// at any point in time leaves the curve unchanged.
+//
+// Time is in whole seconds on any monotonic clock (the sketch uses the
+// epoch once NTP has synced).
+
+enum PetNeed {
+  NEED_HUNGER,
+  NEED_ENERGY,
+  NEED_HAPPINESS,
+  NEED_CLEANLINESS,
+  NEED_COUNT
+};
+
+enum NeedCurveType {
+  NEED_CURVE_LINEAR,      // drops at rates[0] per hour
+  NEED_CURVE_EXPONENTIAL, // halves every halfLifeHours
+  NEED_CURVE_PIECEWISE    // drops at rates[i] per hour while above breaks[i]
+};
+
+const int NEED_MAX_SEGMENTS = 4;
+const float NEED_FULL = 100.0f;
+
+struct NeedCurve {
+  NeedCurveType type;
+  float halfLifeHours;
+  // Piecewise segments, highest first; the last break should be 0. Linear
+  // curves use rates[0] with breaks[0] = 0.
+  float breaks[NEED_MAX_SEGMENTS];
+  float rates[NEED_MAX_SEGMENTS];
+  int segments;
+  float moodBelow;   // the need shows on the face below this level
+  EyeState mood;
+};
+
+struct NeedAnchor {
+  float level;
+  uint32_t time;
+};
+
+// Curves the sketch runs with. Hunger keeps the original demo pace of 5%
+// every 5 seconds; the others play out over hours.
+extern const NeedCurve PET_NEED_CURVES[NEED_COUNT];
+
+class PetNeeds {
+public:
+  explicit PetNeeds(const NeedCurve curves[NEED_COUNT]);
+
+  // Start every need full at the given time
+  void reset(uint32_t now);
+
+  float level(PetNeed need, uint32_t now) const;
+  void set(PetNeed need, float level, uint32_t now);
+  void add(PetNeed need, float amount, uint32_t now);
+
+  // The expression of the most pressing need, if any is below its mood
+  // threshold. Needs are compared by how far below the threshold they are
+  // relative to it.
+  bool mood(uint32_t now, EyeState& state) const;
+
+  // Persisted form - the anchors are all the state there is
+  const NeedAnchor* anchors() const { return _anchors; }
+  void restore(const NeedAnchor anchors[NEED_COUNT]);
+
+  // Move every anchor by delta seconds, for when the clock itself jumps
+  // (first NTP sync after anchors were taken on uptime)
+  void shiftTime(int32_t delta);
+
+  static const char* name(PetNeed need);
+  static float evaluate(const NeedCurve& curve, float level, uint32_t elapsed);
+
+private:
+  const NeedCurve* _curves;
+  NeedAnchor _anchors[NEED_COUNT];
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+
+// Small, seedable PRNG for the behaviour code: xoshiro128** (Blackman and
+// Vigna), 128 bits of state, 32-bit output. Only shifts, rotates, xors and
+// two multiplies by constants, so it costs a few cycles on the ESP32 and
+// gives the same sequence on the host for the same seed - unlike Arduino's
+// random(), which goes through newlib's rand() and a division per draw.
+//
+// The state is four words; the trace stores them in its snapshots so a
+// replay can carry on the exact sequence (PetBehavior::loadSnapshot()).
+
+const int PET_RANDOM_WORDS = 4;
+
+class PetRandom {
+public:
+  explicit PetRandom(uint64_t seed = 1) { seed64(seed); }
+
+  // Spread a 64-bit seed over the state with splitmix64, so nearby seeds
+  // give unrelated sequences and the state is never all zero
+  void seed64(uint64_t seed) {
+    for (int i = 0; i < PET_RANDOM_WORDS; i += 2) {
+      uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      z ^= z >> 31;
+      _s[i] = (uint32_t)z;
+      _s[i + 1] = (uint32_t)(z >> 32);
+    }
+  }
+
+  uint32_t next() {
+    uint32_t result = rotl(_s[1] * 5, 7) * 9;
+    uint32_t t = _s[1] << 9;
+    _s[2] ^= _s[0];
+    _s[3] ^= _s[1];
+    _s[1] ^= _s[2];
+    _s[0] ^= _s[3];
+    _s[2] ^= t;
+    _s[3] = rotl(_s[3], 11);
+    return result;
+  }
+
+  // Number in [min, max), like Arduino's random(min, max). Scales with a
+  // multiply instead of a modulo; the bias is span / 2^32, about one in a
+  // million for the longest interval the pet draws.
+  long range(long min, long max) {
+    if (max <= min) {
+      return min;
+    }
+    uint32_t span = (uint32_t)(max - min);
+    return min + (long)(((uint64_t)next() * span) >> 32);
+  }
+
+  uint32_t word(int index) const { return _s[index]; }
+  void setWord(int index, uint32_t value) { _s[index] = value; }
+
+private:
+  static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+  uint32_t _s[PET_RANDOM_WORDS];
+};
@@ -0,0 +1,167 @@
+#include "power_manager.h"
+
+#include <esp_sleep.h>
+#include <sdkconfig.h>
+#if CONFIG_PM_ENABLE
+#include <esp_idf_version.h>
+#include <esp_pm.h>
+#endif
+
+static const uint32_t LEVEL_MHZ[3] = {80, 160, 240};
+
+// ESP32 datasheet, modem sleep (radio idle between beacons), dual core:
+// upper end of the range while computing, lower end while idling
+static const float BUSY_MA[3] = {31.0f, 44.0f, 68.0f};
+static const float IDLE_MA[3] = {20.0f, 27.0f, 30.0f};
+static const float LIGHT_SLEEP_MA = 0.8f;
+
+PowerManager::PowerManager()
+    : _level(2), _mhz(240), _deadline(0), _frameStartUs(0), _inFrame(true), _fitFrames(0),
+      _frames(0), _misses(0), _worstLateUs(0), _sleptUs(0) {
+  for (int i = 0; i < 3; i++) {
+    _busyUs[i] = 0;
+    _idleUs[i] = 0;
+  }
+}
+
+void PowerManager::begin() {
+  _level = -1; // force the first setLevel() through
+  setLevel(2);
+}
+
+void PowerManager::setLevel(int level) {
+  if (level == _level) {
+    return;
+  }
+  _level = level;
+  _mhz = LEVEL_MHZ[level];
+#if CONFIG_PM_ENABLE
+  // Let the PM driver scale down and light-sleep on its own below this
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_pm_config_t config;
+#else
+  esp_pm_config_esp32_t config;
+#endif
+  config.max_freq_mhz = _mhz;
+  config.min_freq_mhz = 80;
+  config.light_sleep_enable = true;
+  esp_pm_configure(&config);
+#else
+  setCpuFrequencyMhz(_mhz);
+#endif
+}
+
+void PowerManager::frameStart() {
+  uint32_t now = micros();
+  bool paced = !_inFrame;
+  if (!paced) {
+    // First frame, or the last loop() returned before frameEnd() because a
+    // firmware transfer is spinning the loop. Full speed, re-sync after.
+    setLevel(2);
+    _fitFrames = 0;
+  }
+  if (paced) {
+    _frames++;
+    int32_t late = (int32_t)(now - _deadline);
+    if (late > (int32_t)_worstLateUs) {
+      _worstLateUs = late;
+    }
+    if (late > (int32_t)POWER_LATE_US) {
+      _misses++;
+    }
+  } else {
+    _deadline = now;
+  }
+  _inFrame = true;
+  _frameStartUs = now;
+}
+
+void PowerManager::frameEnd(PowerLoad load, uint32_t ioUs, bool radioOn) {
+  uint32_t now = micros();
+  uint32_t work = now - _frameStartUs;
+  _busyUs[_level] += work;
+
+  // Lowest clock whose projected work fits; only the CPU share scales
+  int wanted = 2;
+  if (load != POWER_LOAD_NETWORK) {
+    uint32_t cpu = work > ioUs ? work - ioUs : 0;
+    for (int level = 0; level < 3; level++) {
+      float projected = (float)cpu * _mhz / LEVEL_MHZ[level] + ioUs;
+      if (projected <= POWER_FRAME_US * POWER_HEADROOM) {
+        wanted = level;
+        break;
+      }
+    }
+  }
+  // Clock up at once, down only after a run of frames that would have fit
+  if (wanted > _level) {
+    setLevel(wanted);
+    _fitFrames = 0;
+  } else if (wanted < _level && ++_fitFrames >= POWER_STEP_DOWN_FRAMES) {
+    setLevel(wanted);
+    _fitFrames = 0;
+  } else if (wanted == _level) {
+    _fitFrames = 0;
+  }
+
+  _deadline += POWER_FRAME_US;
+  if ((int32_t)(now - _deadline) > (int32_t)POWER_FRAME_US) {
+    _deadline = now; // hopelessly behind: start the next frame now, don't cascade
+  }
+  _inFrame = false;
+  idleUntil(_deadline, radioOn || load == POWER_LOAD_NETWORK);
+}
+
+void PowerManager::idleUntil(uint32_t deadline, bool radioOn) {
+  uint32_t start = micros();
+  int32_t remaining = (int32_t)(deadline - start);
+  if (remaining <= 0) {
+    return;
+  }
+
+#if !CONFIG_PM_ENABLE
+  // Manual light sleep drops WiFi and BLE links, so only with the radio off
+  if (!radioOn && remaining > (int32_t)POWER_MIN_SLEEP_US) {
+    Serial.flush();
+    esp_sleep_enable_timer_wakeup(remaining - POWER_WAKE_MARGIN_US);
+    esp_light_sleep_start();
+    _sleptUs += micros() - start;
+  }
+#endif
+
+  uint32_t idleStart = micros();
+  remaining = (int32_t)(deadline - idleStart);
+  if (remaining > 1000) {
+    delay(remaining / 1000 - 1); // tick-granular; may return up to a tick early
+  }
+  while ((int32_t)(deadline - micros()) > 0) {
+  }
+  _idleUs[_level] += micros() - idleStart;
+}
+
+String PowerManager::report() const {
+  uint64_t total = _sleptUs;
+  uint64_t busy = 0;
+  float charge = _sleptUs * LIGHT_SLEEP_MA;
+  for (int i = 0; i < 3; i++) {
+    total += _busyUs[i] + _idleUs[i];
+    busy += _busyUs[i];
+    charge += _busyUs[i] * BUSY_MA[i] + _idleUs[i] * IDLE_MA[i];
+  }
+  if (total == 0) {
+    return "no frames yet\n";
+  }
+  // The same frames at a fixed 240 MHz with delay() in between
+  float fixed = (busy * BUSY_MA[2] + (total - busy) * IDLE_MA[2]) / total;
+
+  String text = "cpu " + String(_mhz) + " MHz, frame " + String(POWER_FRAME_US / 1000) + " ms\n";
+  text += "frames " + String(_frames) + ", deadline misses " + String(_misses) + ", worst late " +
+          String(_worstLateUs) + " us\n";
+  for (int i = 0; i < 3; i++) {
+    text += String(LEVEL_MHZ[i]) + " MHz: " + String(100.0 * (_busyUs[i] + _idleUs[i]) / total, 1) + "%\n";
+  }
+  text += "light sleep: " + String(100.0 * _sleptUs / total, 1) + "%\n";
+  text += "estimated cpu current: " + String(charge / total, 1) + " mA (fixed 240 MHz: " +
+          String(fixed, 1) + " mA)\n";
+  return text;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Paces the animation on a fixed frame clock and spends the gap between
+// frames as cheaply as the next frame allows.
+//
+// After each frame the sketch says what kind of frame it was. The manager
+// then picks the lowest CPU clock (80/160/240 MHz) whose projected work
+// still fits comfortably in a frame. Only the CPU share of the measured
+// work is scaled; time spent on the I2C bus doesn't get faster with the
+// clock. It then idles until the next deadline:
+//
+//   - radio off (night-mode peek): light sleep, waking POWER_WAKE_MARGIN_US
+//     early to absorb the wake-up latency
+//   - radio on, with CONFIG_PM_ENABLE: FreeRTOS delay, and the power
+//     management driver light-sleeps between WiFi beacons on its own
+//   - radio on otherwise: plain delay at the lowered clock (manual light
+//     sleep would drop the WiFi association)
+//
+// A frame that starts more than POWER_LATE_US after its deadline counts as
+// a miss, so any smoothness cost of the power saving shows up in /power.
+
+// ~25 fps: what delay(16) plus a bus-bound full-frame flush used to give
+const uint32_t POWER_FRAME_US = 40000;
+const uint32_t POWER_LATE_US = 2000;
+const uint32_t POWER_WAKE_MARGIN_US = 1500;
+const uint32_t POWER_MIN_SLEEP_US = 4000;   // shorter gaps aren't worth a light sleep
+const float POWER_HEADROOM = 0.7f;          // projected work may fill 70% of a frame
+const int POWER_STEP_DOWN_FRAMES = 25;      // frames that must fit before clocking down
+
+enum PowerLoad {
+  POWER_LOAD_STATIC,    // nothing on screen changed, frame was skipped
+  POWER_LOAD_ANIMATING, // a frame was drawn and flushed
+  POWER_LOAD_NETWORK    // requests or transfers in flight: full speed, no sleep
+};
+
+class PowerManager {
+public:
+  PowerManager();
+
+  void begin();
+
+  // Call first thing in loop(); records how late the frame started
+  void frameStart();
+
+  // Call at the end of the frame instead of delay(). ioUs is the part of
+  // the frame spent waiting on the I2C bus.
+  void frameEnd(PowerLoad load, uint32_t ioUs, bool radioOn);
+
+  uint32_t cpuMhz() const { return _mhz; }
+  uint32_t frames() const { return _frames; }
+  uint32_t misses() const { return _misses; }
+  String report() const;
+
+private:
+  void setLevel(int level);
+  void idleUntil(uint32_t deadline, bool radioOn);
+
+  int _level;
+  uint32_t _mhz;
+  uint32_t _deadline;
+  uint32_t _frameStartUs;
+  bool _inFrame;
+  int _fitFrames;
+
+  uint32_t _frames;
+  uint32_t _misses;
+  uint32_t _worstLateUs;
+  uint64_t _busyUs[3];
+  uint64_t _idleUs[3];
+  uint64_t _sleptUs;
+};
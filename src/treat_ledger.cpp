@@ -0,0 +1,235 @@
+#include "treat_ledger.h"
+
+#include <string.h>
+
+static const uint32_t RECORD_MAGIC = 0x31525454; // "TTR1"
+
+// On-flash layout, little endian like the ESP32 itself. crc covers all the
+// words before it.
+struct LedgerRecord {
+  uint32_t magic;
+  uint32_t sequence;
+  uint32_t day;
+  uint32_t steps;
+  uint32_t converted;
+  uint32_t treats;
+  uint32_t reserved;
+  uint32_t crc;
+};
+
+static_assert(sizeof(LedgerRecord) == LEDGER_RECORD_SIZE, "ledger record must fill one slot");
+
+static uint32_t crc32(const uint8_t* data, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+static uint32_t recordCrc(const LedgerRecord& record) {
+  return crc32((const uint8_t*)&record, offsetof(LedgerRecord, crc));
+}
+
+static bool readRecord(LedgerFlash& flash, size_t slot, LedgerRecord& record) {
+  return flash.read(slot * LEDGER_RECORD_SIZE, (uint8_t*)&record, sizeof(record)) &&
+         record.magic == RECORD_MAGIC && record.crc == recordCrc(record);
+}
+
+static bool slotErased(LedgerFlash& flash, size_t slot) {
+  uint8_t bytes[LEDGER_RECORD_SIZE];
+  if (!flash.read(slot * LEDGER_RECORD_SIZE, bytes, sizeof(bytes))) {
+    return false;
+  }
+  for (size_t i = 0; i < sizeof(bytes); i++) {
+    if (bytes[i] != 0xFF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TreatLedger::TreatLedger(LedgerFlash& flash)
+    : _flash(flash), _slots(0), _nextSlot(0), _sequence(0) {
+  memset(&_state, 0, sizeof(_state));
+}
+
+bool TreatLedger::begin() {
+  size_t bytes = _flash.size();
+  if (bytes > LEDGER_SECTORS * LEDGER_SECTOR_SIZE) {
+    bytes = LEDGER_SECTORS * LEDGER_SECTOR_SIZE;
+  }
+  // Two sectors at least, so erasing the next one never wipes the newest record
+  _slots = (bytes / LEDGER_SECTOR_SIZE) * LEDGER_RECORDS_PER_SECTOR;
+  if (_slots < 2 * LEDGER_RECORDS_PER_SECTOR) {
+    _slots = 0;
+    return false;
+  }
+
+  bool found = false;
+  size_t newestSlot = 0;
+  for (size_t slot = 0; slot < _slots; slot++) {
+    LedgerRecord record;
+    if (readRecord(_flash, slot, record) && (!found || record.sequence > _sequence)) {
+      found = true;
+      newestSlot = slot;
+      _sequence = record.sequence;
+      _state.day = record.day;
+      _state.steps = record.steps;
+      _state.converted = record.converted;
+      _state.treats = record.treats;
+    }
+  }
+  _nextSlot = found ? (newestSlot + 1) % _slots : 0;
+  return true;
+}
+
+TreatState TreatLedger::state(uint32_t today) const {
+  TreatState current = _state;
+  if (today != 0 && today != current.day) {
+    current.day = today;
+    current.steps = 0;
+    current.converted = 0;
+  }
+  return current;
+}
+
+LedgerStatus TreatLedger::append(const TreatState& next) {
+  if (_slots == 0) {
+    return LEDGER_FLASH_ERROR;
+  }
+
+  LedgerRecord record;
+  record.magic = RECORD_MAGIC;
+  record.sequence = _sequence + 1;
+  record.day = next.day;
+  record.steps = next.steps;
+  record.converted = next.converted;
+  record.treats = next.treats;
+  record.reserved = 0xFFFFFFFF;
+  record.crc = recordCrc(record);
+
+  // Skip slots left dirty by an interrupted write. Never wrap back into the
+  // sector holding the newest record.
+  for (size_t attempt = 0; attempt < _slots - LEDGER_RECORDS_PER_SECTOR; attempt++) {
+    size_t slot = _nextSlot;
+    _nextSlot = (slot + 1) % _slots;
+
+    if (slot % LEDGER_RECORDS_PER_SECTOR == 0) {
+      if (!_flash.eraseSector(slot * LEDGER_RECORD_SIZE)) {
+        return LEDGER_FLASH_ERROR;
+      }
+    } else if (!slotErased(_flash, slot)) {
+      continue;
+    }
+
+    LedgerRecord check;
+    if (_flash.write(slot * LEDGER_RECORD_SIZE, (const uint8_t*)&record, sizeof(record)) &&
+        readRecord(_flash, slot, check) && check.sequence == record.sequence) {
+      _sequence = record.sequence;
+      _state = next;
+      return LEDGER_OK;
+    }
+  }
+  return LEDGER_FLASH_ERROR;
+}
+
+LedgerStatus TreatLedger::addSteps(uint32_t today, uint32_t day, uint32_t base, uint32_t delta) {
+  if (today == 0) {
+    return LEDGER_NO_CLOCK;
+  }
+  if (day != today) {
+    return LEDGER_WRONG_DAY;
+  }
+  TreatState next = state(today);
+  if (base != next.steps || next.steps + delta < next.steps) {
+    return LEDGER_CONFLICT;
+  }
+  if (delta == 0) {
+    return LEDGER_OK;
+  }
+  next.steps += delta;
+  return append(next);
+}
+
+LedgerStatus TreatLedger::convert(uint32_t today, uint32_t& treatsAdded) {
+  treatsAdded = 0;
+  if (today == 0) {
+    return LEDGER_NO_CLOCK;
+  }
+  TreatState next = state(today);
+  uint32_t added = (next.steps - next.converted) / LEDGER_STEPS_PER_TREAT;
+  if (added == 0) {
+    return LEDGER_OK;
+  }
+  next.converted += added * LEDGER_STEPS_PER_TREAT;
+  next.treats += added;
+  LedgerStatus status = append(next);
+  if (status == LEDGER_OK) {
+    treatsAdded = added;
+  }
+  return status;
+}
+
+LedgerStatus TreatLedger::spend(uint32_t today, uint32_t count, uint32_t expectedTreats) {
+  TreatState next = state(today);
+  if (expectedTreats != LEDGER_ANY && expectedTreats != next.treats) {
+    return LEDGER_CONFLICT;
+  }
+  if (next.treats < count) {
+    return LEDGER_NO_TREATS;
+  }
+  if (count == 0) {
+    return LEDGER_OK;
+  }
+  next.treats -= count;
+  return append(next);
+}
+
+const char* TreatLedger::statusString(LedgerStatus status) {
+  switch (status) {
+    case LEDGER_OK: return "ok";
+    case LEDGER_CONFLICT: return "conflict";
+    case LEDGER_WRONG_DAY: return "wrong day";
+    case LEDGER_NO_CLOCK: return "no clock";
+    case LEDGER_NO_TREATS: return "no treats";
+    case LEDGER_FLASH_ERROR: return "flash error";
+  }
+  return "unknown";
+}
+
+#ifdef ARDUINO
+#include <esp_partition.h>
+
+PartitionLedgerFlash::PartitionLedgerFlash() : _partition(nullptr) {}
+
+static const esp_partition_t* ledgerPartition(const void*& cached) {
+  if (cached == nullptr) {
+    cached = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, nullptr);
+  }
+  return (const esp_partition_t*)cached;
+}
+
+size_t PartitionLedgerFlash::size() {
+  const esp_partition_t* partition = ledgerPartition(_partition);
+  return partition ? partition->size : 0;
+}
+
+bool PartitionLedgerFlash::read(size_t offset, uint8_t* out, size_t len) {
+  const esp_partition_t* partition = ledgerPartition(_partition);
+  return partition && esp_partition_read(partition, offset, out, len) == ESP_OK;
+}
+
+bool PartitionLedgerFlash::write(size_t offset, const uint8_t* data, size_t len) {
+  const esp_partition_t* partition = ledgerPartition(_partition);
+  return partition && esp_partition_write(partition, offset, data, len) == ESP_OK;
+}
+
+bool PartitionLedgerFlash::eraseSector(size_t offset) {
+  const esp_partition_t* partition = ledgerPartition(_partition);
+  return partition && esp_partition_erase_range(partition, offset, LEDGER_SECTOR_SIZE) == ESP_OK;
+}
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Step-to-treat accounting kept on the device, so every phone and browser
+// sees the same balance and steps can only be converted once.
+//
+// The ledger is an append-only log of fixed 32 byte records in a small flash
+// region. Each record is a full snapshot (day, steps reported that day,
+// steps already converted, treat balance) protected by a CRC32, so a torn
+// write is simply ignored and the previous record wins. Appending costs one
+// record write, plus a 4 KB sector erase every LEDGER_RECORDS_PER_SECTOR
+// records when the log moves on to the next sector.
+//
+// Steps arrive as deltas guarded by the total the client last saw
+// (compare-and-set), which makes retries and several clients reporting the
+// same Google Fit day harmless: a stale request is rejected with the current
+// state and the client recomputes its delta.
+
+const uint32_t LEDGER_STEPS_PER_TREAT = 500;
+const size_t LEDGER_SECTOR_SIZE = 4096;
+const size_t LEDGER_SECTORS = 8;
+const size_t LEDGER_RECORD_SIZE = 32;
+const size_t LEDGER_RECORDS_PER_SECTOR = LEDGER_SECTOR_SIZE / LEDGER_RECORD_SIZE;
+const uint32_t LEDGER_ANY = 0xFFFFFFFF; // spend() without a balance check
+
+enum LedgerStatus {
+  LEDGER_OK,
+  LEDGER_CONFLICT,    // stale base total; the caller should resync
+  LEDGER_WRONG_DAY,   // the caller's local day isn't the device's
+  LEDGER_NO_CLOCK,    // day unknown, steps can't be attributed yet
+  LEDGER_NO_TREATS,   // nothing left to spend
+  LEDGER_FLASH_ERROR
+};
+
+struct TreatState {
+  uint32_t day;       // days since 1970, local time
+  uint32_t steps;     // steps reported for that day
+  uint32_t converted; // of which already turned into treats
+  uint32_t treats;    // balance, carried across days
+};
+
+// Raw flash region the log lives in. Writes only clear bits; eraseSector()
+// sets a whole LEDGER_SECTOR_SIZE sector back to 0xFF.
+class LedgerFlash {
+public:
+  virtual ~LedgerFlash() {}
+  virtual size_t size() = 0;
+  virtual bool read(size_t offset, uint8_t* out, size_t len) = 0;
+  virtual bool write(size_t offset, const uint8_t* data, size_t len) = 0;
+  virtual bool eraseSector(size_t offset) = 0;
+};
+
+class TreatLedger {
+public:
+  explicit TreatLedger(LedgerFlash& flash);
+
+  // Scan the log for the newest valid record. Returns false if the flash
+  // region is missing or too small.
+  bool begin();
+
+  // State as of today: a new day starts with no steps but keeps the treats.
+  TreatState state(uint32_t today) const;
+
+  // Steps for the caller's own local day, which must be today on the
+  // device too: a phone in another time zone counts a different day.
+  LedgerStatus addSteps(uint32_t today, uint32_t day, uint32_t base, uint32_t delta);
+  LedgerStatus convert(uint32_t today, uint32_t& treatsAdded);
+  LedgerStatus spend(uint32_t today, uint32_t count, uint32_t expectedTreats = LEDGER_ANY);
+
+  static const char* statusString(LedgerStatus status);
+
+private:
+  LedgerStatus append(const TreatState& next);
+
+  LedgerFlash& _flash;
+  size_t _slots;
+  size_t _nextSlot;
+  uint32_t _sequence;
+  TreatState _state;
+};
+
+#ifdef ARDUINO
+// LedgerFlash on the start of the data partition the default partition
+// tables reserve for SPIFFS, which this firmware doesn't otherwise mount.
+class PartitionLedgerFlash : public LedgerFlash {
+public:
+  PartitionLedgerFlash();
+  size_t size() override;
+  bool read(size_t offset, uint8_t* out, size_t len) override;
+  bool write(size_t offset, const uint8_t* data, size_t len) override;
+  bool eraseSector(size_t offset) override;
+
+private:
+  const void* _partition; // esp_partition_t
+};
+#endif
@@ -10,44 +10,67 @@ let isInitialized = false;
 let currentSteps = 0;
 let availableTreats = 0;
 
-const STEPS_PER_TREAT = 500;
-
-let gameData = {
-  convertedSteps: 0,
-  totalTreats: 0,
-  lastUpdateDate: null,
+// Treat accounting lives on the device (/treats, /steps) so every phone
+// and browser shares one balance. This mirrors its last reply.
+let ledger = {
+  day: 0,
+  steps: 0,
+  converted: 0,
+  treats: 0,
+  perTreat: 500,
 };
 
-function saveGameData() {
-  localStorage.setItem("virtualPetData", JSON.stringify(gameData));
-  console.log("Game data saved:", gameData);
+// The device answers with its current state even when it rejects a
+// request (409 for a stale total), so always take the body.
+async function ledgerRequest(path) {
+  const response = await fetch(path);
+  const state = await response.json();
+  ledger = state;
+  console.log("Ledger:", state);
+  return response.ok;
 }
 
-function loadGameData() {
-  const saved = localStorage.getItem("virtualPetData");
-  if (saved) {
-    gameData = JSON.parse(saved);
+async function loadLedger() {
+  try {
+    await ledgerRequest("/treats");
+  } catch (error) {
+    console.error("Error loading treats:", error);
   }
-  console.log("Game data loaded:", gameData);
+  updateTreatsDisplay();
 }
 
-function isNewDay() {
-  const today = new Date().toDateString();
-  return gameData.lastUpdateDate !== today;
+// Days since 1970 in this browser's time zone: the day Google Fit's
+// total below is for
+function localDay() {
+  const now = new Date();
+  return Math.floor((now.getTime() - now.getTimezoneOffset() * 60000) / 86400000);
 }
 
-function updateDateIfNeeded() {
-  const today = new Date().toDateString();
-  if (gameData.lastUpdateDate !== today) {
-    gameData.lastUpdateDate = today;
-    gameData.convertedSteps = 0; // Reset converted steps for new day
-    saveGameData();
+// Report today's Google Fit total as a delta on top of what the device has.
+// If another client got there first the device replies 409 with its new
+// total and the delta is recomputed. The day sent is ours; if the device's
+// clock says it's another day (its PET_TIMEZONE isn't ours) it refuses,
+// rather than counting these steps against the wrong day.
+async function reportSteps(totalSteps) {
+  const day = localDay();
+  for (let attempt = 0; attempt < 3; attempt++) {
+    if (ledger.day !== day) {
+      console.warn(`Device is on day ${ledger.day}, this browser on ${day}; not reporting steps`);
+      return;
+    }
+    if (totalSteps <= ledger.steps) {
+      return;
+    }
+    const delta = totalSteps - ledger.steps;
+    if (await ledgerRequest(`/steps?day=${day}&base=${ledger.steps}&delta=${delta}`)) {
+      return;
+    }
   }
 }
 
 async function initializeGapi() {
   try {
-    loadGameData();
+    await loadLedger();
 
     await new Promise((resolve) => {
       gapi.load("client", resolve);
@@ -86,7 +109,7 @@ function connectToGoogleFit() {
 
 async function fetchData() {
   try {
-    updateDateIfNeeded();
+    await ledgerRequest("/treats"); // also picks up a new day on the device
 
     const now = new Date();
     const startOfDay = new Date(
@@ -142,8 +165,10 @@ async function fetchData() {
       }
     }
 
-    const availableSteps = Math.max(0, totalSteps - gameData.convertedSteps);
-    availableTreats = Math.floor(availableSteps / STEPS_PER_TREAT);
+    await reportSteps(totalSteps);
+
+    const availableSteps = Math.max(0, ledger.steps - ledger.converted);
+    availableTreats = Math.floor(availableSteps / ledger.perTreat);
 
     currentSteps = availableSteps;
 
@@ -178,9 +203,9 @@ async function fetchData() {
 // New helper function to update the treats display and button
 function updateTreatsDisplay() {
   const totalTreatsElement = document.getElementById("totalTreats");
-  if (gameData.totalTreats > 0) {
+  if (ledger.treats > 0) {
     totalTreatsElement.innerHTML = `
-      Total Treats: ${gameData.totalTreats}
+      Total Treats: ${ledger.treats}
       <button id="feedBtn" onclick="feedPet()" class="feed-btn">
         Feed Pet
       </button>
@@ -193,19 +218,23 @@ function updateTreatsDisplay() {
   // Disable feed button if no treats
   const feedBtn = document.getElementById("feedBtn");
   if (feedBtn) {
-    feedBtn.disabled = gameData.totalTreats === 0;
+    feedBtn.disabled = ledger.treats === 0;
   }
 }
 
-function convertToTreats() {
+async function convertToTreats() {
   if (availableTreats === 0) return;
 
-  const stepsToConvert = availableTreats * STEPS_PER_TREAT;
-  const remainingSteps = currentSteps - stepsToConvert;
-
-  gameData.convertedSteps += stepsToConvert;
-  gameData.totalTreats += availableTreats;
-  saveGameData();
+  const treatsBefore = ledger.treats;
+  try {
+    await ledgerRequest("/treats?convert=1");
+  } catch (error) {
+    console.error("Error converting steps:", error);
+    return;
+  }
+  // Another client may have converted some of the same steps already
+  const bought = ledger.treats - treatsBefore;
+  const remainingSteps = Math.max(0, ledger.steps - ledger.converted);
 
   document.getElementById(
     "stepDisplay"
@@ -215,9 +244,7 @@ function convertToTreats() {
 
   document.getElementById(
     "treatResult"
-  ).textContent = `${availableTreats} Treat${
-    availableTreats !== 1 ? "s" : ""
-  } Bought!`;
+  ).textContent = `${bought} Treat${bought !== 1 ? "s" : ""} Bought!`;
   document.getElementById("treatResult").style.display = "block";
 
   // Update treats display and button after conversion
@@ -231,10 +258,14 @@ function convertToTreats() {
   }, 3000);
 }
 
-function updateTreatsAfterFeed() {
-  if (gameData.totalTreats > 0) {
-    gameData.totalTreats -= 1;
-    saveGameData();
+async function updateTreatsAfterFeed() {
+  if (ledger.treats > 0) {
+    try {
+      // base makes a retried request a no-op instead of a second treat
+      await ledgerRequest(`/treats?spend=1&base=${ledger.treats}`);
+    } catch (error) {
+      console.error("Error spending treat:", error);
+    }
   }
   // Always update display after feeding, even if it goes to 0
   updateTreatsDisplay();
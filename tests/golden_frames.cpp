@@ -0,0 +1,454 @@
+// Golden-frame regression test for the eye renderer. Renders every
+// expression (drawn, and blitted from the artwork), points along the
+// transitions to and from neutral, the blink phases, the happy stars at
+// fixed times, the gaze following a point, a breath, frames from each
+// animation clip (src/eye_clips.h), including one decoded again after
+// something was drawn over it, and both panels of the one-panel-per-eye
+// mode, through the same EyeEngine the sketches use, on the mock U8g2 in
+// host/, and compares each frame bit for bit with a checked-in PBM image.
+// The drawn frames are rendered again page by page (EyePaged) and held to
+// the same images.
+//
+//   cmake -S . -B build && cmake --build build && ctest --test-dir build
+//   ./build/golden_frames tests/golden                    # check
+//   ./build/golden_frames tests/golden --out diffs        # keep the failures
+//   ./build/golden_frames tests/golden --update           # accept new output
+//
+// A frame that doesn't match is written to the --out directory (default
+// golden_diff) as NAME.actual.pbm, next to NAME.diff.ppm: white where
+// both have the pixel, red where only the golden does, green where only
+// the new frame does. Images are binary PBM (P4) the size of the display,
+// lit pixels white, so they look like the OLED.
+//
+// Behaviour runs on the mock clock at the device's 40 ms frame pace from a
+// fixed seed, so frames are the same on every run; a change in the
+// behaviour code that moves a blink or a transition step will show up here
+// too. Exits non-zero if any frame differs or has no golden.
+
+#include "eye_artwork.h"
+#include "eye_clips.h"
+#include "eye_engine.h"
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+static const char* const STATE_NAMES[STATE_COUNT] = {
+  "neutral", "angry", "surprised", "sad", "suspicious", "left",
+  "right", "up", "down", "sleepy", "happy"
+};
+
+const uint32_t FRAME_MS = 40;
+const int WIDTH = EyeSsd1306I2c::width;
+const int HEIGHT = EyeSsd1306I2c::height;
+const int ROW_BYTES = WIDTH / 8;
+
+typedef std::vector<uint8_t> Image;  // P4 raster, 1 = dark
+
+static Image capture(const U8G2& display) {
+  Image image(ROW_BYTES * HEIGHT, 0xff);
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      if (display.pixel(x, y)) {
+        image[y * ROW_BYTES + x / 8] &= ~(0x80 >> (x & 7));
+      }
+    }
+  }
+  return image;
+}
+
+struct GoldenEyes : EyeFeatures {
+  static constexpr bool readingLight = true;
+  static constexpr bool stars = true;
+};
+
+// The same with the resting expressions blitted from src/eye_artwork.h
+struct ArtworkEyes : GoldenEyes {
+  static constexpr bool artwork = true;
+  static const EyeBitmap* artworkFor(EyeState state) { return EYE_ARTWORK[state]; }
+};
+
+// With clips played over the face
+struct ClipEyes : GoldenEyes {
+  static constexpr bool clips = true;
+};
+
+// With the eyes following a point
+struct GazeEyes : GoldenEyes {
+  static constexpr bool gaze = true;
+};
+
+// Breathing
+struct BreathEyes : GoldenEyes {
+  static constexpr bool breathing = true;
+};
+
+template <typename Features = GoldenEyes, typename Display = EyeSsd1306I2c>
+class Renderer {
+public:
+  Renderer() : _display(U8G2_R0), _eyes(_display, _clock) {
+    hostSetMillis(10000);
+    _display.begin();
+    _eyes.begin(20240601);
+  }
+
+  PetBehavior& pet() { return _eyes.pet(); }
+  EyeEngine<Features, Display>& eyes() { return _eyes; }
+
+  // Show state at rest, in manual mode so nothing wanders off
+  void show(EyeState state) { pet().restore(state, true, false, false); }
+
+  void step() {
+    hostAdvanceMillis(FRAME_MS);
+    pet().update(false, STATE_NEUTRAL);
+  }
+
+  // Step until a blink has just finished: the next one is at least two
+  // seconds off, so a transition started now runs undisturbed
+  void settle() {
+    while (!pet().blinking()) {
+      step();
+    }
+    while (pet().blinking()) {
+      step();
+    }
+  }
+
+  Image frame() {
+    _eyes.draw();
+    return capture();
+  }
+
+  // What's in the display buffer now, without drawing
+  Image capture() { return ::capture(_display); }
+
+private:
+  typename Display::Panel _display;
+  MillisClock _clock;
+  EyeEngine<Features, Display> _eyes;
+};
+
+static bool pixelOn(const Image& image, int x, int y) {
+  return !(image[y * ROW_BYTES + x / 8] & (0x80 >> (x & 7)));
+}
+
+static bool readPbm(const std::string& path, Image& image) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) {
+    return false;
+  }
+  int width = 0, height = 0;
+  bool ok = fscanf(f, "P4 %d %d", &width, &height) == 2 && width == WIDTH && height == HEIGHT &&
+            fgetc(f) != EOF;
+  if (ok) {
+    image.assign(ROW_BYTES * HEIGHT, 0);
+    ok = fread(image.data(), 1, image.size(), f) == image.size();
+  }
+  fclose(f);
+  return ok;
+}
+
+static bool writePbm(const std::string& path, const Image& image) {
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) {
+    return false;
+  }
+  fprintf(f, "P4\n%d %d\n", WIDTH, HEIGHT);
+  fwrite(image.data(), 1, image.size(), f);
+  return fclose(f) == 0;
+}
+
+static bool writeDiff(const std::string& path, const Image& golden, const Image& actual) {
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) {
+    return false;
+  }
+  fprintf(f, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      bool was = pixelOn(golden, x, y);
+      bool now = pixelOn(actual, x, y);
+      uint8_t rgb[3] = {0, 0, 0};
+      if (was && now) {
+        rgb[0] = rgb[1] = rgb[2] = 255;
+      } else if (was) {
+        rgb[0] = 255;
+      } else if (now) {
+        rgb[1] = 255;
+      }
+      fwrite(rgb, 1, 3, f);
+    }
+  }
+  return fclose(f) == 0;
+}
+
+struct Frame {
+  std::string name;
+  std::string golden;  // compared with golden/NAME.pbm
+  Image image;
+};
+
+typedef std::function<void(const std::string& name, const Image& image)> AddFrame;
+
+// Everything the engine draws rather than blits: the expressions, the
+// reading light, the transitions, the blinks and the stars
+template <typename Display>
+static void renderDrawn(const AddFrame& add) {
+  typedef Renderer<GoldenEyes, Display> Drawn;
+
+  // Every expression at rest
+  for (int s = 0; s < STATE_COUNT; s++) {
+    Drawn r;
+    r.show((EyeState)s);
+    add(std::string("rest_") + STATE_NAMES[s], r.frame());
+  }
+
+  {
+    Drawn r;
+    r.pet().setReadingLight(true);
+    add("reading_light", r.frame());
+  }
+
+  // Each transition to and from neutral, frame by frame until it lands
+  for (int s = 1; s < STATE_COUNT; s++) {
+    for (int back = 0; back < 2; back++) {
+      EyeState from = back ? (EyeState)s : STATE_NEUTRAL;
+      EyeState to = back ? STATE_NEUTRAL : (EyeState)s;
+      Drawn r;
+      r.show(from);
+      r.settle();
+      r.pet().setEmotion(to);
+      for (int step = 1; r.pet().transitioning(); step++) {
+        r.step();
+        if (r.pet().transitioning()) {
+          char name[64];
+          snprintf(name, sizeof(name), "transition_%s_to_%s_%03ums", STATE_NAMES[from], STATE_NAMES[to],
+                   (unsigned)(step * FRAME_MS));
+          add(name, r.frame());
+        }
+      }
+    }
+  }
+
+  // Blink phases: half-closed, closed, half-open
+  for (EyeState s : {STATE_NEUTRAL, STATE_ANGRY}) {
+    Drawn r;
+    r.show(s);
+    r.settle();
+    while (!r.pet().blinking()) {
+      r.step();
+    }
+    add(std::string("blink_") + STATE_NAMES[s] + "_closing", r.frame());
+    while (r.pet().openness() >= 0.5) {
+      r.step();
+    }
+    add(std::string("blink_") + STATE_NAMES[s] + "_closed", r.frame());
+    while (r.pet().openness() < 0.5) {
+      r.step();
+    }
+    add(std::string("blink_") + STATE_NAMES[s] + "_opening", r.frame());
+  }
+
+  // Happy stars through one twinkle period (2 * pi * 150 ms)
+  for (int t = 0; t < 1000; t += 125) {
+    Drawn r;
+    hostSetMillis(60000 + t);
+    r.show(STATE_HAPPY);
+    char name[32];
+    snprintf(name, sizeof(name), "stars_%04dms", t);
+    add(name, r.frame());
+  }
+
+}
+
+static std::vector<Frame> renderAll() {
+  std::vector<Frame> frames;
+  AddFrame add = [&frames](const std::string& name, const Image& image) {
+    frames.push_back(Frame{name, name, image});
+  };
+
+  renderDrawn<EyeSsd1306I2c>(add);
+
+  // The same a page at a time through the display list: the same pixels
+  renderDrawn<EyePaged<EyeSsd1306I2c>>([&frames](const std::string& name, const Image& image) {
+    frames.push_back(Frame{"paged_" + name, name, image});
+  });
+
+  // The expressions from the artwork
+  for (int s = 0; s < STATE_COUNT; s++) {
+    if (EYE_ARTWORK[s]) {
+      Renderer<ArtworkEyes> r;
+      r.show((EyeState)s);
+      add(std::string("artwork_") + STATE_NAMES[s], r.frame());
+    }
+  }
+
+  // Each clip's first, middle and last frames as loop() plays them
+  for (int c = 0; c < EYE_CLIP_COUNT; c++) {
+    Renderer<ClipEyes> r;
+    r.show(STATE_NEUTRAL);
+    r.eyes().play(EYE_CLIPS[c]);
+    ClipPlayer probe;
+    MemoryClipSource source(EYE_CLIPS[c]);
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0);
+    probe.start(source, display, 0);
+    uint32_t start = millis();
+    for (int f : {0, probe.frameCount() / 2, probe.frameCount() - 1}) {
+      hostSetMillis(start + f * probe.periodMs());
+      r.eyes().frame();
+      char name[48];
+      snprintf(name, sizeof(name), "clip_%s_%02d", EYE_CLIPS[c].name, f);
+      add(name, r.capture());
+    }
+  }
+
+  // The last frame again, after the face was drawn over the one before:
+  // the player goes back to the last key frame and decodes from there
+  // rather than applying a delta to the face, so it must match the frame
+  // played straight through
+  for (int c = 0; c < EYE_CLIP_COUNT; c++) {
+    Renderer<ClipEyes> r;
+    r.show(STATE_NEUTRAL);
+    r.eyes().play(EYE_CLIPS[c]);
+    ClipPlayer probe;
+    MemoryClipSource source(EYE_CLIPS[c]);
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0);
+    probe.start(source, display, 0);
+    uint32_t start = millis();
+    int f = probe.frameCount() - 1;
+    hostSetMillis(start + (f - 1) * probe.periodMs());
+    r.eyes().frame();
+    r.eyes().draw();
+    hostSetMillis(start + f * probe.periodMs());
+    r.eyes().frame();
+    char name[48];
+    snprintf(name, sizeof(name), "clip_%s_%02d_redrawn", EYE_CLIPS[c].name, f);
+    add(name, r.capture());
+  }
+
+  // The eyes turning to a point and back on the gaze spring, as loop()
+  // draws them
+  {
+    Renderer<GazeEyes> r;
+    r.show(STATE_NEUTRAL);
+    r.settle();
+    r.eyes().frame();
+    r.eyes().gaze().lookAt(112, 8);
+    for (int t = 40; t <= 400; t += 40) {
+      hostAdvanceMillis(FRAME_MS);
+      r.eyes().frame();
+      if (t <= 160 || t == 400) {
+        char name[32];
+        snprintf(name, sizeof(name), "gaze_look_%03dms", t);
+        add(name, r.capture());
+      }
+    }
+    r.eyes().gaze().release();
+    for (int t = 40; t <= 400; t += 40) {
+      hostAdvanceMillis(FRAME_MS);
+      r.eyes().frame();
+    }
+    add("gaze_ahead", r.capture());
+  }
+
+  // A breath, in and out
+  for (int t = 0; t < (int)EYE_BREATH_MS; t += EYE_BREATH_MS / 4) {
+    Renderer<BreathEyes> r;
+    hostSetMillis(60000 + t);
+    r.show(STATE_NEUTRAL);
+    char name[32];
+    snprintf(name, sizeof(name), "breath_%04dms", t);
+    add(name, r.frame());
+  }
+
+  // One panel per eye, stars on the panel of their half of the face
+  for (EyeState s : {STATE_NEUTRAL, STATE_SURPRISED, STATE_HAPPY}) {
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C left(U8G2_R0);
+    U8G2_SSD1306_128X64_NONAME_F_2ND_HW_I2C right(U8G2_R0);
+    EyeDualPanel panels(left, right);
+    MillisClock clock;
+    EyeEngine<GoldenEyes, EyeSsd1306Pair> eyes(panels, clock);
+    hostSetMillis(10000);
+    panels.begin();
+    eyes.begin(20240601);
+    eyes.pet().restore(s, true, false, false);
+    eyes.draw();
+    add(std::string("dual_") + STATE_NAMES[s] + "_left", capture(left));
+    add(std::string("dual_") + STATE_NAMES[s] + "_right", capture(right));
+  }
+  return frames;
+}
+
+int main(int argc, char** argv) {
+  const char* goldenDir = nullptr;
+  std::string outDir = "golden_diff";
+  bool update = false;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--update") == 0) {
+      update = true;
+    } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+      outDir = argv[++i];
+    } else if (!goldenDir && argv[i][0] != '-') {
+      goldenDir = argv[i];
+    } else {
+      goldenDir = nullptr;
+      break;
+    }
+  }
+  if (!goldenDir) {
+    fprintf(stderr, "usage: %s golden-dir [--update] [--out diff-dir]\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<Frame> frames = renderAll();
+  int failed = 0;
+  int written = 0;
+  for (const Frame& frame : frames) {
+    std::string golden = std::string(goldenDir) + "/" + frame.golden + ".pbm";
+    if (update) {
+      if (frame.golden != frame.name) {
+        continue;
+      }
+      if (!writePbm(golden, frame.image)) {
+        fprintf(stderr, "can't write %s\n", golden.c_str());
+        return 1;
+      }
+      written++;
+      continue;
+    }
+
+    Image expected;
+    if (!readPbm(golden, expected)) {
+      printf("FAIL %-40s no golden image %s\n", frame.name.c_str(), golden.c_str());
+      failed++;
+      continue;
+    }
+    if (expected == frame.image) {
+      continue;
+    }
+
+    int pixels = 0;
+    for (int y = 0; y < HEIGHT; y++) {
+      for (int x = 0; x < WIDTH; x++) {
+        pixels += pixelOn(expected, x, y) != pixelOn(frame.image, x, y);
+      }
+    }
+    mkdir(outDir.c_str(), 0755);
+    std::string base = outDir + "/" + frame.name;
+    writePbm(base + ".actual.pbm", frame.image);
+    writeDiff(base + ".diff.ppm", expected, frame.image);
+    printf("FAIL %-40s %d pixels differ, see %s.diff.ppm\n", frame.name.c_str(), pixels, base.c_str());
+    failed++;
+  }
+
+  if (update) {
+    printf("wrote %d golden frames to %s\n", written, goldenDir);
+    return 0;
+  }
+  printf("%zu frames, %d failed\n", frames.size(), failed);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,401 @@
+// Firmware upload test: streams images through the same OtaStream the
+// /update route and BLE OTA use (src/ota_stream.h), into an in-memory
+// OtaSink standing in for the Update partition writer, and checks what
+// reaches "flash" and whether it would boot:
+//
+//   good       - the whole image with its digest: committed, byte for byte
+//   truncated  - the tail never arrives: digest mismatch, nothing committed
+//   bad digest - the whole image, but the uploader's digest is wrong
+//
+// plus a malformed digest argument and writes after a failure. Then the
+// same through OtaDecoder (src/ota_decode.h): zlib and delta uploads that
+// decode to the image, a zlib stream with a window bigger than the
+// device's (refused on its first byte), a cut-off stream, and delta
+// patches that make less or more than the size in their header. Last, the
+// /update route's bookkeeping (src/ota_http.h): an unknown encoding is
+// reported as such, not as an earlier upload's outcome, and an upload the
+// client walks away from lets go of the screen, so the face comes back
+// (on the mock display, through the same EyeEngine as the sketch). The image
+// is fed in uneven chunks, like HTTP and BLE deliver it, and its SHA-256
+// is checked in (from Python's hashlib), so the hashing is held to a
+// reference rather than to itself.
+//
+//   cmake -S . -B build && cmake --build build && ctest --test-dir build
+//   ./build/ota_upload
+//
+// Exits non-zero if any check fails.
+
+#include "eye_engine.h"
+#include "eye_render.h"
+#include "ota_decode.h"
+#include "ota_http.h"
+#include "ota_stream.h"
+
+#include <zlib.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+typedef std::vector<uint8_t> Bytes;
+
+const size_t IMAGE_SIZE = 100000;
+const char IMAGE_SHA256[] = "5f3d22bea9131f434d922d55fb4b3359164af01bc996a9bbfd4b308f4bbebf75";
+const char HEAD_SHA256[] = "872b9505e78f859f1bba5cb310c3489aed86ee557979dead072946fcc026e060"; // first 60000
+const char ABC_SHA256[] = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+
+// The inactive partition: what was written, and whether it was made the
+// boot image
+class MemorySink : public OtaSink {
+public:
+  bool begin(size_t size) override {
+    data.clear();
+    begun = true;
+    committed = false;
+    aborted = false;
+    expected = size;
+    return true;
+  }
+  size_t write(const uint8_t* bytes, size_t len) override {
+    data.insert(data.end(), bytes, bytes + len);
+    return len;
+  }
+  bool commit() override {
+    committed = true;
+    return true;
+  }
+  void abort() override { aborted = true; }
+
+  Bytes data;
+  size_t expected = 0;
+  bool begun = false;
+  bool committed = false;
+  bool aborted = false;
+};
+
+// The running firmware a delta is applied against
+class MemoryBase : public OtaBaseImage {
+public:
+  explicit MemoryBase(const Bytes& bytes) : _bytes(bytes) {}
+  size_t size() override { return _bytes.size(); }
+  bool read(size_t offset, uint8_t* out, size_t len) override {
+    if (offset + len > _bytes.size()) {
+      return false;
+    }
+    memcpy(out, _bytes.data() + offset, len);
+    return true;
+  }
+
+private:
+  const Bytes& _bytes;
+};
+
+static int failed = 0;
+
+static void check(bool ok, const char* test, const char* what) {
+  if (!ok) {
+    printf("FAIL %s: %s\n", test, what);
+    failed++;
+  }
+}
+
+static Bytes testImage() {
+  Bytes image(IMAGE_SIZE);
+  for (size_t i = 0; i < IMAGE_SIZE; i++) {
+    image[i] = (uint8_t)(i * 31 + (i >> 8));
+  }
+  return image;
+}
+
+// Uneven chunks, as they come off the wire
+template <typename Upload>
+static OtaStreamStatus feed(Upload& stream, const uint8_t* data, size_t len) {
+  static const size_t CHUNKS[] = {1, 509, 1436, 64, 4096, 3};
+  size_t next = 0;
+  for (size_t offset = 0; offset < len;) {
+    size_t take = CHUNKS[next++ % (sizeof(CHUNKS) / sizeof(CHUNKS[0]))];
+    if (take > len - offset) {
+      take = len - offset;
+    }
+    OtaStreamStatus status = stream.write(data + offset, take);
+    if (status != OTA_STREAM_OK) {
+      return status;
+    }
+    offset += take;
+  }
+  return OTA_STREAM_OK;
+}
+
+static void testDigestReference() {
+  const char* test = "sha256 reference";
+  MemorySink sink;
+  OtaStream stream(sink);
+  check(stream.begin(3, ABC_SHA256) == OTA_STREAM_OK, test, "begin");
+  stream.write((const uint8_t*)"abc", 3);
+  check(stream.end() == OTA_STREAM_OK, test, "digest of \"abc\"");
+}
+
+static void testGood(const Bytes& image, size_t announced) {
+  const char* test = announced ? "good image" : "good image, size unknown";
+  MemorySink sink;
+  OtaStream stream(sink);
+  check(stream.begin(announced, IMAGE_SHA256) == OTA_STREAM_OK, test, "begin");
+  check(sink.begun && sink.expected == announced, test, "sink begun with the announced size");
+  check(feed(stream, image.data(), image.size()) == OTA_STREAM_OK, test, "write");
+  check(stream.written() == image.size(), test, "written() counts every byte");
+  check(stream.end() == OTA_STREAM_OK, test, "end");
+  check(sink.committed && !sink.aborted, test, "committed");
+  check(sink.data == image, test, "flash holds the image");
+  check(!stream.active(), test, "inactive after end");
+}
+
+static void testTruncated(const Bytes& image, size_t announced) {
+  const char* test = announced ? "truncated image" : "truncated image, size unknown";
+  MemorySink sink;
+  OtaStream stream(sink);
+  check(stream.begin(announced, IMAGE_SHA256) == OTA_STREAM_OK, test, "begin");
+  check(feed(stream, image.data(), image.size() - 1000) == OTA_STREAM_OK, test, "write");
+  check(stream.end() == OTA_STREAM_DIGEST_MISMATCH, test, "end reports a digest mismatch");
+  check(!sink.committed && sink.aborted, test, "aborted, not committed");
+}
+
+static void testWrongDigest(const Bytes& image) {
+  const char* test = "wrong digest";
+  std::string digest = IMAGE_SHA256;
+  digest[10] = digest[10] == '0' ? '1' : '0';
+  MemorySink sink;
+  OtaStream stream(sink);
+  check(stream.begin(image.size(), digest.c_str()) == OTA_STREAM_OK, test, "begin");
+  check(feed(stream, image.data(), image.size()) == OTA_STREAM_OK, test, "write");
+  check(stream.end() == OTA_STREAM_DIGEST_MISMATCH, test, "end reports a digest mismatch");
+  check(!sink.committed && sink.aborted, test, "aborted, not committed");
+  check(stream.lastStatus() == OTA_STREAM_DIGEST_MISMATCH, test, "lastStatus()");
+}
+
+static void testMalformedDigest() {
+  const char* test = "malformed digest";
+  std::string shortDigest(IMAGE_SHA256, 63);
+  std::string notHex = IMAGE_SHA256;
+  notHex[0] = 'g';
+  const char* digests[] = {nullptr, "", shortDigest.c_str(), notHex.c_str()};
+  for (const char* digest : digests) {
+    MemorySink sink;
+    OtaStream stream(sink);
+    check(stream.begin(IMAGE_SIZE, digest) == OTA_STREAM_BAD_DIGEST_ARG, test, "begin refuses it");
+    check(!sink.begun, test, "sink never begun");
+    check(stream.write((const uint8_t*)"x", 1) == OTA_STREAM_IDLE, test, "write after refusal");
+    check(stream.end() == OTA_STREAM_IDLE, test, "end after refusal");
+  }
+}
+
+static Bytes zlibStream(const Bytes& data, int windowBits) {
+  z_stream stream = z_stream();
+  deflateInit2(&stream, 9, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+  Bytes out(deflateBound(&stream, data.size()));
+  stream.next_in = const_cast<uint8_t*>(data.data());
+  stream.avail_in = data.size();
+  stream.next_out = out.data();
+  stream.avail_out = out.size();
+  deflate(&stream, Z_FINISH);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  return out;
+}
+
+static void putLE32(Bytes& out, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out.push_back((uint8_t)(value >> (i * 8)));
+  }
+}
+
+static void putOp(Bytes& out, uint8_t op, uint32_t a, uint32_t b) {
+  out.push_back(op);
+  putLE32(out, a);
+  putLE32(out, b);
+}
+
+// The first 60000 bytes of the image are the base's plus 7; the rest is
+// new. With tail false the patch stops after the diff.
+const size_t BASE_SIZE = 60000;
+
+static Bytes testBase(const Bytes& image) {
+  Bytes base(image.begin(), image.begin() + BASE_SIZE);
+  for (uint8_t& byte : base) {
+    byte -= 7;
+  }
+  return base;
+}
+
+static Bytes testPatch(const Bytes& image, uint32_t targetSize, bool tail) {
+  Bytes patch = {'W', 'P', 'D', '1'};
+  putLE32(patch, targetSize);
+  putLE32(patch, BASE_SIZE);
+  putOp(patch, OTA_DELTA_DIFF, 0, BASE_SIZE);
+  patch.insert(patch.end(), BASE_SIZE, 7);
+  if (tail) {
+    putOp(patch, OTA_DELTA_DATA, 0, image.size() - BASE_SIZE);
+    patch.insert(patch.end(), image.begin() + BASE_SIZE, image.end());
+  }
+  return zlibStream(patch, OTA_WINDOW_BITS);
+}
+
+static void testDecoded(const char* test, OtaEncoding encoding, const Bytes& upload, const Bytes& image,
+                        const Bytes& base) {
+  MemorySink sink;
+  OtaStream stream(sink);
+  MemoryBase running(base);
+  OtaDecoder decoder(stream, &running);
+  check(decoder.begin(encoding, image.size(), IMAGE_SHA256) == OTA_STREAM_OK, test, "begin");
+  check(feed(decoder, upload.data(), upload.size()) == OTA_STREAM_OK, test, "write");
+  check(decoder.received() == upload.size(), test, "received() counts the wire bytes");
+  check(decoder.end() == OTA_STREAM_OK, test, "end");
+  check(sink.committed && sink.data == image, test, "flash holds the image");
+}
+
+// Every case below must fail to decode and leave nothing to boot
+static void testRefused(const char* test, OtaEncoding encoding, const Bytes& upload, size_t announced,
+                        const char* digest, const Bytes& base) {
+  MemorySink sink;
+  OtaStream stream(sink);
+  MemoryBase running(base);
+  OtaDecoder decoder(stream, &running);
+  check(decoder.begin(encoding, announced, digest) == OTA_STREAM_OK, test, "begin");
+  feed(decoder, upload.data(), upload.size());
+  check(decoder.end() == OTA_STREAM_DECODE_FAILED, test, "decode fails");
+  check(!sink.committed && sink.aborted, test, "aborted, not committed");
+}
+
+static void testWideWindow(const Bytes& image) {
+  const char* test = "zlib window too large";
+  Bytes upload = zlibStream(image, 15);
+  MemorySink sink;
+  OtaStream stream(sink);
+  OtaDecoder decoder(stream, nullptr);
+  check(decoder.begin(OTA_ENCODING_ZLIB, image.size(), IMAGE_SHA256) == OTA_STREAM_OK, test, "begin");
+  check(decoder.write(upload.data(), 1) == OTA_STREAM_DECODE_FAILED, test, "refused on the header's first byte");
+  check(sink.data.empty() && sink.aborted, test, "nothing written");
+}
+
+static void testDecoder(const Bytes& image) {
+  Bytes base = testBase(image);
+  Bytes none;
+  Bytes zlib = zlibStream(image, OTA_WINDOW_BITS);
+
+  testDecoded("raw upload", OTA_ENCODING_RAW, image, image, none);
+  testDecoded("zlib upload", OTA_ENCODING_ZLIB, zlib, image, none);
+  testDecoded("delta upload", OTA_ENCODING_DELTA, testPatch(image, image.size(), true), image, base);
+  testWideWindow(image);
+
+  Bytes cut(zlib.begin(), zlib.begin() + zlib.size() / 2);
+  testRefused("zlib stream cut off", OTA_ENCODING_ZLIB, cut, image.size(), IMAGE_SHA256, none);
+  // The digest matches what the patch makes, so only the size can catch it
+  testRefused("delta short of its target size", OTA_ENCODING_DELTA, testPatch(image, image.size(), false), 0,
+              HEAD_SHA256, base);
+  testRefused("delta past its target size", OTA_ENCODING_DELTA, testPatch(image, BASE_SIZE, true), 0,
+              IMAGE_SHA256, base);
+  testRefused("delta target size not the upload's", OTA_ENCODING_DELTA, testPatch(image, image.size(), true),
+              image.size() - 1, IMAGE_SHA256, base);
+}
+
+static int idleCalls = 0;
+static void countIdle() { idleCalls++; }
+
+static void testUnknownEncoding(const Bytes& image) {
+  const char* test = "unknown encoding";
+  MemorySink sink;
+  OtaStream stream(sink);
+  OtaDecoder decoder(stream, nullptr);
+  idleCalls = 0;
+  OtaHttpUpload upload(decoder, countIdle);
+  check(upload.status() == OTA_STREAM_IDLE, test, "done without a start reports no update");
+
+  // A good upload first, so there's an old outcome to leak
+  upload.start("raw", image.size(), IMAGE_SHA256, 0);
+  upload.write(image.data(), image.size());
+  upload.end();
+  check(upload.status() == OTA_STREAM_OK, test, "the good upload before it");
+  upload.stop();
+  check(idleCalls == 1 && upload.status() == OTA_STREAM_IDLE, test, "stop() lets go of the screen");
+
+  sink.committed = false;
+  upload.start("gzip", image.size(), IMAGE_SHA256, 0);
+  check(upload.inProgress(), test, "holds the screen until answered");
+  check(upload.status() == OTA_STREAM_BAD_ENCODING, test, "rejected at the start");
+  check(!upload.write(image.data(), image.size()), test, "data ignored");
+  upload.end();
+  check(upload.status() == OTA_STREAM_BAD_ENCODING, test, "done handler reports the encoding");
+  check(sink.data == image && !sink.committed, test, "nothing more written or committed");
+  upload.stop();
+  check(idleCalls == 2 && !upload.inProgress(), test, "screen given back");
+}
+
+// The sketch's screen around an upload (Hungry.cpp): the progress bar while
+// the upload holds it, the face once it lets go
+typedef EyeEngine<EyeFeatures, EyeSsd1306I2c> TestEyes;
+static TestEyes* uploadEyes = nullptr;
+static void redrawEyes() { uploadEyes->invalidate(); }
+
+static Bytes screen(const U8G2& display) {
+  Bytes pixels;
+  for (int y = 0; y < EyeSsd1306I2c::height; y++) {
+    for (int x = 0; x < EyeSsd1306I2c::width; x++) {
+      pixels.push_back(display.pixel(x, y));
+    }
+  }
+  return pixels;
+}
+
+static void testAbortedUpload(const Bytes& image) {
+  const char* test = "aborted upload";
+  hostSetMillis(10000);
+  EyeSsd1306I2c::Panel display(U8G2_R0);
+  MillisClock clock;
+  TestEyes eyes(display, clock);
+  display.begin();
+  eyes.begin(20240601);
+  eyes.frame();
+  uploadEyes = &eyes;
+
+  MemorySink sink;
+  OtaStream stream(sink);
+  OtaDecoder decoder(stream, nullptr);
+  OtaHttpUpload upload(decoder, redrawEyes);
+  upload.start("raw", image.size(), IMAGE_SHA256, millis());
+  check(upload.write(image.data(), image.size() / 2), test, "first half written");
+  eyeProgressScreen(display, (upload.written() * 100) / upload.size());
+  Bytes progress = screen(display);
+
+  // The client goes away: UPLOAD_FILE_ABORTED, and no done handler
+  upload.abort();
+  check(!upload.inProgress(), test, "lets go of the screen");
+  check(sink.aborted && !sink.committed, test, "aborted, not committed");
+  check(upload.status() == OTA_STREAM_IDLE, test, "nothing left to report");
+
+  // The sketch's loop draws the face whenever no upload holds the screen
+  hostAdvanceMillis(40);
+  check(eyes.frame(), test, "the face is drawn again");
+  check(screen(display) != progress, test, "progress bar gone");
+  uploadEyes = nullptr;
+}
+
+int main() {
+  Bytes image = testImage();
+  testDigestReference();
+  testGood(image, image.size());
+  testGood(image, 0);
+  testTruncated(image, image.size());
+  testTruncated(image, 0);
+  testWrongDigest(image);
+  testMalformedDigest();
+  testDecoder(image);
+  testUnknownEncoding(image);
+  testAbortedUpload(image);
+
+  if (failed == 0) {
+    printf("all OTA upload checks passed\n");
+    return 0;
+  }
+  printf("%d OTA upload checks failed\n", failed);
+  return 1;
+}
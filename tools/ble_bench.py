@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Measure BLE bulk throughput to and from the wearable.
+
+    pip install bleak
+    python3 tools/ble_bench.py --name ESP32-Wearable --bytes 200000
+
+Runs a device -> host run (notifications from the bulk TX characteristic)
+and a host -> device run (write-without-response on bulk RX, paced by the
+device's credit grants) and prints KB/s for each. The protocol is
+described in src/ble_bulk.h.
+"""
+
+import argparse
+import asyncio
+import struct
+import sys
+import time
+
+try:
+    from bleak import BleakClient, BleakScanner
+except ImportError:
+    sys.exit("ble_bench.py needs bleak: pip install bleak")
+
+BULK_RX = "beb54840-36e1-4688-b7f5-ea07361b26a8"
+BULK_TX = "beb54841-36e1-4688-b7f5-ea07361b26a8"
+BULK_CTRL = "beb54842-36e1-4688-b7f5-ea07361b26a8"
+
+CTRL_TX_BENCH = 0x01
+CTRL_RX_BENCH = 0x02
+CTRL_RX_REPORT = 0x03
+EVT_CREDITS = 0x80
+EVT_TX_DONE = 0x81
+EVT_RX_REPORT = 0x82
+
+
+class BulkLink:
+    def __init__(self, client):
+        self.client = client
+        self.credits = 0
+        self.credit_event = asyncio.Event()
+        self.events = asyncio.Queue()
+        self.received = 0
+        self.first_rx = None
+        self.last_rx = None
+
+    def on_ctrl(self, _, data):
+        if data[0] == EVT_CREDITS:
+            self.credits += struct.unpack_from("<H", data, 1)[0]
+            self.credit_event.set()
+        else:
+            self.events.put_nowait(bytes(data))
+
+    def on_tx(self, _, data):
+        now = time.perf_counter()
+        if self.first_rx is None:
+            self.first_rx = now
+        self.last_rx = now
+        self.received += len(data)
+
+    async def start(self):
+        await self.client.start_notify(BULK_CTRL, self.on_ctrl)
+        await self.client.start_notify(BULK_TX, self.on_tx)
+
+    async def device_to_host(self, total):
+        self.received = 0
+        self.first_rx = None
+        await self.client.write_gatt_char(BULK_CTRL, struct.pack("<BI", CTRL_TX_BENCH, total), response=True)
+        while True:
+            event = await self.events.get()
+            if event[0] == EVT_TX_DONE:
+                _, sent, device_ms = struct.unpack("<BII", event)
+                break
+        await asyncio.sleep(0.2)  # let the last notifications land
+        host_s = (self.last_rx - self.first_rx) if self.first_rx else 0
+        return sent, self.received, device_ms / 1000.0, host_s
+
+    async def host_to_device(self, total):
+        await self.client.write_gatt_char(BULK_CTRL, bytes([CTRL_RX_BENCH]), response=True)
+        chunk = self.client.mtu_size - 3
+        payload = bytes(i & 0xFF for i in range(chunk))
+        sent = 0
+        start = time.perf_counter()
+        while sent < total:
+            while self.credits == 0:
+                self.credit_event.clear()
+                await self.credit_event.wait()
+            n = min(chunk, total - sent)
+            await self.client.write_gatt_char(BULK_RX, payload[:n], response=False)
+            self.credits -= 1
+            sent += n
+        host_s = time.perf_counter() - start
+        await self.client.write_gatt_char(BULK_CTRL, bytes([CTRL_RX_REPORT]), response=True)
+        while True:
+            event = await self.events.get()
+            if event[0] == EVT_RX_REPORT:
+                _, received, device_ms = struct.unpack("<BII", event)
+                return sent, received, device_ms / 1000.0, host_s
+
+
+def kbps(count, seconds):
+    return count / 1024 / seconds if seconds > 0 else float("nan")
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--name", default="ESP32-Wearable", help="advertised device name")
+    parser.add_argument("--bytes", type=int, default=100000, help="bytes per direction")
+    args = parser.parse_args()
+
+    device = await BleakScanner.find_device_by_name(args.name, timeout=10)
+    if device is None:
+        sys.exit(f"{args.name} not found")
+
+    async with BleakClient(device) as client:
+        link = BulkLink(client)
+        await link.start()
+        print(f"MTU {client.mtu_size}")
+
+        sent, received, device_s, host_s = await link.device_to_host(args.bytes)
+        print(f"device -> host: {received}/{sent} bytes, {kbps(received, host_s):.1f} KB/s "
+              f"(device reports {kbps(sent, device_s):.1f} KB/s)")
+
+        sent, received, device_s, host_s = await link.host_to_device(args.bytes)
+        print(f"host -> device: {received}/{sent} bytes, {kbps(sent, host_s):.1f} KB/s "
+              f"(device reports {kbps(received, device_s):.1f} KB/s)")
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Update the wearable's firmware over BLE.
+
+    pip install bleak
+    python3 tools/ble_ota.py firmware.bin --name ESP32-Wearable
+
+Streams the image in MTU-sized, sequence-numbered chunks with a sliding
+window (protocol in src/ble_ota.h). If the connection drops, it reconnects
+and resumes from the offset the device reports instead of starting over.
+"""
+
+import argparse
+import asyncio
+import hashlib
+import struct
+import sys
+import time
+
+try:
+    from bleak import BleakClient, BleakScanner
+    from bleak.exc import BleakError
+except ImportError:
+    sys.exit("ble_ota.py needs bleak: pip install bleak")
+
+OTA_CTRL = "beb54850-36e1-4688-b7f5-ea07361b26a8"
+OTA_DATA = "beb54851-36e1-4688-b7f5-ea07361b26a8"
+
+BEGIN, END, ABORT = 0x01, 0x02, 0x03
+EVT_READY, EVT_ACK, EVT_NAK, EVT_DONE = 0x81, 0x82, 0x83, 0x84
+WINDOW = 8          # BLE_OTA_WINDOW
+MAX_CHUNK = 512     # BLE_OTA_MAX_CHUNK
+STATUS = ["OK", "No update in progress", "Missing or malformed sha256", "Begin Failed",
+          "Write Failed", "Digest mismatch", "End Failed", "Decode Failed"]
+
+
+class Transfer:
+    def __init__(self, image):
+        self.image = image
+        self.digest = hashlib.sha256(image).digest()
+        self.acked_offset = 0
+        self.events = asyncio.Queue()
+
+    def on_ctrl(self, _, data):
+        data = bytes(data)
+        if data[0] in (EVT_ACK, EVT_NAK):
+            seq, offset = struct.unpack_from("<HI", data, 1)
+            self.events.put_nowait((data[0], seq, offset))
+        elif data[0] == EVT_READY:
+            status, seq, offset = struct.unpack_from("<BHI", data, 1)
+            self.events.put_nowait((EVT_READY, status, seq, offset))
+        elif data[0] == EVT_DONE:
+            self.events.put_nowait((EVT_DONE, data[1]))
+
+    async def run(self, client):
+        chunk = min(MAX_CHUNK, client.mtu_size - 5)
+        await client.start_notify(OTA_CTRL, self.on_ctrl)
+        await client.write_gatt_char(OTA_CTRL, struct.pack("<BI", BEGIN, len(self.image)) + self.digest,
+                                     response=True)
+        event = await asyncio.wait_for(self.events.get(), 10)
+        if event[0] != EVT_READY or event[1] != 0:
+            raise RuntimeError(f"device refused update: {STATUS[event[1]]}")
+        seq, offset = event[2], event[3]
+        if offset:
+            print(f"resuming at {offset} bytes")
+
+        # Sliding window; on NAK rewind to the position the device asks for
+        in_flight = 0
+        send_seq, send_offset = seq, offset
+        while self.acked_offset < len(self.image):
+            while in_flight < WINDOW and send_offset < len(self.image):
+                data = self.image[send_offset:send_offset + chunk]
+                await client.write_gatt_char(OTA_DATA, struct.pack("<H", send_seq & 0xFFFF) + data,
+                                             response=False)
+                send_seq += 1
+                send_offset += len(data)
+                in_flight += 1
+            kind, ack_seq, ack_offset = await asyncio.wait_for(self.events.get(), 10)
+            # Sequence numbers are 16 bit on the wire; rebuild the full count
+            full_seq = send_seq - ((send_seq - ack_seq) & 0xFFFF)
+            if kind == EVT_NAK:
+                send_seq, send_offset, in_flight = full_seq, ack_offset, 0
+            else:
+                in_flight = send_seq - full_seq
+            self.acked_offset = ack_offset
+            print(f"\r{ack_offset * 100 // len(self.image):3d}%", end="", flush=True)
+        print()
+
+        await client.write_gatt_char(OTA_CTRL, bytes([END]), response=True)
+        event = await asyncio.wait_for(self.events.get(), 30)
+        if event[0] != EVT_DONE or event[1] != 0:
+            raise RuntimeError(f"device rejected image: {STATUS[event[1]]}")
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("image", help="firmware .bin")
+    parser.add_argument("--name", default="ESP32-Wearable", help="advertised device name")
+    parser.add_argument("--retries", type=int, default=10, help="reconnect attempts")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        transfer = Transfer(f.read())
+
+    start = time.time()
+    for attempt in range(args.retries + 1):
+        device = await BleakScanner.find_device_by_name(args.name, timeout=10)
+        if device is None:
+            print(f"{args.name} not found, retrying")
+            continue
+        try:
+            async with BleakClient(device) as client:
+                await transfer.run(client)
+            elapsed = time.time() - start
+            print(f"done: {len(transfer.image)} bytes in {elapsed:.1f}s "
+                  f"({len(transfer.image) / 1024 / elapsed:.1f} KB/s), device rebooting")
+            return
+        except (BleakError, asyncio.TimeoutError, EOFError) as e:
+            print(f"\nlink lost at {transfer.acked_offset} bytes ({e}), reconnecting")
+            transfer.events = asyncio.Queue()
+    sys.exit("giving up")
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
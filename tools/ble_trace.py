@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Download the pet's behaviour trace over BLE, for when there's no WiFi.
+
+    pip install bleak
+    python3 tools/ble_trace.py pet.trace --name ESP32-Wearable
+    ./build/trace_replay pet.trace
+
+Writes "trace" on the bulk RX characteristic and saves what comes back on
+bulk TX: the same bytes as the /trace route (a TraceHeader, then the
+records oldest first; see src/event_trace.h and Hungry.cpp). The transport
+is described in src/ble_bulk.h.
+"""
+
+import argparse
+import asyncio
+import struct
+import sys
+
+try:
+    from bleak import BleakClient, BleakScanner
+except ImportError:
+    sys.exit("ble_trace.py needs bleak: pip install bleak")
+
+from ble_bench import BULK_RX, BulkLink
+
+HEADER = struct.Struct("<4sHHII")  # magic, version, recordSize, count, total
+IDLE_S = 3.0  # give up when nothing has arrived for this long
+
+
+async def download(client):
+    link = BulkLink(client)
+    data = bytearray()
+    arrived = asyncio.Event()
+
+    def on_tx(_, chunk):
+        data.extend(chunk)
+        arrived.set()
+
+    link.on_tx = on_tx
+    await link.start()
+    # Bulk RX is credit-based: wait for the first grant before writing
+    await asyncio.wait_for(link.credit_event.wait(), IDLE_S)
+    await client.write_gatt_char(BULK_RX, b"trace\n", response=False)
+
+    size = None
+    while size is None or len(data) < size:
+        arrived.clear()
+        try:
+            await asyncio.wait_for(arrived.wait(), IDLE_S)
+        except asyncio.TimeoutError:
+            break
+        if size is None and len(data) >= HEADER.size:
+            magic, _, record_size, count, _ = HEADER.unpack_from(data)
+            if magic != b"PTR1":
+                sys.exit(f"not a trace (magic {magic!r})")
+            size = HEADER.size + count * record_size
+    return bytes(data), size
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("output", help="file to write the trace to")
+    parser.add_argument("--name", default="ESP32-Wearable", help="advertised device name")
+    args = parser.parse_args()
+
+    device = await BleakScanner.find_device_by_name(args.name, timeout=10)
+    if device is None:
+        sys.exit(f"{args.name} not found")
+
+    async with BleakClient(device) as client:
+        data, size = await download(client)
+
+    if size is None:
+        sys.exit("no trace received")
+    if len(data) < size:
+        # Records were overwritten before they went out: keep the whole ones
+        _, version, record_size, _, total = HEADER.unpack_from(data)
+        count = (len(data) - HEADER.size) // record_size
+        print(f"trace cut short: {count} records of {(size - HEADER.size) // record_size}")
+        data = HEADER.pack(b"PTR1", version, record_size, count, total) + data[HEADER.size:HEADER.size + count * record_size]
+    with open(args.output, "wb") as f:
+        f.write(data[:size])
+    print(f"{len(data[:size])} bytes to {args.output}")
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
@@ -0,0 +1,250 @@
+#!/usr/bin/env python3
+"""Turn eye artwork into compressed 1bpp bitmaps for the firmware.
+
+    python3 tools/eye_assets.py art/eyes/*.pbm -o src/eye_artwork.h
+    python3 tools/eye_assets.py art/eyes/*.svg -o src/eye_artwork.h --threshold 100
+
+Each image is scaled to the display (--size, default 128x64), thresholded
+to 1bpp (light pixels are lit, transparent ones dark), laid out like the
+U8g2 frame buffer and compressed with whichever encoding of src/eye_bitmap.h
+comes out smallest. The header gets one constexpr EyeBitmap per image, named
+after the file, and an EYE_ARTWORK table indexed by EyeState for the files
+named after an expression (neutral.svg, angry.png, ...). Every bitmap is
+decoded again and checked against the image before the header is written.
+
+PBM (P1 or P4, 1 = dark, so the OLED look is white on black) is read
+directly. PNG needs Pillow and SVG needs cairosvg as well:
+    pip install pillow cairosvg
+"""
+
+import argparse
+import io
+import os
+import re
+import sys
+
+# Same order as EyeState in src/eye_state.h
+STATE_NAMES = ["neutral", "angry", "surprised", "sad", "suspicious", "left",
+               "right", "up", "down", "sleepy", "happy"]
+
+RAW, TILES, RLE = 0, 1, 2
+ENCODING_NAMES = {RAW: "EYE_BITMAP_RAW", TILES: "EYE_BITMAP_TILES", RLE: "EYE_BITMAP_RLE"}
+
+
+def read_pbm(path):
+    """Returns (width, height, rows of 0/1 with 1 = lit)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        match = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)").match(data, pos)
+        if not match:
+            sys.exit("%s: truncated PBM header" % path)
+        tokens.append(match.group(2))
+        pos = match.end()
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    if magic == b"P4":
+        pos += 1  # single whitespace before the raster
+        stride = (width + 7) // 8
+        raster = data[pos:pos + stride * height]
+        if len(raster) < stride * height:
+            sys.exit("%s: truncated PBM raster" % path)
+        return width, height, [[0 if raster[y * stride + x // 8] & (0x80 >> (x % 8)) else 1
+                                for x in range(width)] for y in range(height)]
+    if magic == b"P1":
+        bits = [b for b in data[pos:] if b in b"01"]
+        if len(bits) < width * height:
+            sys.exit("%s: truncated PBM raster" % path)
+        return width, height, [[0 if bits[y * width + x] == ord("1") else 1
+                                for x in range(width)] for y in range(height)]
+    sys.exit("%s: not a PBM file" % path)
+
+
+def read_image(path, width, height, threshold):
+    if path.lower().endswith(".pbm"):
+        w, h, rows = read_pbm(path)
+        if (w, h) != (width, height):
+            sys.exit("%s is %dx%d, expected %dx%d" % (path, w, h, width, height))
+        return rows
+
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("eye_assets.py needs Pillow for %s: pip install pillow" % path)
+    if path.lower().endswith(".svg"):
+        try:
+            import cairosvg
+        except ImportError:
+            sys.exit("eye_assets.py needs cairosvg for %s: pip install cairosvg" % path)
+        png = cairosvg.svg2png(url=path, output_width=width, output_height=height)
+        image = Image.open(io.BytesIO(png))
+    else:
+        image = Image.open(path)
+
+    # Flatten onto black, so transparent areas stay dark
+    image = image.convert("RGBA").resize((width, height), Image.LANCZOS)
+    background = Image.new("RGBA", image.size, (0, 0, 0, 255))
+    gray = Image.alpha_composite(background, image).convert("L")
+    pixels = gray.load()
+    return [[1 if pixels[x, y] >= threshold else 0 for x in range(width)] for y in range(height)]
+
+
+def to_pages(rows, width, height):
+    """The U8g2 buffer: page by page, a byte per column, top row in bit 0."""
+    out = bytearray()
+    for page in range(height // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                if rows[page * 8 + bit][x]:
+                    byte |= 1 << bit
+            out.append(byte)
+    return bytes(out)
+
+
+def encode_tiles(buf, width, height):
+    tile_width = width // 8
+    tiles = tile_width * (height // 8)
+    mask = bytearray((tiles + 7) // 8)
+    body = bytearray()
+    for i in range(tiles):
+        start = (i // tile_width) * width + (i % tile_width) * 8
+        tile = buf[start:start + 8]
+        if any(tile):
+            mask[i // 8] |= 1 << (i % 8)
+            body += tile
+    return bytes(mask + body)
+
+
+def encode_rle(buf):
+    out = bytearray()
+    literal = bytearray()
+
+    def flush():
+        while literal:
+            chunk = literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literal[:128]
+
+    i = 0
+    while i < len(buf):
+        run = 1
+        while i + run < len(buf) and buf[i + run] == buf[i] and run < 128:
+            run += 1
+        if run >= 3:
+            flush()
+            out.append(0x7f + run)
+            out.append(buf[i])
+            i += run
+        else:
+            literal.extend(buf[i:i + run])
+            i += run
+    flush()
+    return bytes(out)
+
+
+def decode(encoding, data, width, height):
+    length = width * height // 8
+    if encoding == RAW:
+        return bytes(data)
+    out = bytearray(length)
+    if encoding == TILES:
+        tile_width = width // 8
+        tiles = tile_width * (height // 8)
+        pos = (tiles + 7) // 8
+        for i in range(tiles):
+            if data[i // 8] & (1 << (i % 8)):
+                start = (i // tile_width) * width + (i % tile_width) * 8
+                out[start:start + 8] = data[pos:pos + 8]
+                pos += 8
+        return bytes(out)
+    pos = 0
+    i = 0
+    while i < len(data):
+        control = data[i]
+        if control < 0x80:
+            out[pos:pos + control + 1] = data[i + 1:i + 2 + control]
+            pos += control + 1
+            i += control + 2
+        else:
+            out[pos:pos + control - 0x7f] = bytes([data[i + 1]]) * (control - 0x7f)
+            pos += control - 0x7f
+            i += 2
+    return bytes(out)
+
+
+def identifier(path):
+    stem = os.path.splitext(os.path.basename(path))[0]
+    return re.sub(r"[^A-Za-z0-9]", "_", stem).upper()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("images", nargs="+", help="SVG, PNG or PBM artwork")
+    parser.add_argument("-o", "--output", required=True, help="header to write")
+    parser.add_argument("--size", default="128x64", help="display size, WxH")
+    parser.add_argument("--threshold", type=int, default=128, help="grey level that lights a pixel")
+    parser.add_argument("--encoding", choices=["auto", "raw", "tiles", "rle"], default="auto")
+    args = parser.parse_args()
+
+    width, height = (int(v) for v in args.size.split("x"))
+    if width % 8 or height % 8 or width > 255 or height > 255:
+        sys.exit("--size must be multiples of 8, at most 255")
+
+    bitmaps = []
+    for path in args.images:
+        buf = to_pages(read_image(path, width, height, args.threshold), width, height)
+        candidates = {RAW: buf, TILES: encode_tiles(buf, width, height), RLE: encode_rle(buf)}
+        if args.encoding != "auto":
+            encoding = {"raw": RAW, "tiles": TILES, "rle": RLE}[args.encoding]
+        else:
+            encoding = min(candidates, key=lambda e: len(candidates[e]))
+        data = candidates[encoding]
+        if decode(encoding, data, width, height) != buf:
+            sys.exit("%s: %s doesn't decode back to the image" % (path, ENCODING_NAMES[encoding]))
+        bitmaps.append((path, identifier(path), encoding, data))
+
+    lines = [
+        "#pragma once",
+        "",
+        "// Generated by tools/eye_assets.py from:",
+    ]
+    lines += ["//   %s" % os.path.relpath(path) for path, _, _, _ in bitmaps]
+    lines += [
+        "// Edit the artwork and rerun the tool rather than editing this file.",
+        "",
+        '#include "eye_bitmap.h"',
+        '#include "eye_state.h"',
+        "",
+    ]
+    for path, name, encoding, data in bitmaps:
+        lines.append("constexpr uint8_t EYE_ART_%s_DATA[] = {" % name)
+        for i in range(0, len(data), 16):
+            lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("constexpr EyeBitmap EYE_ART_%s = {%d, %d, %s, sizeof(EYE_ART_%s_DATA), EYE_ART_%s_DATA};"
+                     % (name, width, height, ENCODING_NAMES[encoding], name, name))
+        lines.append("")
+
+    by_name = {name: name for _, name, _, _ in bitmaps}
+    lines.append("// Artwork for each EyeState, nullptr where there is none")
+    lines.append("constexpr const EyeBitmap* EYE_ARTWORK[STATE_COUNT] = {")
+    for state in STATE_NAMES:
+        name = state.upper()
+        lines.append("  %s," % ("&EYE_ART_" + name if name in by_name else "nullptr"))
+    lines.append("};")
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+    total = 0
+    for path, name, encoding, data in bitmaps:
+        total += len(data)
+        print("%-24s %-6s %5d bytes" % (name, ENCODING_NAMES[encoding][11:].lower(), len(data)))
+    print("%-24s %-6s %5d bytes (%d raw)" % ("total", "", total, len(bitmaps) * width * height // 8))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,557 @@
+// Microbenchmarks for the eye engine on the host, against the mock Arduino
+// and U8g2 layer in host/: the ellipse filler and the artwork blit per
+// expression, clip decoding, whole frames on each display backend, full
+// buffer against page buffer, one panel per eye against one for both,
+// behaviour updates through transitions, the gaze spring, the decorative
+// effects against libm and web handler dispatch.
+//
+//   cmake -S . -B build && cmake --build build --target eye_bench
+//   ./build/eye_bench                                    # everything
+//   ./build/eye_bench --benchmark_filter=DrawEyes        # regex on the names
+//   ./build/eye_bench --benchmark_out=main.json --label=$(git rev-parse --short HEAD)
+//
+// Works like Google Benchmark and writes the same JSON (to eye_bench.json
+// unless --benchmark_out says otherwise), so two runs can be compared with
+// its tools/compare.py. Each benchmark's iteration count grows until a run
+// takes --benchmark_min_time seconds (default 0.2); the time reported is
+// per iteration. Benchmarks can add counters, which are printed after the
+// iteration count and written to the JSON as Google Benchmark does.
+//
+// Host numbers don't say how fast the ESP32 is, only whether a change made
+// the code faster or slower; compare runs from the same machine.
+
+#include "eye_artwork.h"
+#include "eye_clips.h"
+#include "eye_engine.h"
+#include "eye_web.h"
+#include "pet_clock.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char* const STATE_NAMES[STATE_COUNT] = {
+  "neutral", "angry", "surprised", "sad", "suspicious", "left",
+  "right", "up", "down", "sleepy", "happy"
+};
+
+const uint32_t FRAME_MS = 40;
+
+// Keep the compiler from dropping a result or hoisting work out of the loop
+template <typename T>
+inline void doNotOptimize(T const& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs the body of a benchmark `iterations` times: for (auto _ : state) {...}
+class BenchState {
+public:
+  explicit BenchState(uint64_t iterations) : _iterations(iterations) {}
+
+  // What the loop variable holds: a type marked unused, so `_` never
+  // warns, as with Google Benchmark's own State
+  struct [[maybe_unused]] Value {};
+
+  struct Iterator {
+    BenchState* state;
+    uint64_t left;
+    bool operator!=(const Iterator&) {
+      if (left > 0) {
+        return true;
+      }
+      state->stop();
+      return false;
+    }
+    void operator++() { left--; }
+    Value operator*() const { return {}; }
+  };
+
+  Iterator begin() {
+    _cpuStart = std::clock();
+    _start = std::chrono::steady_clock::now();
+    return Iterator{this, _iterations};
+  }
+  Iterator end() { return Iterator{this, 0}; }
+
+  uint64_t iterations() const { return _iterations; }
+  double seconds() const { return _seconds; }
+  double cpuSeconds() const { return _cpuSeconds; }
+
+  std::map<std::string, double> counters;
+
+private:
+  void stop() {
+    _seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+    _cpuSeconds = (double)(std::clock() - _cpuStart) / CLOCKS_PER_SEC;
+  }
+
+  uint64_t _iterations;
+  std::chrono::steady_clock::time_point _start;
+  std::clock_t _cpuStart = 0;
+  double _seconds = 0;
+  double _cpuSeconds = 0;
+};
+
+struct Benchmark {
+  std::string name;
+  std::function<void(BenchState&)> run;
+};
+
+static std::vector<Benchmark>& benchmarks() {
+  static std::vector<Benchmark> list;
+  return list;
+}
+
+static void add(const std::string& name, std::function<void(BenchState&)> run) {
+  benchmarks().push_back(Benchmark{name, run});
+}
+
+// Everything the sketches can draw; the trace would only add its ring
+struct BenchEyes : EyeFeatures {
+  static constexpr bool readingLight = true;
+  static constexpr bool hunger = true;
+  static constexpr bool stars = true;
+  static constexpr bool web = true;
+};
+
+// A display and an engine showing `state` at rest, eyes open
+template <typename Display>
+struct PanelRig {
+  typename Display::Panel display;
+  MillisClock clock;
+  EyeEngine<BenchEyes, Display> eyes;
+
+  explicit PanelRig(EyeState state = STATE_NEUTRAL) : display(U8G2_R0, 0, 0, 0), eyes(display, clock) {
+    hostSetMillis(0);
+    display.begin();
+    eyes.begin(1);
+    eyes.pet().restore(state, true, false, false);
+  }
+
+  void step() {
+    hostAdvanceMillis(FRAME_MS);
+    eyes.pet().update(false, STATE_NEUTRAL);
+  }
+};
+
+typedef PanelRig<EyeSsd1306I2c> Rig;
+
+// Every frame drawn, through transitions and the happy stars, on one
+// backend. What the host measures is the drawing, scaled to the panel;
+// sending the frame is the modelled bus time in the counters.
+template <typename Display>
+static void addBackend(const char* name) {
+  add(std::string("BM_Backend/") + name, [](BenchState& state) {
+    PanelRig<Display> rig;
+    int next = STATE_ANGRY;
+    for (auto _ : state) {
+      if (!rig.eyes.pet().transitioning()) {
+        rig.eyes.pet().setEmotion(next);
+        next = next % (STATE_COUNT - 1) + 1;
+      }
+      rig.step();
+      rig.eyes.draw();
+    }
+    doNotOptimize(rig.display.frames());
+    state.counters["bus_us"] = Display::frameMicros;
+    state.counters["max_fps"] = 1e6 / Display::frameMicros;
+  });
+}
+
+// The same frames into a full buffer, and a page at a time through the
+// display list: RAM for the buffer and the list, against the time to draw.
+// pages_drawn is how many of the eight had anything on them, on average.
+template <typename Display>
+static void addPageRender(const char* name) {
+  add(std::string("BM_PageRender/") + name, [](BenchState& state) {
+    PanelRig<Display> rig;
+    int next = STATE_ANGRY;
+    double frames = 0;
+    double pages = 0;
+    for (auto _ : state) {
+      if (!rig.eyes.pet().transitioning()) {
+        rig.eyes.pet().setEmotion(next);
+        next = next % (STATE_COUNT - 1) + 1;
+      }
+      rig.step();
+      rig.eyes.draw();
+      frames++;
+      pages += rig.eyes.pagesDrawn();
+    }
+    doNotOptimize(rig.display.frames());
+    state.counters["buffer_bytes"] = Display::bufferBytes;
+    state.counters["ram_bytes"] = Display::bufferBytes + sizeof(EyeScene);
+    state.counters["pages_drawn"] = Display::paged ? pages / frames : Display::height / 8;
+  });
+}
+
+static void registerAll() {
+  // Both eyes of an expression, into the buffer
+  for (int s = 0; s < STATE_COUNT; s++) {
+    add(std::string("BM_FillEllipse/") + STATE_NAMES[s], [s](BenchState& state) {
+      U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0);
+      EyeShape left, right;
+      PetBehavior::shapesFor((EyeState)s, left, right);
+      for (auto _ : state) {
+        eyeFillEllipse(display, 39 + left.offsetX, 32 + left.offsetY, left.width, left.height, left.angle);
+        eyeFillEllipse(display, 89 + right.offsetX, 32 + right.offsetY, right.width, right.height, right.angle);
+        doNotOptimize(display.getBufferPtr()[0]);
+      }
+    });
+  }
+
+  // Whole frames: clear, eyes (and stars when happy), send
+  for (int s = 0; s < STATE_COUNT; s++) {
+    add(std::string("BM_DrawEyes/") + STATE_NAMES[s], [s](BenchState& state) {
+      Rig rig((EyeState)s);
+      for (auto _ : state) {
+        rig.eyes.draw();
+      }
+      doNotOptimize(rig.display.frames());
+    });
+  }
+
+  // Resting expressions from src/eye_artwork.h instead
+  for (int s = 0; s < STATE_COUNT; s++) {
+    if (!EYE_ARTWORK[s]) {
+      continue;
+    }
+    add(std::string("BM_BlitArtwork/") + STATE_NAMES[s], [s](BenchState& state) {
+      U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0);
+      for (auto _ : state) {
+        eyeBlitBitmap(display, *EYE_ARTWORK[s]);
+        doNotOptimize(display.getBufferPtr()[0]);
+      }
+    });
+  }
+
+  // One clip frame into the buffer, key or delta as they come, looping
+  for (int c = 0; c < EYE_CLIP_COUNT; c++) {
+    add(std::string("BM_ClipDecode/") + EYE_CLIPS[c].name, [c](BenchState& state) {
+      U8G2_SSD1306_128X64_NONAME_F_HW_I2C display(U8G2_R0);
+      MemoryClipSource source(EYE_CLIPS[c]);
+      ClipPlayer player;
+      uint32_t now = 0;
+      player.start(source, display, now);
+      for (auto _ : state) {
+        if (!player.render(display, now)) {
+          player.start(source, display, now);
+          player.render(display, now);
+        }
+        now += player.periodMs();
+      }
+      doNotOptimize(display.getBufferPtr()[0]);
+    });
+  }
+
+  add("BM_DrawEyes/reading_light", [](BenchState& state) {
+    Rig rig;
+    rig.eyes.pet().setReadingLight(true);
+    for (auto _ : state) {
+      rig.eyes.draw();
+    }
+    doNotOptimize(rig.display.frames());
+  });
+
+  // One frame's behaviour step, always mid-transition: a new expression is
+  // picked as soon as the last one lands
+  add("BM_Update/transition", [](BenchState& state) {
+    Rig rig;
+    int next = STATE_ANGRY;
+    for (auto _ : state) {
+      if (!rig.eyes.pet().transitioning()) {
+        rig.eyes.pet().setEmotion(next);
+        next = next % (STATE_COUNT - 2) + 1;
+      }
+      rig.step();
+    }
+    doNotOptimize(rig.eyes.pet().leftEye());
+  });
+
+  // Auto mode: blinks, holds and the odd expression change
+  add("BM_Update/auto", [](BenchState& state) {
+    Rig rig;
+    rig.eyes.pet().setManualMode(false);
+    for (auto _ : state) {
+      rig.step();
+    }
+    doNotOptimize(rig.eyes.pet().leftEye());
+  });
+
+  // The decorative effects for two stars: from src/eye_effects.h' tables,
+  // against the libm sin() the twinkle used to call (breathing would have
+  // been the same)
+  add("BM_Effects/twinkle_libm", [](BenchState& state) {
+    uint32_t now = 0;
+    int sum = 0;
+    for (auto _ : state) {
+      now += FRAME_MS;
+      for (int i = 0; i < 2; i++) {
+        sum += (int)(sin((float)now / 150.0 + i * 0.5) * 2.0);
+      }
+      doNotOptimize(sum);
+    }
+  });
+  add("BM_Effects/twinkle_table", [](BenchState& state) {
+    uint32_t now = 0;
+    int sum = 0;
+    for (auto _ : state) {
+      now += FRAME_MS;
+      for (int i = 0; i < 2; i++) {
+        sum += eyeTwinkle(now, i, 2);
+      }
+      doNotOptimize(sum);
+    }
+  });
+  add("BM_Effects/breath_table", [](BenchState& state) {
+    uint32_t now = 0;
+    int sum = 0;
+    for (auto _ : state) {
+      now += FRAME_MS;
+      sum += eyeBreath(now, 2);
+      doNotOptimize(sum);
+    }
+  });
+  add("BM_Effects/jitter_table", [](BenchState& state) {
+    uint32_t now = 0;
+    int32_t sum = 0;
+    for (auto _ : state) {
+      now += FRAME_MS;
+      sum += eyeJitter(now, 0, 512) + eyeJitter(now, 0x12345678, 256);
+      doNotOptimize(sum);
+    }
+  });
+
+  // One frame's gaze step (ten spring ticks per axis): following a point
+  // that jumps every half second, and idle drift and saccades
+  for (int follow = 0; follow < 2; follow++) {
+    add(follow ? "BM_Gaze/follow" : "BM_Gaze/idle", [follow](BenchState& state) {
+      EyeGaze gaze;
+      gaze.begin(1, 0);
+      uint32_t now = 0;
+      int target = 0;
+      for (auto _ : state) {
+        now += FRAME_MS;
+        if (follow && now % 500 < FRAME_MS) {
+          target = (target + 37) % 128;
+          gaze.lookAt(target, target / 2);
+        }
+        gaze.update(now);
+        doNotOptimize(gaze.x() + gaze.y());
+      }
+    });
+  }
+
+  // What loop() costs per frame: needs, update, and a draw when the face
+  // changed
+  add("BM_Frame/auto", [](BenchState& state) {
+    Rig rig;
+    rig.eyes.pet().setManualMode(false);
+    uint32_t drawn = 0;
+    for (auto _ : state) {
+      hostAdvanceMillis(FRAME_MS);
+      drawn += rig.eyes.frame();
+    }
+    doNotOptimize(drawn);
+  });
+
+  addBackend<EyeSsd1306I2c>("ssd1306_i2c");
+  addBackend<EyeSsd1306Spi>("ssd1306_spi");
+  addBackend<EyeSh1106I2c>("sh1106_i2c");
+  addBackend<EyeSh1106Spi>("sh1106_spi");
+  addBackend<EyeSh1107I2c>("sh1107_128x128_i2c");
+  addBackend<EyeSh1107Spi>("sh1107_128x128_spi");
+
+  addPageRender<EyeSsd1306I2c>("full");
+  addPageRender<EyePaged<EyeSsd1306I2c>>("paged");
+
+  // A frame drawn and sent with the bus taking real time, as long as an
+  // SSD1306 on I2C would: one panel, then one per eye sent one after the
+  // other and in parallel. Compare the real times; the CPU is mostly idle.
+  add("BM_PanelFlush/single", [](BenchState& state) {
+    Rig rig;
+    rig.display.setBusMicros(EyeSsd1306I2c::frameMicros);
+    for (auto _ : state) {
+      rig.eyes.draw();
+    }
+    doNotOptimize(rig.display.frames());
+  });
+  for (int parallel = 0; parallel < 2; parallel++) {
+    add(parallel ? "BM_PanelFlush/dual_parallel" : "BM_PanelFlush/dual_serial", [parallel](BenchState& state) {
+      EyeSsd1306I2c::Panel left(U8G2_R0);
+      EyeSsd1306I2c2::Panel right(U8G2_R0);
+      left.setBusMicros(EyeSsd1306I2c::frameMicros);
+      right.setBusMicros(EyeSsd1306I2c2::frameMicros);
+      EyeDualPanel panels(left, right);
+      MillisClock clock;
+      EyeEngine<BenchEyes, EyeSsd1306Pair> eyes(panels, clock);
+      hostSetMillis(0);
+      if (parallel) {
+        panels.begin();  // without the helper task both go out in turn
+      }
+      eyes.begin(1);
+      for (auto _ : state) {
+        eyes.draw();
+      }
+      doNotOptimize(left.frames() + right.frames());
+    });
+  }
+
+  // Web requests, from parsing the query to the handler's reply
+  struct Request {
+    const char* name;
+    const char* uri;
+    const char* query;
+  };
+  static const Request requests[] = {
+    {"emotion", "/emotion", "state=3"},
+    {"manual", "/manual", ""},
+    {"readinglight", "/readinglight", ""},
+    {"not_found", "/nothing", ""},
+  };
+  for (const Request& r : requests) {
+    add(std::string("BM_HandlerDispatch/") + r.name, [r](BenchState& state) {
+      Rig rig;
+      WebServer server(80);
+      eyeWebRoutes(server, rig.eyes);
+      int code = 0;
+      for (auto _ : state) {
+        code += server.request(HTTP_GET, r.uri, r.query);
+      }
+      doNotOptimize(code);
+    });
+  }
+}
+
+struct Result {
+  std::string name;
+  uint64_t iterations;
+  double realNs;
+  double cpuNs;
+  std::map<std::string, double> counters;
+};
+
+static std::string jsonEscape(const std::string& s) {
+  std::string out;
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out;
+}
+
+static bool writeJson(const char* path, const char* executable, const std::string& label,
+                      const std::vector<Result>& results) {
+  FILE* f = fopen(path, "w");
+  if (!f) {
+    return false;
+  }
+  char date[32];
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+#ifdef NDEBUG
+  const char* buildType = "release";
+#else
+  const char* buildType = "debug";
+#endif
+
+  fprintf(f, "{\n  \"context\": {\n");
+  fprintf(f, "    \"date\": \"%s\",\n", date);
+  fprintf(f, "    \"executable\": \"%s\",\n", jsonEscape(executable).c_str());
+  fprintf(f, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+  fprintf(f, "    \"library_build_type\": \"%s\",\n", buildType);
+  fprintf(f, "    \"label\": \"%s\"\n", jsonEscape(label).c_str());
+  fprintf(f, "  },\n  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    fprintf(f, "    {\n");
+    fprintf(f, "      \"name\": \"%s\",\n", jsonEscape(r.name).c_str());
+    fprintf(f, "      \"run_name\": \"%s\",\n", jsonEscape(r.name).c_str());
+    fprintf(f, "      \"run_type\": \"iteration\",\n");
+    fprintf(f, "      \"iterations\": %llu,\n", (unsigned long long)r.iterations);
+    fprintf(f, "      \"real_time\": %.3f,\n", r.realNs);
+    fprintf(f, "      \"cpu_time\": %.3f,\n", r.cpuNs);
+    fprintf(f, "      \"time_unit\": \"ns\"");
+    for (const auto& counter : r.counters) {
+      fprintf(f, ",\n      \"%s\": %.3f", jsonEscape(counter.first).c_str(), counter.second);
+    }
+    fprintf(f, "\n");
+    fprintf(f, "    }%s\n", i + 1 < results.size() ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+  return fclose(f) == 0;
+}
+
+// Grow the iteration count until a run takes minTime
+static Result measure(const Benchmark& b, double minTime) {
+  uint64_t iterations = 1;
+  for (;;) {
+    BenchState state(iterations);
+    b.run(state);
+    if (state.seconds() >= minTime || iterations >= 1000000000ULL) {
+      return Result{b.name, iterations, state.seconds() * 1e9 / iterations, state.cpuSeconds() * 1e9 / iterations,
+                    state.counters};
+    }
+    // Aim 40% past minTime, but never more than 10x per step
+    double scale = state.seconds() > 0 ? minTime * 1.4 / state.seconds() : 10;
+    iterations = (uint64_t)(iterations * (scale > 10 ? 10 : scale)) + 1;
+  }
+}
+
+int main(int argc, char** argv) {
+  std::string filter = ".";
+  std::string out = "eye_bench.json";
+  std::string label;
+  double minTime = 0.2;
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    if (strncmp(arg, "--benchmark_filter=", 19) == 0) {
+      filter = arg + 19;
+    } else if (strncmp(arg, "--benchmark_out=", 16) == 0) {
+      out = arg + 16;
+    } else if (strncmp(arg, "--benchmark_min_time=", 21) == 0) {
+      minTime = atof(arg + 21);
+    } else if (strncmp(arg, "--label=", 8) == 0) {
+      label = arg + 8;
+    } else {
+      fprintf(stderr, "usage: %s [--benchmark_filter=regex] [--benchmark_out=file.json] "
+                      "[--benchmark_min_time=seconds] [--label=text]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  registerAll();
+  std::regex pattern(filter);
+  std::vector<Result> results;
+  printf("%-32s %14s %14s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+  for (const Benchmark& b : benchmarks()) {
+    if (!std::regex_search(b.name, pattern)) {
+      continue;
+    }
+    Result r = measure(b, minTime);
+    printf("%-32s %11.1f ns %11.1f ns %12llu", r.name.c_str(), r.realNs, r.cpuNs,
+           (unsigned long long)r.iterations);
+    for (const auto& counter : r.counters) {
+      printf(" %s=%g", counter.first.c_str(), counter.second);
+    }
+    printf("\n");
+    results.push_back(r);
+  }
+
+  if (!writeJson(out.c_str(), argv[0], label, results)) {
+    fprintf(stderr, "can't write %s\n", out.c_str());
+    return 1;
+  }
+  printf("wrote %s\n", out.c_str());
+  return 0;
+}
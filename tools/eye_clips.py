@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""Pack frame images into animation clips for the firmware.
+
+    python3 tools/eye_clips.py -o src/eye_clips.h yawn=art/clips/yawn eat=art/clips/eat
+    python3 tools/eye_clips.py -o src/eye_clips.h --bin data/ yawn=art/clips/yawn
+
+Each NAME=DIR packs the images in DIR (SVG, PNG or PBM, in file name order,
+read as tools/eye_assets.py does) into one clip in the format described in
+src/eye_clip.h: a key frame every --keyframe frames and XOR deltas in
+between, PackBits-compressed. The header gets a constexpr array per clip
+and an EYE_CLIPS table; --bin also writes NAME.clip files for a filesystem.
+Every clip is played back and checked frame by frame before anything is
+written, and its size and bytes per second of animation are printed.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from eye_assets import encode_rle, read_image, to_pages  # noqa: E402
+
+VERSION = 1
+KEY, DELTA = 0, 1
+IMAGE_SUFFIXES = (".pbm", ".png", ".svg")
+
+
+def pack(frames, width, height, period, keyframe):
+    out = bytearray(b"EC" + struct.pack("<BBBBHHH", VERSION, 0, width, height, len(frames), period, 0))
+    previous = None
+    keys = 0
+    for i, frame in enumerate(frames):
+        key_payload = encode_rle(frame)
+        if previous is None or i % keyframe == 0:
+            kind, payload = KEY, key_payload
+        else:
+            delta = encode_rle(bytes(a ^ b for a, b in zip(frame, previous)))
+            # A delta only pays off if it's smaller than the frame itself
+            kind, payload = (DELTA, delta) if len(delta) < len(key_payload) else (KEY, key_payload)
+        keys += kind == KEY
+        out += struct.pack("<BH", kind, len(payload)) + payload
+        previous = frame
+    return bytes(out), keys
+
+
+def unpack_rle(data, length):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        control = data[i]
+        if control < 0x80:
+            out += data[i + 1:i + 2 + control]
+            i += control + 2
+        else:
+            out += bytes([data[i + 1]]) * (control - 0x7f)
+            i += 2
+    if len(out) != length:
+        raise ValueError("frame decodes to %d bytes, expected %d" % (len(out), length))
+    return bytes(out)
+
+
+def play(clip):
+    """Decode a packed clip, as the player does."""
+    _, _, _, width, height, count, _, _ = struct.unpack("<2sBBBBHHH", clip[:12])
+    length = width * height // 8
+    pos = 12
+    frames = []
+    for _ in range(count):
+        kind, size = struct.unpack("<BH", clip[pos:pos + 3])
+        data = unpack_rle(clip[pos + 3:pos + 3 + size], length)
+        pos += 3 + size
+        if kind == DELTA:
+            data = bytes(a ^ b for a, b in zip(data, frames[-1]))
+        frames.append(data)
+    return frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("clips", nargs="+", metavar="NAME=DIR", help="clip name and its frames")
+    parser.add_argument("-o", "--output", required=True, help="header to write")
+    parser.add_argument("--bin", help="also write NAME.clip files to this directory")
+    parser.add_argument("--size", default="128x64", help="display size, WxH")
+    parser.add_argument("--period", type=int, default=80, help="milliseconds per frame")
+    parser.add_argument("--keyframe", type=int, default=8, help="frames between key frames")
+    parser.add_argument("--threshold", type=int, default=128, help="grey level that lights a pixel")
+    args = parser.parse_args()
+
+    width, height = (int(v) for v in args.size.split("x"))
+    clips = []
+    for spec in args.clips:
+        name, _, directory = spec.partition("=")
+        if not re.match(r"^[a-z][a-z0-9_]*$", name) or not directory:
+            sys.exit("clips are NAME=DIR, NAME in lower case: %s" % spec)
+        paths = sorted(os.path.join(directory, f) for f in os.listdir(directory)
+                       if f.lower().endswith(IMAGE_SUFFIXES))
+        if not paths:
+            sys.exit("no frames in %s" % directory)
+        frames = [to_pages(read_image(p, width, height, args.threshold), width, height) for p in paths]
+        clip, keys = pack(frames, width, height, args.period, args.keyframe)
+        if play(clip) != frames:
+            sys.exit("%s doesn't play back as its frames" % name)
+        clips.append((name, directory, clip, len(frames), keys))
+
+    lines = [
+        "#pragma once",
+        "",
+        "// Generated by tools/eye_clips.py from:",
+    ]
+    lines += ["//   %s=%s" % (name, os.path.relpath(directory)) for name, directory, _, _, _ in clips]
+    lines += [
+        "// with %d ms frames and a key frame every %d. Edit the frames and rerun"
+        % (args.period, args.keyframe),
+        "// the tool rather than editing this file.",
+        "",
+        '#include "eye_clip.h"',
+        "",
+    ]
+    for name, _, clip, _, _ in clips:
+        lines.append("constexpr uint8_t EYE_CLIP_%s_DATA[] = {" % name.upper())
+        for i in range(0, len(clip), 16):
+            lines.append("  " + ", ".join("0x%02x" % b for b in clip[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+    lines.append("constexpr EyeClip EYE_CLIPS[] = {")
+    for name, _, _, _, _ in clips:
+        lines.append('  {"%s", EYE_CLIP_%s_DATA, sizeof(EYE_CLIP_%s_DATA)},' % (name, name.upper(), name.upper()))
+    lines.append("};")
+    lines.append("constexpr int EYE_CLIP_COUNT = sizeof(EYE_CLIPS) / sizeof(EYE_CLIPS[0]);")
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    if args.bin:
+        os.makedirs(args.bin, exist_ok=True)
+        for name, _, clip, _, _ in clips:
+            with open(os.path.join(args.bin, name + ".clip"), "wb") as f:
+                f.write(clip)
+
+    print("%-10s %6s %5s %8s %8s %10s" % ("clip", "frames", "keys", "bytes", "raw", "bytes/s"))
+    for name, _, clip, count, keys in clips:
+        seconds = count * args.period / 1000.0
+        print("%-10s %6d %5d %8d %8d %10.0f" % (name, count, keys, len(clip), count * width * height // 8,
+                                                 len(clip) / seconds))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,414 @@
+// Soaks the pet's behaviour and needs code: many independent pets on
+// virtual time, spread over every core, each checked frame by frame for the
+// ways a pet can go wrong on someone's wrist.
+//
+//   g++ -O2 -std=c++17 -pthread -Isrc tools/fleet_soak.cpp src/pet_behavior.cpp src/pet_needs.cpp src/event_trace.cpp -o fleet_soak
+//   ./fleet_soak                  # 256 pets, 24 h each, all cores
+//   ./fleet_soak 1000 72 8        # pets, hours per pet, threads
+//
+// Every pet gets its own ManualClock, PetRandom seed and owner: someone who
+// taps through the web controls now and then, feeds and cares for it
+// (or, for one pet in eight, forgets to). Frames step at the device's 40 ms
+// pace with a little jitter. Nothing waits on a real clock, so the run goes
+// as fast as the cores allow.
+//
+// Pets are simulated in slices of SLICE_MS of virtual time. A worker
+// pushes a pet's next slice back onto its own deque and idle workers steal
+// slices from the other end of someone else's, so a few slow pets don't
+// leave cores idle at the end.
+//
+// Invariants, checked every frame:
+//   stuck       an auto-mode expression held past the longest hold time
+//   blink       no blink for BLINK_GAP_MS
+//   needs       a need level outside 0..100 (checked every virtual second)
+//   transition  a transition still running after PET_TRANSITION_MS
+//   mood        a pressing need not on the face while nothing overrides it
+//   feed        a feed that never shows happy eyes
+//   shape       eye shapes that aren't finite or don't fit the screen
+// Exits non-zero if any pet breaks one.
+
+#include "pet_behavior.h"
+#include "pet_needs.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const uint32_t FRAME_MS = 40;
+static const uint32_t SLICE_MS = 15 * 60 * 1000;
+static const uint32_t MAX_FRAME_MS = FRAME_MS + 2;  // frame step plus jitter
+
+// The behaviour's longest hold is a neutral spell of up to 8 s
+static const uint32_t STUCK_MS = 8000 + 2 * MAX_FRAME_MS;
+// 70% chance at least every 5 s: 24 misses in a row is about 3e-13
+static const uint32_t BLINK_GAP_MS = 120000;
+static const uint32_t TRANSITION_LIMIT_MS = PET_TRANSITION_MS + MAX_FRAME_MS;
+// A mood can wait for the transition under way, then needs its own
+static const uint32_t MOOD_LIMIT_MS = 2 * TRANSITION_LIMIT_MS + MAX_FRAME_MS;
+
+enum Violation {
+  VIOLATION_STUCK,
+  VIOLATION_BLINK,
+  VIOLATION_NEEDS,
+  VIOLATION_TRANSITION,
+  VIOLATION_MOOD,
+  VIOLATION_FEED,
+  VIOLATION_SHAPE,
+  VIOLATION_COUNT
+};
+
+static const char* const VIOLATION_NAMES[VIOLATION_COUNT] = {
+  "stuck", "blink", "needs", "transition", "mood", "feed", "shape"
+};
+
+static const int EXAMPLES = 3;
+
+struct SimPet {
+  explicit SimPet(int index)
+      : id(index), pet(clock), needs(PET_NEED_CURVES), owner(0x5eed0000u + index) {}
+
+  int id;
+  ManualClock clock;
+  PetBehavior pet;
+  PetNeeds needs;
+  PetRandom owner;       // the owner's choices, separate from the pet's
+  bool neglected = false;
+
+  uint32_t now = 0;
+  uint32_t end = 0;
+  uint32_t nextCommand = 0;
+  uint32_t nextCare = 0;
+  uint32_t nextNeedsCheck = 0;
+  uint64_t frames = 0;
+
+  // Invariant tracking
+  EyeState shown = STATE_NEUTRAL;
+  uint32_t holdSince = 0;
+  bool wasBlinking = false;
+  uint32_t lastBlink = 0;
+  bool wasTransitioning = false;
+  EyeState transitionTarget = STATE_NEUTRAL;
+  uint32_t transitionSince = 0;
+  uint32_t moodMissingSince = 0;
+  bool moodMissing = false;
+  uint32_t feedSince = 0;
+  bool wasFeeding = false;
+  bool feedOverridden = false;  // reported, or the owner changed the face since
+
+  uint32_t violations[VIOLATION_COUNT] = {};
+  char examples[VIOLATION_COUNT][EXAMPLES][96];
+};
+
+static void violation(SimPet& p, Violation kind, const char* format, uint32_t value) {
+  uint32_t n = p.violations[kind]++;
+  if (n < EXAMPLES) {
+    snprintf(p.examples[kind][n], sizeof(p.examples[kind][n]), "pet %d at %u.%03u s: ", p.id, p.now / 1000,
+             p.now % 1000);
+    size_t used = strlen(p.examples[kind][n]);
+    snprintf(p.examples[kind][n] + used, sizeof(p.examples[kind][n]) - used, format, value);
+  }
+}
+
+static void start(SimPet& p, uint32_t hours) {
+  p.now = 1000 + p.owner.range(0, 5000);  // boot takes a moment
+  p.end = p.now + hours * 3600000u;
+  p.neglected = p.id % 8 == 7;
+  p.clock.set(p.now);
+  p.needs.reset(p.now / 1000);
+  p.pet.begin(0x9e3779b9u * (uint64_t)(p.id + 1));
+  p.nextCommand = p.now + p.owner.range(2000, 60000);
+  p.nextCare = p.now + p.owner.range(20000, 90000);
+  p.holdSince = p.lastBlink = p.now;
+}
+
+// What someone does with the web page or the phone app
+static void owner(SimPet& p) {
+  if (p.now >= p.nextCommand) {
+    p.clock.set(p.now - p.owner.range(0, 5));  // handled just before the frame
+    switch (p.owner.range(0, 8)) {
+      case 0:
+      case 1:
+        p.pet.setEmotion(p.owner.range(0, STATE_COUNT));
+        p.feedOverridden = true;  // a chosen expression replaces the happy eyes
+        break;
+      case 2: p.pet.setReadingLight(!p.pet.readingLight()); break;
+      case 3:
+      case 4:
+        p.pet.setManualMode(!p.pet.manualMode());
+        p.feedOverridden = true;  // so does leaving manual mode
+        break;
+      default:
+        if (!p.neglected) {
+          uint32_t seconds = p.clock.now() / 1000;
+          p.needs.set(NEED_HUNGER, NEED_FULL, seconds);
+          p.needs.add(NEED_HAPPINESS, 20, seconds);
+          p.pet.feed();
+        }
+        break;
+    }
+    // Busy stretches and quiet hours
+    p.nextCommand = p.now + (p.owner.range(0, 4) ? p.owner.range(2000, 120000) : p.owner.range(600000, 3600000));
+  }
+  if (p.now >= p.nextCare && !p.neglected) {
+    uint32_t seconds = p.now / 1000;
+    p.needs.set((PetNeed)p.owner.range(NEED_ENERGY, NEED_COUNT), NEED_FULL, seconds);
+    p.nextCare = p.now + p.owner.range(600000, 4 * 3600000);
+  }
+}
+
+static bool shapeFits(const EyeShape& e) {
+  return std::isfinite(e.width) && std::isfinite(e.height) && std::isfinite(e.offsetX) &&
+         std::isfinite(e.offsetY) && std::isfinite(e.angle) && e.width > 0 && e.height > 0 &&
+         e.width <= 2 * PET_EYE_WIDTH && e.height <= 2 * PET_EYE_HEIGHT && fabsf(e.offsetX) <= 32 &&
+         fabsf(e.offsetY) <= 20 && fabsf(e.angle) <= 1.0f;
+}
+
+static void check(SimPet& p, bool needy, EyeState needMood) {
+  PetBehavior& pet = p.pet;
+
+  bool autoMode = !pet.manualMode() && !pet.moodFromNeeds() && !pet.feeding();
+  if (pet.state() != p.shown || !autoMode || pet.transitioning()) {
+    p.shown = pet.state();
+    p.holdSince = p.now;
+  } else if (p.now - p.holdSince > STUCK_MS) {
+    violation(p, VIOLATION_STUCK, "held one expression for %u ms", p.now - p.holdSince);
+    p.holdSince = p.now;
+  }
+
+  if (pet.blinking() && !p.wasBlinking) {
+    p.lastBlink = p.now;
+  } else if (p.now - p.lastBlink > BLINK_GAP_MS) {
+    violation(p, VIOLATION_BLINK, "no blink for %u ms", p.now - p.lastBlink);
+    p.lastBlink = p.now;
+  }
+  p.wasBlinking = pet.blinking();
+
+  if (pet.transitioning()) {
+    // A transition can finish and the next start in the same update
+    if (!p.wasTransitioning || pet.state() != p.transitionTarget) {
+      p.transitionTarget = pet.state();
+      p.transitionSince = p.now;
+    } else if (p.now - p.transitionSince > TRANSITION_LIMIT_MS) {
+      violation(p, VIOLATION_TRANSITION, "transition running for %u ms", p.now - p.transitionSince);
+      p.transitionSince = p.now;
+    }
+  }
+  p.wasTransitioning = pet.transitioning();
+
+  if (needy && !pet.feeding() && pet.currentState() != needMood) {
+    if (!p.moodMissing) {
+      p.moodMissing = true;
+      p.moodMissingSince = p.now;
+    } else if (p.now - p.moodMissingSince > MOOD_LIMIT_MS) {
+      violation(p, VIOLATION_MOOD, "need mood missing from the face, showing state %u", pet.currentState());
+      p.moodMissingSince = p.now;
+    }
+  } else {
+    p.moodMissing = false;
+  }
+
+  if (pet.feeding()) {
+    if (!p.wasFeeding) {
+      p.feedSince = p.now;
+      p.feedOverridden = false;
+    }
+    if (pet.currentState() != STATE_HAPPY && p.now - p.feedSince > MOOD_LIMIT_MS && !p.feedOverridden) {
+      violation(p, VIOLATION_FEED, "fed %u ms ago, no happy eyes", p.now - p.feedSince);
+      p.feedOverridden = true;
+    }
+  }
+  p.wasFeeding = pet.feeding();
+
+  if (!shapeFits(pet.leftEye()) || !shapeFits(pet.rightEye())) {
+    violation(p, VIOLATION_SHAPE, "eye shape out of range in state %u", pet.currentState());
+  }
+
+  if (p.now >= p.nextNeedsCheck) {
+    for (int i = 0; i < NEED_COUNT; i++) {
+      float level = p.needs.level((PetNeed)i, p.now / 1000);
+      if (!(level >= 0 && level <= NEED_FULL)) {
+        violation(p, VIOLATION_NEEDS, "need %u out of range", i);
+      }
+    }
+    p.nextNeedsCheck = p.now + 1000;
+  }
+}
+
+// One slice of virtual time; returns false once the pet is done
+static bool simulate(SimPet& p) {
+  uint32_t sliceEnd = p.end - p.now > SLICE_MS ? p.now + SLICE_MS : p.end;
+  volatile uint32_t sink = 0;
+  while (p.now < sliceEnd) {
+    owner(p);
+
+    EyeState needMood;
+    bool needy = p.needs.mood(p.now / 1000, needMood);
+    p.clock.set(p.now);
+    p.pet.update(needy, needMood);
+    // What the device would hash for /trace on a drawn frame
+    if (p.pet.frameKey() < 0) {
+      sink = sink + p.pet.frameHash();
+    }
+    check(p, needy, needMood);
+
+    p.frames++;
+    p.now += FRAME_MS + p.owner.range(0, 3);
+  }
+  return p.now < p.end;
+}
+
+// --- work-stealing pool ---
+
+// Each worker owns a deque of pet indices. It takes work from the back of
+// its own (the pet it just ran, still in cache) and steals from the front
+// of the others'. A mutex per deque is plenty at one lock per 15-minute
+// slice.
+class StealingPool {
+public:
+  explicit StealingPool(int threads) : _queues(threads), _pending(0), _steals(0) {}
+
+  void push(int worker, int task) {
+    _pending++;
+    Queue& q = _queues[worker];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.tasks.push_back(task);
+  }
+
+  // Runs until every task (and everything they push) is done
+  template <typename Function>
+  void run(Function function) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < _queues.size(); i++) {
+      threads.emplace_back([this, i, &function] { work((int)i, function); });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  uint64_t steals() const { return _steals; }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<int> tasks;
+  };
+
+  template <typename Function>
+  void work(int self, Function& function) {
+    PetRandom victims(self + 1);
+    while (_pending > 0) {
+      int task;
+      if (!popOwn(self, task) && !steal(self, victims, task)) {
+        std::this_thread::yield();
+        continue;
+      }
+      function(self, task);
+      _pending--;
+    }
+  }
+
+  bool popOwn(int self, int& task) {
+    Queue& q = _queues[self];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) {
+      return false;
+    }
+    task = q.tasks.back();
+    q.tasks.pop_back();
+    return true;
+  }
+
+  bool steal(int self, PetRandom& victims, int& task) {
+    int count = (int)_queues.size();
+    int first = victims.range(0, count);
+    for (int i = 0; i < count; i++) {
+      int victim = (first + i) % count;
+      if (victim == self) {
+        continue;
+      }
+      Queue& q = _queues[victim];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.tasks.empty()) {
+        task = q.tasks.front();
+        q.tasks.pop_front();
+        _steals++;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<Queue> _queues;
+  std::atomic<int> _pending;
+  std::atomic<uint64_t> _steals;
+};
+
+int main(int argc, char** argv) {
+  int petCount = argc > 1 ? atoi(argv[1]) : 256;
+  uint32_t hours = argc > 2 ? atoi(argv[2]) : 24;
+  int threads = argc > 3 ? atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+  if (threads < 1) {
+    threads = 1;
+  }
+  // Virtual milliseconds are 32 bits, like millis()
+  if (petCount < 1 || hours < 1 || hours > 1000) {
+    fprintf(stderr, "usage: %s [pets] [hours, up to 1000] [threads]\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<std::unique_ptr<SimPet>> pets;
+  for (int i = 0; i < petCount; i++) {
+    pets.emplace_back(new SimPet(i));
+    start(*pets.back(), hours);
+  }
+
+  StealingPool pool(threads);
+  for (int i = 0; i < petCount; i++) {
+    pool.push(i % threads, i);
+  }
+  auto began = std::chrono::steady_clock::now();
+  pool.run([&](int worker, int index) {
+    if (simulate(*pets[index])) {
+      pool.push(worker, index);
+    }
+  });
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - began).count();
+
+  uint64_t frames = 0;
+  uint32_t totals[VIOLATION_COUNT] = {};
+  for (const auto& p : pets) {
+    frames += p->frames;
+    for (int k = 0; k < VIOLATION_COUNT; k++) {
+      totals[k] += p->violations[k];
+    }
+  }
+
+  double petHours = (double)petCount * hours;
+  printf("%d pets x %u h on %d threads: %.1f s, %.0f pet-hours/s, %.1f M frames/s, %llu steals\n", petCount,
+         hours, threads, seconds, petHours / seconds, frames / seconds / 1e6, (unsigned long long)pool.steals());
+
+  int failed = 0;
+  for (int k = 0; k < VIOLATION_COUNT; k++) {
+    printf("%s %-10s %u\n", totals[k] ? "FAIL" : "ok  ", VIOLATION_NAMES[k], totals[k]);
+    if (!totals[k]) {
+      continue;
+    }
+    failed = 1;
+    int shown = 0;
+    for (const auto& p : pets) {
+      for (uint32_t n = 0; n < p->violations[k] && n < EXAMPLES && shown < EXAMPLES; n++, shown++) {
+        printf("       %s\n", p->examples[k][n]);
+      }
+    }
+  }
+  return failed;
+}
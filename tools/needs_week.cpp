@@ -0,0 +1,137 @@
+// Simulates a week of the pet's needs on the host and checks the closed-form
+// decay against a tick-by-tick simulation.
+//
+//   g++ -O2 -std=c++17 -Isrc tools/needs_week.cpp src/pet_needs.cpp -o needs_week
+//   ./needs_week
+//
+// Checks:
+//   - re-anchoring every few seconds (what a stepped loop would do) lands
+//     on the same levels as one evaluation over the whole week
+//   - evaluating after a second and after a week costs the same
+//   - with regular feeding, sleep and cleaning the pet is content for most
+//     of its waking hours, and still gets sleepy at night
+// Exits non-zero if any check fails.
+
+#include "pet_needs.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+static const uint32_t WEEK = 7 * 24 * 3600;
+static const uint32_t TICK = 5; // seconds per step in the tick simulation
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+  printf("%s %s\n", ok ? "ok  " : "FAIL", what);
+  if (!ok) {
+    failures++;
+  }
+}
+
+static double nsPerCall(uint32_t elapsed) {
+  PetNeeds needs(PET_NEED_CURVES);
+  needs.reset(0);
+  const int calls = 200000;
+  volatile float sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < calls; i++) {
+    for (int n = 0; n < NEED_COUNT; n++) {
+      sink = sink + needs.level((PetNeed)n, elapsed + (i & 1));
+    }
+  }
+  auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return ns / calls;
+}
+
+int main() {
+  auto start = std::chrono::steady_clock::now();
+
+  // Hunger runs on a 100 s demo clock; give it a slow curve here so the
+  // week-long comparison exercises something other than an empty stomach.
+  NeedCurve curves[NEED_COUNT];
+  for (int i = 0; i < NEED_COUNT; i++) {
+    curves[i] = PET_NEED_CURVES[i];
+  }
+  curves[NEED_HUNGER] = {NEED_CURVE_PIECEWISE, 0, {50.0f, 0}, {3.0f, 1.5f}, 2, 10.0f, STATE_SAD};
+
+  // Tick simulation vs one closed-form jump, day by day
+  PetNeeds ticked(curves), jumped(curves);
+  ticked.reset(0);
+  jumped.reset(0);
+  float worstError = 0;
+  for (uint32_t t = TICK; t <= WEEK; t += TICK) {
+    for (int n = 0; n < NEED_COUNT; n++) {
+      ticked.set((PetNeed)n, ticked.level((PetNeed)n, t), t);
+    }
+    if (t % 3600 == 0) {
+      for (int n = 0; n < NEED_COUNT; n++) {
+        float error = fabsf(ticked.level((PetNeed)n, t) - jumped.level((PetNeed)n, t));
+        if (error > worstError) worstError = error;
+      }
+    }
+  }
+  printf("     worst tick/closed-form difference over a week: %.4f%%\n", worstError);
+  check(worstError < 0.5f, "stepped and closed-form levels agree");
+
+  // Constant cost regardless of time switched off
+  double shortNs = nsPerCall(1);
+  double longNs = nsPerCall(WEEK * 52);
+  printf("     %.1f ns after 1 s, %.1f ns after a year (4 needs)\n", shortNs, longNs);
+  check(longNs < shortNs * 2 + 20, "cost does not grow with elapsed time");
+
+  // A week of care: fed every 4 h while awake, sleeps 23:00-07:00, washed
+  // every other day, played with a few times a day.
+  PetNeeds needs(curves);
+  needs.reset(0);
+  int moodMinutes[STATE_COUNT] = {0};
+  int contentMinutes = 0;
+  int awakeMinutes = 0;
+  for (uint32_t t = 0; t < WEEK; t += 60) {
+    uint32_t hourOfDay = (t / 3600) % 24;
+    bool atHour = t % 3600 == 0;
+    if (atHour && hourOfDay >= 7 && hourOfDay < 23 && hourOfDay % 4 == 3) {
+      needs.set(NEED_HUNGER, NEED_FULL, t);
+    }
+    if (atHour && hourOfDay == 7) {
+      needs.set(NEED_ENERGY, NEED_FULL, t);
+    }
+    if (atHour && hourOfDay == 20 && (t / 86400) % 2 == 1) {
+      needs.set(NEED_CLEANLINESS, NEED_FULL, t);
+    }
+    if (atHour && (hourOfDay == 9 || hourOfDay == 13 || hourOfDay == 18)) {
+      needs.add(NEED_HAPPINESS, 40, t);
+    }
+    bool awake = hourOfDay >= 7 && hourOfDay < 23;
+    EyeState mood;
+    if (needs.mood(t, mood)) {
+      moodMinutes[mood]++;
+    } else if (awake) {
+      contentMinutes++;
+    }
+    if (awake) {
+      awakeMinutes++;
+    }
+  }
+  printf("     content %d of %d waking min; sad %d, sleepy %d, angry %d, suspicious %d\n", contentMinutes,
+         awakeMinutes, moodMinutes[STATE_SAD], moodMinutes[STATE_SLEEPY], moodMinutes[STATE_ANGRY],
+         moodMinutes[STATE_SUSPICIOUS]);
+  check(contentMinutes * 4 > awakeMinutes * 3, "a cared-for pet is content most of the day");
+  check(moodMinutes[STATE_SLEEPY] > 0, "gets sleepy late at night");
+  check(moodMinutes[STATE_SAD] == 0, "never starves when fed");
+
+  // Left alone for the whole week: every need ends up on the face
+  PetNeeds neglected(curves);
+  neglected.reset(0);
+  EyeState mood = STATE_NEUTRAL;
+  bool needy = neglected.mood(WEEK, mood);
+  for (int n = 0; n < NEED_COUNT; n++) {
+    printf("     neglected %s: %.1f%%\n", PetNeeds::name((PetNeed)n), neglected.level((PetNeed)n, WEEK));
+  }
+  check(needy && mood != STATE_NEUTRAL, "a neglected pet shows it");
+
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  printf("     total %.1f ms\n", ms);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Build compressed and delta firmware payloads for the /update route.
+
+    python3 tools/ota_delta.py old.bin new.bin -o new.delta
+
+Prints bytes on the wire for a raw, zlib and delta upload of new.bin, so
+the saving for a given change can be read off directly. The patch is
+checked by applying it to old.bin before it is written.
+
+Patch format is described in src/ota_decode.h. Matching is bsdiff-like:
+regions of new.bin that line up with old.bin are sent as bytewise
+differences (mostly zeros, even where relocated addresses changed), which
+zlib then squeezes down; everything else is sent as literal data.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+WINDOW_BITS = 12  # must match OTA_WINDOW_BITS in src/ota_decode.h
+BLOCK = 8         # seed length for a match
+MIN_MATCH = 24    # shorter matches are cheaper as literal data
+MISS_WINDOW = 32  # a match ends once more than MAX_MISSES of the
+MAX_MISSES = 8    # last MISS_WINDOW bytes differ
+
+OP_DIFF = 1
+OP_DATA = 2
+
+
+def compress(data):
+    c = zlib.compressobj(9, zlib.DEFLATED, WINDOW_BITS)
+    return c.compress(data) + c.flush()
+
+
+def _extend(old, new, src, dst):
+    """Length of the approximate match of new[dst:] against old[src:].
+
+    The match runs until more than MAX_MISSES of the last MISS_WINDOW bytes
+    differ, and is trimmed back to its last exactly matching byte.
+    """
+    misses = bytearray(MISS_WINDOW)
+    miss_count = 0
+    length = 0
+    best = 0
+    limit = min(len(old) - src, len(new) - dst)
+    while length < limit:
+        miss = 1 if old[src + length] != new[dst + length] else 0
+        slot = length % MISS_WINDOW
+        miss_count += miss - misses[slot]
+        misses[slot] = miss
+        length += 1
+        if miss_count > MAX_MISSES:
+            break
+        if not miss:
+            best = length
+    return best
+
+
+def make_delta(old, new):
+    index = {}
+    for i in range(0, len(old) - BLOCK + 1, 4):
+        index.setdefault(old[i:i + BLOCK], i)
+
+    ops = []
+    literal_start = 0
+    pos = 0
+    last_src = None
+    while pos < len(new):
+        candidates = []
+        if last_src is not None and last_src < len(old):
+            candidates.append(last_src)  # keep following the previous match
+        seed = index.get(new[pos:pos + BLOCK])
+        if seed is not None:
+            candidates.append(seed)
+
+        best_src, best_len = None, 0
+        for src in candidates:
+            length = _extend(old, new, src, pos)
+            if length > best_len:
+                best_src, best_len = src, length
+
+        if best_len >= MIN_MATCH:
+            if literal_start < pos:
+                ops.append((OP_DATA, 0, new[literal_start:pos]))
+            diff = bytes((new[pos + k] - old[best_src + k]) & 0xFF for k in range(best_len))
+            ops.append((OP_DIFF, best_src, diff))
+            pos += best_len
+            literal_start = pos
+            last_src = best_src + best_len
+        else:
+            pos += 1
+            if last_src is not None:
+                last_src += 1
+    if literal_start < len(new):
+        ops.append((OP_DATA, 0, new[literal_start:]))
+
+    out = bytearray(b"WPD1" + struct.pack("<II", len(new), len(old)))
+    for op, offset, payload in ops:
+        out += struct.pack("<BII", op, offset, len(payload)) + payload
+    return bytes(out)
+
+
+def apply_delta(old, patch):
+    """Reference implementation of OtaDecoder::patch()."""
+    if patch[:4] != b"WPD1":
+        raise ValueError("bad patch magic")
+    target_size, base_size = struct.unpack_from("<II", patch, 4)
+    if base_size > len(old):
+        raise ValueError("patch is for a larger base image")
+    out = bytearray()
+    pos = 12
+    while pos < len(patch):
+        op, offset, length = struct.unpack_from("<BII", patch, pos)
+        pos += 9
+        payload = patch[pos:pos + length]
+        pos += length
+        if op == OP_DIFF:
+            out += bytes((old[offset + k] + payload[k]) & 0xFF for k in range(length))
+        elif op == OP_DATA:
+            out += payload
+        else:
+            raise ValueError(f"bad op {op}")
+    if len(out) != target_size:
+        raise ValueError("patch produced wrong size")
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("old", help="firmware currently running on the device")
+    parser.add_argument("new", help="firmware to install")
+    parser.add_argument("-o", "--output", help="write the compressed delta here")
+    args = parser.parse_args()
+
+    old = open(args.old, "rb").read()
+    new = open(args.new, "rb").read()
+    patch = make_delta(old, new)
+    if apply_delta(old, patch) != new:
+        sys.exit("internal error: patch does not reproduce the new image")
+    payload = compress(patch)
+
+    print(f"raw:   {len(new):8d} bytes")
+    print(f"zlib:  {len(compress(new)):8d} bytes")
+    print(f"delta: {len(payload):8d} bytes ({len(patch)} before compression)")
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(payload)
+
+
+if __name__ == "__main__":
+    main()
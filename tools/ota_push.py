@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Push a firmware image to the wearable's /update route.
+
+    python3 tools/ota_push.py firmware.bin --host ESP32-Wearable.local
+
+The SHA-256 of the image is sent as ?sha256= so the device can verify the
+stream before switching boot partitions.
+
+--encoding zlib sends the image compressed; --encoding delta --base old.bin
+sends only a patch against the firmware the device is running now (see
+tools/ota_delta.py). Bytes on the wire and upload time are printed either way.
+
+--serve runs a local stand-in for the device's /update route that follows
+the same rules (streamed multipart body, incremental SHA-256, reject on
+mismatch), so the uploader can be exercised without hardware. Give it
+--base to stand in for the running firmware when testing deltas:
+
+    python3 tools/ota_push.py --serve 8080 --base old.bin &
+    python3 tools/ota_push.py firmware.bin --host 127.0.0.1:8080
+
+The stand-in is Python; the device's own OtaStream is exercised on the host
+by the ota_upload test (tests/ota_upload.cpp, run by ctest).
+"""
+
+import argparse
+import hashlib
+import http.client
+import http.server
+import os
+import struct
+import sys
+import time
+import urllib.parse
+import uuid
+import zlib
+
+import ota_delta
+
+CHUNK = 1436  # HTTP_UPLOAD_BUFLEN on the ESP32 WebServer
+
+
+def encode(image, encoding, base_path):
+    if encoding == "zlib":
+        return ota_delta.compress(image)
+    if encoding == "delta":
+        with open(base_path, "rb") as f:
+            base = f.read()
+        return ota_delta.compress(ota_delta.make_delta(base, image))
+    return image
+
+
+def push(path, host, encoding="raw", base_path=None, chunk=CHUNK):
+    with open(path, "rb") as f:
+        image = f.read()
+    digest = hashlib.sha256(image).hexdigest()
+    payload = encode(image, encoding, base_path)
+    boundary = uuid.uuid4().hex
+    head = (
+        f"--{boundary}\r\n"
+        f'Content-Disposition: form-data; name="firmware"; filename="{os.path.basename(path)}"\r\n'
+        "Content-Type: application/octet-stream\r\n\r\n"
+    ).encode()
+    tail = f"\r\n--{boundary}--\r\n".encode()
+
+    conn = http.client.HTTPConnection(host, timeout=60)
+    conn.putrequest("POST", f"/update?sha256={digest}&size={len(image)}&encoding={encoding}")
+    conn.putheader("Content-Type", f"multipart/form-data; boundary={boundary}")
+    conn.putheader("Content-Length", str(len(head) + len(payload) + len(tail)))
+    conn.endheaders()
+
+    start = time.time()
+    conn.send(head)
+    for off in range(0, len(payload), chunk):
+        conn.send(payload[off:off + chunk])
+    conn.send(tail)
+    resp = conn.getresponse()
+    elapsed = time.time() - start
+    body = resp.read().decode(errors="replace")
+    print(f"{resp.status} {body.strip()}")
+    print(f"{encoding}: {len(payload)} bytes on the wire for a {len(image)} byte image, "
+          f"{elapsed:.2f}s ({len(payload) / 1024 / max(elapsed, 1e-6):.1f} KB/s)")
+    return resp.status == 200
+
+
+class StandInHandler(http.server.BaseHTTPRequestHandler):
+    """Mimics handleUpdateUpload()/handleUpdateDone() on the device."""
+
+    base = None  # running firmware, for delta uploads
+
+    def do_POST(self):
+        url = urllib.parse.urlparse(self.path)
+        if url.path != "/update":
+            self.send_error(404)
+            return
+        args = urllib.parse.parse_qs(url.query)
+        expected = args.get("sha256", [""])[0].lower()
+        encoding = args.get("encoding", ["raw"])[0]
+        if len(expected) != 64:
+            self.reply(400, "Update failed: Missing or malformed sha256")
+            return
+        if encoding not in ("raw", "zlib", "delta") or (encoding == "delta" and self.base is None):
+            self.reply(400, "Update failed: Begin Failed")
+            return
+
+        ctype = self.headers.get("Content-Type", "")
+        boundary = ctype.split("boundary=")[-1].encode()
+        remaining = int(self.headers.get("Content-Length", 0))
+
+        # Skip the part headers, then decode and hash the body as it streams
+        # in. The device applies deltas incrementally too; the stand-in keeps
+        # the (small) decompressed patch and applies it at the end.
+        header = b""
+        while b"\r\n\r\n" not in header:
+            byte = self.rfile.read(1)
+            remaining -= 1
+            header += byte
+        trailer = len(b"\r\n--" + boundary + b"--\r\n")
+        sha = hashlib.sha256()
+        inflater = zlib.decompressobj(ota_delta.WINDOW_BITS) if encoding != "raw" else None
+        patch = bytearray()
+        received = 0
+        try:
+            while remaining > trailer:
+                part = self.rfile.read(min(CHUNK, remaining - trailer))
+                received += len(part)
+                remaining -= len(part)
+                if inflater:
+                    part = inflater.decompress(part)
+                if encoding == "delta":
+                    patch += part
+                else:
+                    sha.update(part)
+            self.rfile.read(remaining)
+            if inflater and not inflater.eof:
+                raise ValueError("truncated stream")
+            if encoding == "delta":
+                sha.update(ota_delta.apply_delta(self.base, bytes(patch)))
+        except (zlib.error, ValueError, struct.error):
+            self.reply(400, "Update failed: Decode Failed")
+            return
+
+        if sha.hexdigest() != expected:
+            self.reply(400, "Update failed: Digest mismatch")
+        else:
+            self.reply(200, "Update OK, rebooting")
+        print(f"stand-in: received {received} bytes ({encoding})", file=sys.stderr)
+
+    def reply(self, code, text):
+        self.send_response(code)
+        self.send_header("Content-Type", "text/plain")
+        self.end_headers()
+        self.wfile.write(text.encode())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("image", nargs="?", help="firmware .bin to upload")
+    parser.add_argument("--host", default="ESP32-Wearable.local", help="device host[:port]")
+    parser.add_argument("--encoding", choices=("raw", "zlib", "delta"), default="raw")
+    parser.add_argument("--base", help="firmware the device runs now (for delta)")
+    parser.add_argument("--serve", type=int, metavar="PORT", help="run the local /update stand-in")
+    args = parser.parse_args()
+
+    if args.serve:
+        if args.base:
+            with open(args.base, "rb") as f:
+                StandInHandler.base = f.read()
+        http.server.HTTPServer(("127.0.0.1", args.serve), StandInHandler).serve_forever()
+    if not args.image:
+        parser.error("image is required unless --serve is given")
+    if args.encoding == "delta" and not args.base:
+        parser.error("--encoding delta needs --base")
+    sys.exit(0 if push(args.image, args.host, args.encoding, args.base) else 1)
+
+
+if __name__ == "__main__":
+    main()
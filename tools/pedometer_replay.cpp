@@ -0,0 +1,160 @@
+// Replays recorded accelerometer traces through the on-device step detector
+// and reports accuracy and cost per sample.
+//
+//   g++ -O2 -std=c++17 -Isrc tools/pedometer_replay.cpp src/pedometer.cpp -o pedometer_replay
+//   ./pedometer_replay walk.csv [more.csv ...]
+//   ./pedometer_replay --max-error 10 tests/walks/*.csv  # as ctest runs it
+//   ./pedometer_replay --synth 500 synthetic.csv   # write a synthetic walk
+//
+// Trace format: one sample per line at 50 Hz, "t_ms,x,y,z" in milli-g.
+// Lines starting with '#' are comments; "# steps=N" gives the true count
+// used for the accuracy figure. A non-numeric first line is a header.
+// With --max-error PCT, a trace without a true count, or counted further
+// off than PCT percent, fails. Exits non-zero if any trace fails.
+
+#include "pedometer.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_RDTSC 1
+#endif
+
+class CsvSource : public AccelSource {
+public:
+  std::vector<AccelSample> samples;
+  size_t position = 0;
+  long expectedSteps = -1;
+
+  bool load(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+      return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+      if (line[0] == '#') {
+        const char* tag = strstr(line, "steps=");
+        if (tag) {
+          expectedSteps = atol(tag + 6);
+        }
+        continue;
+      }
+      long t;
+      int x, y, z;
+      if (sscanf(line, "%ld,%d,%d,%d", &t, &x, &y, &z) == 4) {
+        samples.push_back({(int16_t)x, (int16_t)y, (int16_t)z});
+      }
+    }
+    fclose(f);
+    return true;
+  }
+
+  // Hand out samples in FIFO-sized bursts, like the LIS3DH does
+  size_t read(AccelSample* out, size_t max) override {
+    size_t count = 0;
+    while (count < max && position < samples.size()) {
+      out[count++] = samples[position++];
+    }
+    return count;
+  }
+};
+
+static int writeSynthetic(long steps, const char* path) {
+  FILE* f = fopen(path, "w");
+  if (!f) {
+    perror(path);
+    return 1;
+  }
+  std::mt19937 rng(42);
+  std::normal_distribution<double> noise(0.0, 40.0);
+  std::uniform_real_distribution<double> cadence(1.6, 2.1); // steps per second
+
+  fprintf(f, "# synthetic walk\n# steps=%ld\nt_ms,x,y,z\n", steps);
+  long t = 0;
+  // Stand still, walk, stand still
+  for (int i = 0; i < 100; i++, t += 20) {
+    fprintf(f, "%ld,%d,%d,%d\n", t, (int)noise(rng), (int)noise(rng), 1000 + (int)noise(rng));
+  }
+  for (long s = 0; s < steps; s++) {
+    int samplesPerStep = (int)(PEDOMETER_SAMPLE_HZ / cadence(rng));
+    for (int i = 0; i < samplesPerStep; i++, t += 20) {
+      double phase = 2 * M_PI * i / samplesPerStep;
+      double bounce = 350 * sin(phase);
+      fprintf(f, "%ld,%d,%d,%d\n", t, (int)(120 * cos(phase) + noise(rng)),
+              (int)(80 * sin(phase * 0.5) + noise(rng)), (int)(1000 + bounce + noise(rng)));
+    }
+  }
+  for (int i = 0; i < 100; i++, t += 20) {
+    fprintf(f, "%ld,%d,%d,%d\n", t, (int)noise(rng), (int)noise(rng), 1000 + (int)noise(rng));
+  }
+  fclose(f);
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  if (argc >= 4 && strcmp(argv[1], "--synth") == 0) {
+    return writeSynthetic(atol(argv[2]), argv[3]);
+  }
+  int first = 1;
+  double maxError = -1;
+  if (argc >= 3 && strcmp(argv[1], "--max-error") == 0) {
+    maxError = atof(argv[2]);
+    first = 3;
+  }
+  if (argc <= first) {
+    fprintf(stderr, "usage: %s [--max-error PCT] trace.csv [...] | --synth STEPS out.csv\n", argv[0]);
+    return 2;
+  }
+
+  int failures = 0;
+  for (int i = first; i < argc; i++) {
+    CsvSource source;
+    if (!source.load(argv[i])) {
+      perror(argv[i]);
+      failures++;
+      continue;
+    }
+
+    StepDetector detector;
+    auto start = std::chrono::steady_clock::now();
+#ifdef HAVE_RDTSC
+    unsigned long long startCycles = __rdtsc();
+#endif
+    detector.poll(source);
+#ifdef HAVE_RDTSC
+    unsigned long long cycles = __rdtsc() - startCycles;
+#endif
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    size_t n = source.samples.size();
+
+    printf("%s: %zu samples (%.1f s), %u steps detected", argv[i], n,
+           n / (double)PEDOMETER_SAMPLE_HZ, detector.steps());
+    if (source.expectedSteps > 0) {
+      double error = 100.0 * ((double)detector.steps() - source.expectedSteps) / source.expectedSteps;
+      printf(", %ld expected (%+.1f%%)", source.expectedSteps, error);
+      if (maxError >= 0 && fabs(error) > maxError) {
+        printf(" FAIL: more than %.1f%% off", maxError);
+        failures++;
+      }
+    } else if (maxError >= 0) {
+      printf(" FAIL: no \"# steps=N\" to check against");
+      failures++;
+    }
+    printf("\n  %.1f ns/sample", n ? ns / n : 0.0);
+#ifdef HAVE_RDTSC
+    printf(", %.1f host cycles/sample", n ? (double)cycles / n : 0.0);
+#endif
+    printf("\n");
+  }
+  return failures ? 1 : 0;
+}
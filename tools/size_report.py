@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Flash and RAM used by each sketch, from the same eye engine.
+
+    python3 tools/size_report.py
+    python3 tools/size_report.py --fqbn esp32:esp32:esp32 --json sizes.json
+    python3 tools/size_report.py --host
+
+Every sketch in the repo is built on src/eye_engine.h with a different
+set of compile-time features, so the table shows what each feature costs.
+Each sketch is copied into a scratch sketch folder of its own (with src/
+alongside, as the Arduino builder expects) and compiled with arduino-cli;
+the sizes are read off its "Sketch uses" and "Global variables use" lines.
+
+--host needs no ESP32 toolchain. It builds the eye engine alone with each
+sketch's engine features, on host/'s mock Arduino layer. The build uses
+the firmware's -Os, -ffunction-sections and --gc-sections, and the sizes
+come from size(1): text for flash, data plus bss for RAM. The network
+flags (web, ota, ble) select sketch code, not engine code, so they show
+up only in the arduino-cli table. The absolute figures are for the host
+CPU; the differences between rows are what the engine features cost.
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# (sketch name, source file, features switched on)
+SKETCHES = [
+    ("eyes", "eyes", "breathing"),
+    ("diluted", "diluted.cpp", "stars ota"),
+    ("ota", "ota", "web ota"),
+    ("wearable_ota", "wearable_ota.ino", "readingLight gaze web ota"),
+    ("Hungry", "Hungry.cpp", "readingLight hunger stars artwork clips gaze trace web ota ble"),
+]
+
+ENGINE_FEATURES = ["readingLight", "hunger", "stars", "artwork", "clips", "gaze", "breathing", "trace"]
+
+# The engine and what it links against on the host (pet_core, eye_host and
+# host_mock in CMakeLists.txt)
+HOST_SOURCES = [
+    "src/event_trace.cpp", "src/eye_effects.cpp", "src/pet_behavior.cpp", "src/pet_needs.cpp",
+    "src/eye_bitmap.cpp", "src/eye_clip.cpp", "src/eye_dual.cpp", "src/eye_gaze.cpp",
+    "src/eye_render.cpp", "src/eye_scene.cpp", "host/mock_arduino.cpp", "host/mock_u8g2.cpp",
+]
+
+# The sketch's engine, begun and run for a few seconds of frames; Hungry's
+# artwork and clip hooks point at the real tables
+HOST_MAIN = """\
+#include "eye_artwork.h"
+#include "eye_clips.h"
+#include "eye_engine.h"
+
+struct Features : EyeFeatures {
+%(flags)s
+  static const EyeBitmap* artworkFor(EyeState state) { return artwork ? EYE_ARTWORK[state] : nullptr; }
+  static const EyeClip* clipOnEnter(EyeState state) { return clips && state == STATE_SLEEPY ? &EYE_CLIPS[0] : nullptr; }
+};
+
+EyeSsd1306I2c::Panel u8g2(U8G2_R0, U8X8_PIN_NONE);
+MillisClock petClock;
+EyeEngine<Features> eyes(u8g2, petClock);
+
+int main() {
+  u8g2.begin();
+  eyes.begin(1);
+  for (int i = 0; i < 100; i++) {
+    hostAdvanceMillis(40);
+    eyes.frame();
+  }
+  return 0;
+}
+"""
+
+FLASH_RE = re.compile(r"Sketch uses (\d+) bytes")
+RAM_RE = re.compile(r"Global variables use (\d+) bytes")
+
+
+def build(name, source, fqbn, scratch):
+    sketch_dir = os.path.join(scratch, name)
+    os.makedirs(sketch_dir)
+    shutil.copy(os.path.join(ROOT, source), os.path.join(sketch_dir, name + ".ino"))
+    shutil.copytree(os.path.join(ROOT, "src"), os.path.join(sketch_dir, "src"))
+
+    result = subprocess.run(["arduino-cli", "compile", "--fqbn", fqbn, sketch_dir],
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stdout)
+        sys.exit("size_report.py: %s failed to build" % source)
+
+    flash = FLASH_RE.search(result.stdout)
+    ram = RAM_RE.search(result.stdout)
+    if not flash or not ram:
+        sys.exit("size_report.py: no size summary in arduino-cli output for %s" % source)
+    return int(flash.group(1)), int(ram.group(1))
+
+
+def build_host(name, features, scratch):
+    flags = ["  static constexpr bool %s = true;" % f for f in features.split() if f in ENGINE_FEATURES]
+    main_cpp = os.path.join(scratch, name + ".cpp")
+    with open(main_cpp, "w") as f:
+        f.write(HOST_MAIN % {"flags": "\n".join(flags)})
+    binary = os.path.join(scratch, name)
+
+    result = subprocess.run(["g++", "-std=gnu++17", "-Os", "-ffunction-sections", "-fdata-sections",
+                             "-I" + os.path.join(ROOT, "src"), "-I" + os.path.join(ROOT, "host"), main_cpp]
+                            + [os.path.join(ROOT, s) for s in HOST_SOURCES]
+                            + ["-Wl,--gc-sections", "-pthread", "-o", binary],
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stdout)
+        sys.exit("size_report.py: host engine for %s failed to build" % name)
+
+    # text data bss dec hex filename
+    sizes = subprocess.check_output(["size", binary], universal_newlines=True).splitlines()[1].split()
+    return int(sizes[0]), int(sizes[1]) + int(sizes[2])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--fqbn", default="esp32:esp32:esp32", help="board to build for")
+    parser.add_argument("--host", action="store_true", help="size the engine alone, built for the host")
+    parser.add_argument("--json", help="also write the sizes to this file")
+    args = parser.parse_args()
+
+    if not args.host and shutil.which("arduino-cli") is None:
+        sys.exit("size_report.py needs arduino-cli with the ESP32 core installed (or --host)")
+
+    rows = []
+    with tempfile.TemporaryDirectory() as scratch:
+        for name, source, features in SKETCHES:
+            if args.host:
+                flash, ram = build_host(name, features, scratch)
+            else:
+                flash, ram = build(name, source, args.fqbn, scratch)
+            rows.append({"sketch": source, "features": features, "flash": flash, "ram": ram})
+
+    base = rows[0]
+    print("%-18s %-28s %9s %9s %8s %8s" % ("sketch", "features", "flash", "+flash", "ram", "+ram"))
+    for row in rows:
+        features = "all" if row is rows[-1] else row["features"]
+        print("%-18s %-28s %9d %9d %8d %8d" % (row["sketch"], features, row["flash"],
+                                               row["flash"] - base["flash"], row["ram"],
+                                               row["ram"] - base["ram"]))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"target": "host" if args.host else args.fqbn, "sketches": rows}, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,348 @@
+// Replays a behaviour trace from the pet (/trace) through the same
+// PetBehavior code on the host and checks that every decision and every
+// drawn frame comes out identical.
+//
+//   g++ -O2 -std=c++17 -Isrc tools/trace_replay.cpp src/pet_behavior.cpp src/event_trace.cpp src/eye_effects.cpp -o trace_replay
+//   curl -o pet.trace http://<pet address>/trace
+//   python3 tools/ble_trace.py pet.trace  # or over BLE, without WiFi
+//   ./trace_replay pet.trace              # replay, stop at the first divergence
+//   ./trace_replay --dump pet.trace       # list the records
+//   ./trace_replay --synth 600 out.trace  # record a scripted 10 minute session
+//
+// The replay starts at the first snapshot still in the ring, PRNG state
+// included. Commands and the needs mood are applied at their recorded times
+// on a ManualClock that runs from one recorded time to the next, so frames
+// land on exactly the device's timings. The replay's own records, random
+// draws included, are compared one by one against the device's.
+// Exits non-zero if the trace can't be read or the replay diverges.
+
+#include "pet_behavior.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static const char* const STATE_NAMES[STATE_COUNT] = {
+  "neutral", "angry", "surprised", "sad", "suspicious", "left",
+  "right", "up", "down", "sleepy", "happy"
+};
+static const char* const COMMAND_NAMES[] = {"emotion", "light", "manual", "feed"};
+static const char* const NEED_NAMES[] = {"hunger", "energy", "happiness", "cleanliness"};
+
+static const char* stateName(int state) {
+  return state >= 0 && state < STATE_COUNT ? STATE_NAMES[state] : "?";
+}
+
+static void describe(const TraceRecord& r, char* text, size_t size) {
+  int n = snprintf(text, size, "%7u.%03u %-8s ", r.time / 1000, r.time % 1000, EventTrace::typeName(r.type));
+  text += n;
+  size -= n;
+  switch (r.type) {
+    case TRACE_BOOT:
+      snprintf(text, size, "%s", r.arg ? "resumed" : "cold");
+      break;
+    case TRACE_COMMAND:
+      snprintf(text, size, "%s %d", r.arg < 4 ? COMMAND_NAMES[r.arg] : "?", (int)r.data);
+      break;
+    case TRACE_RANDOM:
+      snprintf(text, size, "%d of %u", (int)r.data, r.value);
+      break;
+    case TRACE_STATE:
+      snprintf(text, size, "%s -> %s%s", stateName(r.arg & ~TRACE_FROM_UPDATE), stateName(r.value),
+               r.arg & TRACE_FROM_UPDATE ? "" : " (command)");
+      break;
+    case TRACE_BLINK:
+      text[0] = '\0';
+      break;
+    case TRACE_MOOD:
+      snprintf(text, size, "%s", r.arg ? stateName(r.value) : "content");
+      break;
+    case TRACE_FEED_END:
+      snprintf(text, size, "manual %s", r.arg ? "on" : "off");
+      break;
+    case TRACE_NEED:
+      snprintf(text, size, "%s %u", r.arg < 4 ? NEED_NAMES[r.arg] : "?", r.value);
+      break;
+    case TRACE_FRAME:
+      snprintf(text, size, "%08x %u us", (unsigned)r.data, r.value);
+      break;
+    case TRACE_SNAPSHOT:
+      snprintf(text, size, "%s flags %04x recent %04x%s", stateName(r.arg & ~TRACE_FROM_UPDATE), r.value,
+               (unsigned)r.data, r.arg & TRACE_FROM_UPDATE ? "" : " (boot)");
+      break;
+    case TRACE_TIMER:
+      snprintf(text, size, "%u = %d", r.arg, (int)r.data);
+      break;
+    case TRACE_RNG:
+      snprintf(text, size, "%u = %08x", r.arg, (unsigned)r.data);
+      break;
+    default:
+      snprintf(text, size, "%u %u %d", r.arg, r.value, (int)r.data);
+      break;
+  }
+}
+
+static bool loadTrace(const char* path, std::vector<TraceRecord>& records, TraceHeader& header) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    fprintf(stderr, "can't open %s\n", path);
+    return false;
+  }
+  bool ok = fread(&header, sizeof(header), 1, file) == 1 && memcmp(header.magic, "PTR1", 4) == 0 &&
+            header.version == TRACE_VERSION && header.recordSize == sizeof(TraceRecord);
+  if (ok) {
+    records.resize(header.count);
+    ok = fread(records.data(), sizeof(TraceRecord), header.count, file) == header.count;
+  }
+  fclose(file);
+  if (!ok) {
+    fprintf(stderr, "%s is not a version %u trace\n", path, TRACE_VERSION);
+  }
+  return ok;
+}
+
+static bool writeTrace(const char* path, const EventTrace& trace) {
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    fprintf(stderr, "can't write %s\n", path);
+    return false;
+  }
+  TraceHeader header = trace.header();
+  fwrite(&header, sizeof(header), 1, file);
+  for (size_t i = 0; i < trace.count(); i++) {
+    fwrite(&trace.at(i), sizeof(TraceRecord), 1, file);
+  }
+  fclose(file);
+  return true;
+}
+
+static void dump(const std::vector<TraceRecord>& records, const TraceHeader& header) {
+  printf("%u records (%u written since boot)\n", header.count, header.total);
+  char text[128];
+  for (const TraceRecord& r : records) {
+    describe(r, text, sizeof(text));
+    printf("%s\n", text);
+  }
+}
+
+// --- replay ---
+
+// Records the replay reproduces; the rest only describe the device
+static bool comparable(const TraceRecord& r) {
+  return r.type != TRACE_BOOT && r.type != TRACE_NEED && r.type != TRACE_SNAPSHOT && r.type != TRACE_TIMER &&
+         r.type != TRACE_RNG;
+}
+
+// Written inside update(), so the first one at a new time means the device
+// stepped the pet there
+static bool fromUpdate(const TraceRecord& r) {
+  switch (r.type) {
+    case TRACE_MOOD:
+    case TRACE_RANDOM:
+    case TRACE_BLINK:
+    case TRACE_FEED_END:
+    case TRACE_FRAME:
+      return true;
+    case TRACE_STATE:
+      return r.arg & TRACE_FROM_UPDATE;
+    default:
+      return false;
+  }
+}
+
+static bool same(const TraceRecord& a, const TraceRecord& b) {
+  return a.time == b.time && a.type == b.type && a.arg == b.arg && a.value == b.value && a.data == b.data;
+}
+
+static int replay(const std::vector<TraceRecord>& records) {
+  size_t start = 0;
+  while (start < records.size() && records[start].type != TRACE_SNAPSHOT) {
+    start++;
+  }
+
+  EventTrace replayed;
+  ManualClock clock;
+  PetBehavior pet(clock);
+  size_t used = pet.loadSnapshot(records.data() + start, records.size() - start);
+  if (used == 0) {
+    fprintf(stderr, "no complete snapshot in the trace, nothing to replay from\n");
+    return 1;
+  }
+  pet.setTrace(&replayed);
+
+  std::vector<const TraceRecord*> expected;
+  for (size_t i = start + used; i < records.size(); i++) {
+    if (comparable(records[i])) {
+      expected.push_back(&records[i]);
+    }
+  }
+
+  bool needy;
+  EyeState needMood;
+  needy = pet.needInput(needMood);
+  // A snapshot from update() means the pet already stepped at that time
+  bool stepped = records[start].arg & TRACE_FROM_UPDATE;
+  uint32_t lastUpdate = records[start].time;
+  uint32_t pulled = 0;
+  size_t matched = 0;
+  uint32_t frames = 0, decisions = 0, commands = 0;
+  uint64_t renderUs = 0;
+  uint32_t worstRenderUs = 0, worstGapMs = 0, lastFrame = 0;
+
+  for (size_t i = start + used; i < records.size(); i++) {
+    const TraceRecord& r = records[i];
+    if (r.type == TRACE_COMMAND) {
+      commands++;
+      clock.set(r.time);
+      switch (r.arg) {
+        case TRACE_CMD_EMOTION: pet.setEmotion(r.data); break;
+        case TRACE_CMD_READING_LIGHT: pet.setReadingLight(r.data); break;
+        case TRACE_CMD_MANUAL: pet.setManualMode(r.data); break;
+        case TRACE_CMD_FEED: pet.feed(); break;
+      }
+    } else if (fromUpdate(r)) {
+      if (r.type == TRACE_MOOD) {
+        needy = r.arg;
+        needMood = (EyeState)r.value;
+      }
+      if (!stepped || r.time != lastUpdate) {
+        clock.set(r.time);
+        pet.update(needy, needMood);
+        lastUpdate = r.time;
+        stepped = true;
+      }
+      if (r.type == TRACE_FRAME) {
+        // Same timing as the device, own hash
+        replayed.record(r.time, TRACE_FRAME, 0, r.value, pet.frameHash());
+        frames++;
+        renderUs += r.value;
+        worstRenderUs = r.value > worstRenderUs ? r.value : worstRenderUs;
+        if (lastFrame != 0 && r.time - lastFrame > worstGapMs) {
+          worstGapMs = r.time - lastFrame;
+        }
+        lastFrame = r.time;
+      } else if (r.type == TRACE_STATE || r.type == TRACE_BLINK) {
+        decisions++;
+      }
+    }
+
+    // Compare whatever the replay wrote against the device, in order
+    for (; pulled < replayed.total(); pulled++) {
+      const TraceRecord& got = replayed.at(replayed.count() - (replayed.total() - pulled));
+      if (!comparable(got)) {
+        continue;
+      }
+      char want[128], have[128];
+      describe(got, have, sizeof(have));
+      if (matched == expected.size()) {
+        printf("DIVERGED: replay wrote past the end of the trace\n  replay: %s\n", have);
+        return 1;
+      }
+      if (!same(*expected[matched], got)) {
+        describe(*expected[matched], want, sizeof(want));
+        printf("DIVERGED after %zu matching records\n  device: %s\n  replay: %s\n", matched, want, have);
+        return 1;
+      }
+      matched++;
+    }
+  }
+  if (matched != expected.size()) {
+    char want[128];
+    describe(*expected[matched], want, sizeof(want));
+    printf("DIVERGED: replay stopped short of the trace\n  device: %s\n", want);
+    return 1;
+  }
+
+  uint32_t span = records.back().time - records[start].time;
+  printf("replayed %zu records from %u.%03u s over %u.%03u s: identical\n", matched,
+         records[start].time / 1000, records[start].time % 1000, span / 1000, span % 1000);
+  printf("  %u commands, %u state changes and blinks, %u frames drawn\n", commands, decisions, frames);
+  if (frames > 0) {
+    printf("  render+flush %.0f us average, %u us worst; longest gap between drawn frames %u ms\n",
+           (double)renderUs / frames, worstRenderUs, worstGapMs);
+  }
+  return 0;
+}
+
+// --- synthetic session, for checking the tool itself ---
+
+static int synth(uint32_t seconds, const char* path) {
+  // The script's own choices, separate from the pet's
+  PetRandom script(12345);
+  EventTrace trace;
+  ManualClock clock;
+  PetBehavior pet(clock);
+  pet.setTrace(&trace);
+
+  uint32_t now = 1500;
+  clock.set(now);
+  trace.record(now, TRACE_BOOT, 0);
+  pet.begin(67890);
+
+  int shownFrameKey = -1;
+  bool needy = false;
+  EyeState needMood = STATE_NEUTRAL;
+  uint32_t nextCommand = now + 5000, nextNeed = now + 60000;
+  for (uint32_t end = now + seconds * 1000; now < end;) {
+    // A request roughly every 20 s, handled before the frame like on the device
+    if (now >= nextCommand) {
+      uint32_t at = now - script.range(0, 5);
+      clock.set(at);
+      switch (script.range(0, 6)) {
+        case 0: pet.setEmotion(script.range(0, STATE_COUNT)); break;
+        case 1: pet.setReadingLight(!pet.readingLight()); break;
+        case 2:
+        case 3: pet.setManualMode(!pet.manualMode()); break;
+        default:
+          pet.feed();
+          trace.record(at, TRACE_NEED, 0, 100);
+          break;
+      }
+      nextCommand = now + script.range(2000, 40000);
+    }
+    // Needs come and go every minute or so
+    if (now >= nextNeed) {
+      needy = !needy;
+      needMood = (EyeState)(script.range(0, 2) ? STATE_SAD : STATE_SLEEPY);
+      nextNeed = now + script.range(10000, 120000);
+    }
+
+    clock.set(now);
+    pet.update(needy, needMood);
+    int frameKey = pet.frameKey();
+    if (frameKey < 0 || frameKey != shownFrameKey) {
+      trace.record(now, TRACE_FRAME, 0, script.range(9000, 26000), pet.frameHash());
+      shownFrameKey = frameKey;
+    }
+    now += 40 + script.range(0, 3); // paced frames with a little jitter
+  }
+
+  if (!writeTrace(path, trace)) {
+    return 1;
+  }
+  printf("wrote %zu records (%u total) to %s\n", trace.count(), trace.total(), path);
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  if (argc == 4 && strcmp(argv[1], "--synth") == 0) {
+    return synth(atoi(argv[2]), argv[3]);
+  }
+  bool dumpOnly = argc == 3 && strcmp(argv[1], "--dump") == 0;
+  if (argc != 2 && !dumpOnly) {
+    fprintf(stderr, "usage: %s [--dump] trace | --synth seconds out.trace\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<TraceRecord> records;
+  TraceHeader header;
+  if (!loadTrace(argv[argc - 1], records, header)) {
+    return 1;
+  }
+  if (dumpOnly) {
+    dump(records, header);
+    return 0;
+  }
+  return replay(records);
+}
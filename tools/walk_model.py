@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""Write an accelerometer walk trace from a gait model, for pedometer_replay.
+
+    python3 tools/walk_model.py -o tests/walks/model_walk.csv
+    ./build/pedometer_replay --max-error 5 tests/walks/*.csv
+
+Recordings from the pet itself are the real test (the LIS3DH FIFO logged
+as "t_ms,x,y,z", with "# steps=N" counted by hand), and go in tests/walks/
+next to this one. This trace is generated, and says so in its header. It
+is made to be harder than pedometer_replay --synth, whose sine steps are
+what the detector was tuned on:
+
+  - heel strikes as short spikes with a ringing tail, and a weaker push-off
+  - cadence changing between walks and jittering from step to step
+  - gravity off the z axis, the device swinging as a pendant does
+  - lateral sway at half the step rate
+  - standing still, fidgeting and one pick-up between the walks, none of
+    which are steps
+  - 50 Hz samples, quantized to the LIS3DH's 4 mg in normal mode
+
+The same seed writes the same file.
+"""
+
+import argparse
+import math
+import random
+
+SAMPLE_HZ = 50
+DT_MS = 1000 // SAMPLE_HZ
+LSB_MG = 4
+
+# (kind, seconds or steps, steps per second)
+SCRIPT = [
+    ("stand", 5, 0),
+    ("walk", 120, 1.8),
+    ("fidget", 8, 0),
+    ("walk", 80, 2.2),
+    ("stand", 3, 0),
+    ("pickup", 2, 0),
+    ("stand", 3, 0),
+    ("walk", 60, 1.5),
+    ("stand", 5, 0),
+]
+
+
+class Walker:
+    def __init__(self, seed):
+        self.rng = random.Random(seed)
+        self.t = 0
+        self.rows = []
+        self.steps = 0
+
+    def emit(self, vertical, lateral, forward):
+        # The pendant hangs tilted and swings slowly about it
+        t = self.t / 1000.0
+        tilt = math.radians(25 + 6 * math.sin(2 * math.pi * 0.3 * t))
+        roll = math.radians(10 * math.sin(2 * math.pi * 0.17 * t + 1))
+        g = 1000 + vertical
+        x = forward + g * math.sin(tilt)
+        y = lateral + g * math.sin(roll)
+        z = g * math.cos(tilt) * math.cos(roll)
+        noise = lambda: self.rng.gauss(0, 15)
+        q = lambda v: int(round((v + noise()) / LSB_MG)) * LSB_MG
+        self.rows.append((self.t, q(x), q(y), q(z)))
+        self.t += DT_MS
+
+    def stand(self, seconds):
+        for _ in range(seconds * SAMPLE_HZ):
+            self.emit(0, 0, 0)
+
+    def fidget(self, seconds):
+        # Small irregular knocks: shifting weight, touching the device
+        knocks = sorted(self.rng.uniform(0.5, seconds - 0.5) for _ in range(5))
+        for i in range(seconds * SAMPLE_HZ):
+            t = i / SAMPLE_HZ
+            v = sum(90 * math.exp(-((t - k) / 0.05) ** 2) for k in knocks)
+            self.emit(v, 0.5 * v, 0)
+
+    def pickup(self, seconds):
+        # One smooth lift and set-down: a single broad bump, no rhythm
+        n = seconds * SAMPLE_HZ
+        for i in range(n):
+            v = 400 * math.sin(math.pi * i / n) * math.sin(2 * math.pi * i / n)
+            self.emit(v, 0, 150 * math.sin(math.pi * i / n))
+
+    def walk(self, steps, cadence):
+        cadence *= self.rng.uniform(0.95, 1.05)
+        for s in range(steps):
+            period = 1.0 / (cadence * self.rng.uniform(0.92, 1.08))
+            n = int(round(period * SAMPLE_HZ))
+            side = 1 if s % 2 else -1
+            for i in range(n):
+                t = i / SAMPLE_HZ
+                # Heel strike: a sharp spike ringing down at ~9 Hz
+                strike = 550 * math.exp(-t / 0.045) * math.cos(2 * math.pi * 9 * t)
+                # Push-off, weaker, two thirds of the way through
+                push = 180 * math.exp(-((t - 0.65 * period) / 0.06) ** 2)
+                # The body dipping and rising over the step
+                body = -120 * math.cos(2 * math.pi * t / period)
+                lateral = side * 90 * math.sin(math.pi * t / period)
+                forward = 100 * math.sin(2 * math.pi * t / period + 0.8)
+                self.emit(strike + push + body, lateral, forward)
+            self.steps += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", required=True, help="CSV file to write")
+    parser.add_argument("--seed", type=int, default=31, help="random seed")
+    args = parser.parse_args()
+
+    walker = Walker(args.seed)
+    for kind, amount, cadence in SCRIPT:
+        if kind == "walk":
+            walker.walk(amount, cadence)
+        else:
+            getattr(walker, kind)(amount)
+
+    with open(args.output, "w") as f:
+        f.write("# generated by tools/walk_model.py --seed %d, not recorded\n" % args.seed)
+        f.write("# steps=%d\n" % walker.steps)
+        f.write("t_ms,x,y,z\n")
+        for row in walker.rows:
+            f.write("%d,%d,%d,%d\n" % row)
+    print("%d steps, %d samples (%.1f s) to %s" % (walker.steps, len(walker.rows),
+                                                  len(walker.rows) / SAMPLE_HZ, args.output))
+
+
+if __name__ == "__main__":
+    main()